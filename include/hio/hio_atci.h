@@ -52,6 +52,12 @@ enum hio_atci_backend_evt {
 	HIO_ATCI_BACKEND_EVT_DISABLED /**< Backend was disabled; the session ended. */
 };
 
+/** @brief Modem trace output format. */
+enum hio_atci_modem_trace_mode {
+	HIO_ATCI_MODEM_TRACE_MODE_TEXT = 0, /**< Base64 in @MT: lines. */
+	HIO_ATCI_MODEM_TRACE_MODE_BINARY,   /**< Length and CRC framed binary. */
+};
+
 /** @brief Event handler function prototype for backend events. */
 typedef void (*hio_atci_backend_handler_t)(enum hio_atci_backend_evt evt, void *ctx);
 
@@ -162,6 +168,7 @@ struct hio_atci_ctx {
 	uint32_t crc;
 	uint8_t crc_mode; /**< CRC mode: 0 - disabled, 1 - enabled. 2 - optional */
 	bool modem_trace; /**< Flag for modem trace output. */
+	uint8_t modem_trace_mode; /**< Modem trace output format (hio_atci_modem_trace_mode). */
 	bool cmd_processing; /**< Command processing in progress (URCs are deferred). */
 	char urc_buff[CONFIG_HIO_ATCI_URC_BUFF_SIZE]; /**< Deferred URC messages (NUL separated). */
 	uint16_t urc_buff_len; /**< Used bytes in urc_buff. */
@@ -3,6 +3,7 @@
 
 /* Zephyr includes */
 #include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
 
 /* Standard includes */
 #include <stdbool.h>
@@ -110,6 +111,9 @@ struct hio_lte_send_recv_param {
 			       * more times. Bounds the resend loop independently of
 			       * @ref timeout, which only limits how long one attempt waits.
 			       */
+	int socket;           /**< Socket handle: @ref HIO_LTE_SOCKET_DEFAULT (0) for the socket
+			       * of @ref hio_lte_enable, else from @ref hio_lte_add_socket.
+			       */
 };
 
 /**
@@ -123,6 +127,62 @@ struct hio_lte_rai_param {
 	int plmn;    /**< PLMN code (MCCMNC). */
 };
 
+/** Number of buckets of a @ref hio_lte_hist. */
+#define HIO_LTE_HIST_BUCKETS 12
+
+/**
+ * @brief Fixed-bucket histogram of durations.
+ *
+ * Bucket i counts the durations below @ref hio_lte_hist_edge_ms (i) and at or
+ * above the edge of bucket i - 1. The edges run from 100 ms to 120 s; the last
+ * bucket is unbounded.
+ */
+struct hio_lte_hist {
+	uint32_t buckets[HIO_LTE_HIST_BUCKETS]; /**< Counts per bucket. */
+	uint32_t count;                         /**< Total of the counts. */
+	uint32_t max_ms;                        /**< Longest duration seen (ms). */
+};
+
+/**
+ * @brief Upper edge of a histogram bucket.
+ *
+ * @param bucket Bucket index.
+ * @return Edge in milliseconds, UINT32_MAX for the last bucket and past it.
+ */
+uint32_t hio_lte_hist_edge_ms(int bucket);
+
+/**
+ * @brief Duration below which @p percent of the histogram falls.
+ *
+ * Resolution is the bucket: the upper edge of the bucket holding the
+ * percentile is returned, capped at the longest duration seen.
+ *
+ * @param hist    Histogram.
+ * @param percent Percentile, 1 to 100.
+ * @return Duration in milliseconds, 0 if the histogram is empty.
+ */
+uint32_t hio_lte_hist_percentile_ms(const struct hio_lte_hist *hist, int percent);
+
+/**
+ * @brief One @ref hio_lte_send_recv transaction (or batch) as recorded in the
+ * metrics.
+ */
+struct hio_lte_metrics_txn {
+	uint32_t timestamp;    /**< Uptime at the start of the transaction (ms). */
+	int32_t result;        /**< Value returned to the caller. */
+	uint32_t on_air_ms;    /**< Sends waiting to be on-air (NRF_MSG_WAITACK), summed. */
+	uint32_t recv_ms;      /**< Wait for the reply, 0 without one. */
+	uint32_t connected_ms; /**< RRC connected period the transaction was part of,
+				*   0 while the connection lasts. */
+	uint32_t eci;          /**< Serving cell (E-UTRA Cell Identifier). */
+	int16_t rsrp;          /**< RSRP of the connection evaluation after the transaction
+				*   (dBm), INT16_MIN if none was made. */
+	uint16_t send_len;     /**< Bytes sent. */
+	uint16_t recv_len;     /**< Bytes received. */
+	uint8_t datagrams;     /**< Datagrams sent. */
+	uint8_t attempts;      /**< Send attempts, retries included. */
+};
+
 /**
  * @brief Communication metrics and timing information.
  *
@@ -136,10 +196,18 @@ struct hio_lte_metrics {
 	int64_t attach_last_ts;           /**< Uptime of last attach (ms). */
 	uint32_t attach_last_duration_ms; /**< Duration of last attach (ms). */
 
+	uint32_t attach_hint_count;          /**< Attaches narrowed to the last-good cell. */
+	uint32_t attach_hint_duration_ms;    /**< Total duration of those attaches (ms). */
+	uint32_t attach_hint_fallback_count; /**< Narrowed attaches that timed out. */
+	uint32_t attach_full_count;          /**< Attaches with the full configuration. */
+	uint32_t attach_full_duration_ms;    /**< Total duration of those, including a
+					      *   preceding narrowed attempt (ms). */
+
 	uint32_t uplink_count;  /**< Number of uplink transmissions. */
 	uint32_t uplink_bytes;  /**< Total uplink bytes. */
 	uint32_t uplink_errors; /**< Uplink error count. */
 	int64_t uplink_last_ts; /**< Uptime of last uplink (ms). */
+	uint32_t uplink_batched; /**< Uplinks sent back-to-back after another of a batch. */
 
 	uint32_t downlink_count;  /**< Number of downlink receptions. */
 	uint32_t downlink_bytes;  /**< Total downlink bytes. */
@@ -148,8 +216,49 @@ struct hio_lte_metrics {
 
 	uint32_t cscon_1_duration_ms;      /**< Total time in RRC Connected (CSCON=1). */
 	uint32_t cscon_1_last_duration_ms; /**< Duration of last RRC Connected period. */
+
+	uint32_t event_count;     /**< FSM events queued. */
+	uint32_t event_dropped;   /**< FSM events lost to a full event queue. */
+	uint32_t event_coalesced; /**< Redundant FSM events merged in the queue. */
+	uint32_t event_max_depth; /**< Highest number of waiting FSM events. */
+
+	uint32_t defer_evaluations;   /**< CONEVAL runs requested by deferred sends. */
+	uint32_t defer_sent_good;     /**< Deferred sends released by good conditions. */
+	uint32_t defer_sent_deadline; /**< Deferred sends released by their deadline. */
+
+	struct hio_lte_hist attach_hist;    /**< Successful attach durations. */
+	struct hio_lte_hist on_air_hist;    /**< Send to on-air (NRF_MSG_WAITACK) per datagram. */
+	struct hio_lte_hist recv_hist;      /**< Wait for a reply that arrived. */
+	struct hio_lte_hist connected_hist; /**< RRC connected periods (CSCON 1 to 0). */
+
+	uint32_t txn_count; /**< Transactions recorded, see @ref hio_lte_get_metrics_txn. */
+
+	uint32_t recv_timeout_ltem_ms;  /**< Receive timeout learned on LTE-M, 0 until learned. */
+	uint32_t recv_timeout_nbiot_ms; /**< Receive timeout learned on NB-IoT, 0 until learned. */
+
+	uint32_t gnss_requests;  /**< Calls of @ref hio_lte_gnss_get_fix. */
+	uint32_t gnss_fixes;     /**< Requests that got a fix. */
+	uint32_t gnss_timeouts;  /**< Requests that got no fix within their timeout. */
+	uint32_t gnss_errors;    /**< Requests that failed otherwise (receiver, LTE disabled). */
+	uint32_t gnss_preempted; /**< Searches stopped for an uplink. */
+	uint32_t gnss_blocked;   /**< Times the modem blocked the search for LTE activity. */
+	struct hio_lte_hist gnss_ttff_hot_hist;  /**< Time to fix, hot starts. */
+	struct hio_lte_hist gnss_ttff_cold_hist; /**< Time to fix, other starts. */
+
+	uint32_t dtls_full_handshakes;    /**< DTLS connections set up with a full handshake. */
+	uint32_t dtls_resumed_handshakes; /**< Abbreviated handshakes on the cached session. */
+	uint32_t dtls_restored;           /**< Saved connections loaded, no handshake sent. */
+	uint32_t dtls_handshake_bytes;    /**< Estimated handshake bytes over the air, see
+					   *   CONFIG_HIO_LTE_DTLS_FULL_HANDSHAKE_BYTES. */
+	uint32_t dtls_saves;              /**< DTLS connections saved for a later load. */
+	uint32_t dtls_save_failures;      /**< Saves the modem refused. */
+	uint32_t dtls_load_failures;      /**< Saved connections the modem could not load. */
+	struct hio_lte_hist dtls_handshake_hist; /**< Full and abbreviated handshake durations. */
 };
 
+/** Handle of the socket configured by @ref hio_lte_enable. */
+#define HIO_LTE_SOCKET_DEFAULT 0
+
 struct hio_lte_socket_config {
 	bool dtls_enabled; /**< True to enable DTLS. */
 	uint16_t port;     /**< Remote UDP port. */
@@ -219,6 +328,35 @@ int hio_lte_wait_for_disable(k_timeout_t timeout);
  */
 int hio_lte_update_socket_config(const struct hio_lte_socket_config *socket_config);
 
+/**
+ * @brief Add a socket next to the one of @ref hio_lte_enable.
+ *
+ * The socket (plain UDP or DTLS) shares the attach and the RRC connection of
+ * the default one; select it by @ref hio_lte_send_recv_param::socket. It is
+ * opened with the default socket, or before its first send when added later.
+ * A batch (@ref hio_lte_send_recv_batch) may mix the sockets, so several data
+ * paths are served by one connection setup. The DTLS session of an added
+ * socket is not kept over sleeps without PSM.
+ *
+ * @param socket_config  Socket configuration.
+ * @param socket         Output: handle of the socket.
+ * @retval 0       Success.
+ * @retval -EINVAL Invalid parameter.
+ * @retval -ENOSPC All CONFIG_HIO_LTE_SOCKETS_MAX sockets are in use.
+ */
+int hio_lte_add_socket(const struct hio_lte_socket_config *socket_config, int *socket);
+
+/**
+ * @brief Close a socket added by @ref hio_lte_add_socket.
+ *
+ * Waits for a transaction in progress to end.
+ *
+ * @param socket  Handle of the socket.
+ * @retval 0       Success.
+ * @retval -EINVAL Invalid or default handle.
+ */
+int hio_lte_remove_socket(int socket);
+
 /**
  * @brief Wait for connection to be established.
  *
@@ -238,6 +376,45 @@ int hio_lte_wait_for_connected(k_timeout_t timeout);
  */
 int hio_lte_send_recv(const struct hio_lte_send_recv_param *param);
 
+/**
+ * @brief Send several datagrams back-to-back as one transaction.
+ *
+ * The datagrams are handed to the FSM together and sent one after another
+ * within the same RRC connection. Release Assistance is held back (ongoing)
+ * for all but the last datagram, whose @ref hio_lte_send_recv_param::rai
+ * applies as usual, so the network releases the connection only after it.
+ * Only the last datagram may wait for a reply. A failed datagram ends the
+ * transaction; the ones after it are not sent.
+ *
+ * @param params   Array of operation parameters (see @ref hio_lte_send_recv_param).
+ * @param count    Number of datagrams, at most CONFIG_HIO_LTE_SEND_BATCH_MAX.
+ * @param done     Output: number of datagrams completed (can be NULL).
+ * @param timeout  Timeout for the whole transaction.
+ * @retval 0       Success.
+ * @retval -EINVAL Invalid parameter.
+ * @retval <0      Negative error code of the failed datagram.
+ */
+int hio_lte_send_recv_batch(const struct hio_lte_send_recv_param *params, size_t count,
+			    size_t *done, k_timeout_t timeout);
+
+/**
+ * @brief Send data when the radio conditions are good, at the latest at a deadline.
+ *
+ * For non-urgent uplinks. The send is held back until a connection evaluation
+ * (%CONEVAL) reports an energy estimate of at least
+ * CONFIG_HIO_LTE_DEFER_MIN_EEST, or until @p deadline expires, and then runs
+ * as @ref hio_lte_send_recv. Evaluations are cached and run at most once per
+ * CONFIG_HIO_LTE_DEFER_EVAL_INTERVAL seconds. Without a connection the send
+ * runs right away, since there is nothing to evaluate.
+ *
+ * @param param     Operation parameters (see @ref hio_lte_send_recv_param).
+ * @param deadline  Longest time the send may be held back.
+ * @retval 0        Success (see @p *recv_len for bytes received).
+ * @retval -EINVAL  Invalid parameter.
+ * @retval <0       Negative error code of @ref hio_lte_send_recv.
+ */
+int hio_lte_send_recv_deferred(const struct hio_lte_send_recv_param *param, k_timeout_t deadline);
+
 /* -------- Information getters -------- */
 
 /**
@@ -316,6 +493,19 @@ int hio_lte_get_cereg_param(struct hio_lte_cereg_param *param);
  */
 int hio_lte_get_metrics(struct hio_lte_metrics *metrics);
 
+/**
+ * @brief Get one of the last transactions kept in the metrics.
+ *
+ * The last CONFIG_HIO_LTE_METRICS_TXN_SIZE transactions are kept.
+ *
+ * @param index Record index, oldest first.
+ * @param txn   Output structure.
+ * @retval 0       Success.
+ * @retval -ENOENT No record at @p index.
+ * @retval -EINVAL Invalid argument.
+ */
+int hio_lte_get_metrics_txn(int index, struct hio_lte_metrics_txn *txn);
+
 /**
  * @brief Get current FSM state as text.
  *
@@ -419,6 +609,40 @@ int hio_lte_add_callback(struct hio_lte_cb *cb);
  */
 int hio_lte_remove_callback(struct hio_lte_cb *cb);
 
+/* -------- URC handlers -------- */
+
+/**
+ * @brief Unsolicited result code (URC) handler.
+ *
+ * @ref prefix is the URC name without the colon (e.g. "+CEREG", "%XSIM"); URCs
+ * without parameters (e.g. "Ready") match on the whole line. The handler gets
+ * the parameters following ": " (empty string if there are none). Several
+ * handlers may share a prefix; all of them are called.
+ *
+ * @note Handlers run on the AT monitor path; they must be non-blocking and
+ *       must not issue AT commands.
+ */
+struct hio_lte_urc_handler {
+	const char *prefix; /**< URC name, e.g. "+CEREG". */
+	void (*handler)(const char *params, void *user_data);
+	void *user_data; /**< User data passed to the handler. */
+};
+
+/**
+ * @brief Register a URC handler at build time.
+ *
+ * @param _name Unique handler identifier.
+ * @param _prefix URC name, e.g. "+CSCON".
+ * @param _handler Handler function.
+ * @param _user_data User data passed to the handler.
+ */
+#define HIO_LTE_URC_HANDLER_REGISTER(_name, _prefix, _handler, _user_data)                         \
+	static const STRUCT_SECTION_ITERABLE(hio_lte_urc_handler, _name) = {                       \
+		.prefix = _prefix,                                                                 \
+		.handler = _handler,                                                               \
+		.user_data = _user_data,                                                           \
+	}
+
 /* -------- Neighbor Cell Measurements -------- */
 #define HIO_LTE_CELL_ECI_MAX            268435455
 #define HIO_LTE_CELL_ECI_INVALID        UINT32_MAX
@@ -439,6 +663,7 @@ struct hio_lte_ncellmeas_ncell_param {
 };
 
 struct hio_lte_ncellmeas_cell_param {
+	bool valid;      /**< True if all values of the cell are in range. */
 	uint32_t eci;    /**< E-UTRA Cell Identifier. */
 	uint16_t mcc;    /**< Mobile Country Code. */
 	uint16_t mnc;    /**< Mobile Network Code. */
@@ -477,6 +702,76 @@ int hio_lte_get_ncellmeas_param(struct hio_lte_ncellmeas_param *param);
  */
 int hio_lte_schedule_ncellmeas(void);
 
+/**
+ * @brief Power saving timers and the sleep ratio they lead to.
+ *
+ * Timers are in seconds; a granted value is -1 if the network disabled the
+ * timer and -2 before the network reported it.
+ */
+struct hio_lte_psm_info {
+	uint32_t interval_s;          /**< Learned interval between transactions (0 until learned). */
+	int tau_requested_s;          /**< Periodic TAU requested with AT+CPSMS. */
+	int active_requested_s;       /**< Active time requested with AT+CPSMS. */
+	int tau_granted_s;            /**< Periodic TAU granted by the network (+CEREG). */
+	int active_granted_s;         /**< Active time granted by the network (+CEREG). */
+	int sleep_predicted_permille; /**< Expected share of time asleep, -1 if unknown. */
+	int sleep_observed_permille;  /**< Share of time spent in sleep state, -1 if unknown. */
+};
+
+/**
+ * @brief Get the PSM timers and the predicted and observed sleep ratio.
+ *
+ * With CONFIG_HIO_LTE_PSM_AUTO the timers requested follow the traffic pattern
+ * learned from @ref hio_lte_send_recv calls.
+ *
+ * @retval 0       Success.
+ * @retval -EINVAL Invalid argument.
+ */
+int hio_lte_get_psm_info(struct hio_lte_psm_info *info);
+
+/* -------- GNSS -------- */
+
+/**
+ * @brief GNSS fix (returned by @ref hio_lte_gnss_get_fix).
+ */
+struct hio_lte_gnss_fix {
+	double latitude;    /**< Latitude (degrees). */
+	double longitude;   /**< Longitude (degrees). */
+	float altitude;     /**< Altitude above the WGS-84 ellipsoid (m). */
+	float accuracy;     /**< Horizontal accuracy, 68 % confidence (m). */
+	float speed;        /**< Horizontal speed (m/s). */
+	float heading;      /**< Heading of the movement (degrees). */
+	uint8_t satellites; /**< Satellites used in the fix. */
+	int64_t timestamp;  /**< UTC time of the fix (Unix seconds). */
+	uint32_t ttff_ms;   /**< Time the receiver searched for the fix (ms). */
+	bool hot;           /**< Started with the ephemerides of the previous fix. */
+};
+
+/**
+ * @brief Get a GNSS fix without disturbing the LTE traffic.
+ *
+ * Requires CONFIG_HIO_LTE_GNSS. The FSM searches only while the radio is idle
+ * (RRC idle or PSM), never during a send or a receive. An uplink requested in
+ * the meantime stops the search, which resumes in the next idle window.
+ * Searching time is summed over the windows into
+ * @ref hio_lte_gnss_fix::ttff_ms. A single search is capped by
+ * CONFIG_HIO_LTE_GNSS_FIX_TIMEOUT; one without a fix is started again while
+ * @p timeout allows. The modem keeps the ephemerides between the
+ * requests, so a fix within CONFIG_HIO_LTE_GNSS_HOT_AGE seconds of the previous
+ * one starts hot.
+ *
+ * @param fix      Output: the fix.
+ * @param timeout  Longest wait for the fix, including the wait for idle windows.
+ * @retval 0          Success.
+ * @retval -EINVAL    Invalid argument.
+ * @retval -ENOTSUP   GNSS is not enabled or test mode is enabled.
+ * @retval -ENODEV    LTE is disabled.
+ * @retval -EBUSY     Another request is in progress.
+ * @retval -EIO       The receiver failed to start.
+ * @retval -ETIMEDOUT No fix within @p timeout.
+ */
+int hio_lte_gnss_get_fix(struct hio_lte_gnss_fix *fix, k_timeout_t timeout);
+
 /* -------- Utility functions -------- */
 
 /** Convert connection evaluation result code to string. */
@@ -7,6 +7,8 @@ import time
 import os
 import base64
 import queue
+import struct
+import zlib
 from loguru import logger
 from rttt.console import Console
 from rttt.connectors import FileLogConnector
@@ -29,6 +31,13 @@ DEFAULT_HISTORY_FILE = os.path.expanduser(f"~/.serial_console_history")
 DEFAULT_CONSOLE_FILE = os.path.expanduser(f"~/.serial_console_console")
 DEFAULT_MODEM_TRACE_FILE = os.path.expanduser(f"~/.serial_console.mtrace")
 
+# Binary modem trace frame (AT$MTMODE=1), sent at a line boundary:
+# 00 'M' 'T' | length (u16 LE) | payload | CRC32 of length and payload (u32 LE)
+MT_FRAME_SYNC = b'\x00MT'
+MT_FRAME_HEADER_SIZE = len(MT_FRAME_SYNC) + 2
+MT_FRAME_CRC_SIZE = 4
+MT_STATS_INTERVAL = 10
+
 
 class BaseConsoleConnector(Connector):
     """Base class for console connectors with shared logic."""
@@ -40,6 +49,10 @@ class BaseConsoleConnector(Connector):
         self.is_running = False
         self.lines = queue.Queue()
         self.modem_trace_fd = None
+        self.modem_trace_bytes = 0
+        self.modem_trace_errors = 0
+        self._modem_trace_start = None
+        self._modem_trace_report = 0
 
     def set_modem_trace_file(self, modem_trace_file: str):
         """
@@ -49,6 +62,27 @@ class BaseConsoleConnector(Connector):
         logger.info(f"Modem trace file set to: {modem_trace_file}")
         self.modem_trace_fd = open(modem_trace_file, 'wb')
 
+    def _modem_trace_write(self, data: bytes):
+        """Store trace data and report the achieved throughput periodically."""
+        if self.modem_trace_fd:
+            self.modem_trace_fd.write(data)
+
+        now = time.monotonic()
+        if self._modem_trace_start is None:
+            self._modem_trace_start = now
+            self._modem_trace_report = now
+        self.modem_trace_bytes += len(data)
+
+        if now - self._modem_trace_report >= MT_STATS_INTERVAL:
+            self._modem_trace_report = now
+            self._emit(Event(EventType.LOG, self.modem_trace_stats()))
+
+    def modem_trace_stats(self) -> str:
+        elapsed = time.monotonic() - self._modem_trace_start if self._modem_trace_start else 0
+        rate = self.modem_trace_bytes / elapsed if elapsed > 0 else 0
+        return (f'Modem trace: {self.modem_trace_bytes} B, {rate:.0f} B/s, '
+                f'{self.modem_trace_errors} bad frames')
+
     def _start_threads(self):
         """Start the read and line processing threads."""
         self.is_running = True
@@ -67,6 +101,8 @@ class BaseConsoleConnector(Connector):
         if self._thread_line:
             self._thread_line.join()
         self._close_resources()
+        if self.modem_trace_bytes:
+            logger.info(self.modem_trace_stats())
         if self.modem_trace_fd:
             self.modem_trace_fd.close()
         self._emit(Event(EventType.CLOSE, ''))
@@ -87,12 +123,10 @@ class BaseConsoleConnector(Connector):
 
                 if line.startswith("@MT: "):
                     # Format: @MT: <remaining_bytes>,"<base64_data>"
-                    if self.modem_trace_fd:
-                        index = line.find(',')
-                        b64text = line[index + 2:-1]  # skip ',"' prefix and '"' suffix
-                        if b64text:
-                            data = base64.b64decode(b64text)
-                            self.modem_trace_fd.write(data)
+                    index = line.find(',')
+                    b64text = line[index + 2:-1]  # skip ',"' prefix and '"' suffix
+                    if b64text:
+                        self._modem_trace_write(base64.b64decode(b64text))
                 elif line.startswith("@LOG: "):
                     # Format: @LOG: "<message>"
                     self._emit(Event(EventType.LOG, line[7:-1].encode('utf-8').decode('unicode_escape')))
@@ -106,13 +140,15 @@ class BaseConsoleConnector(Connector):
 
 class SerialConnector(BaseConsoleConnector):
 
-    def __init__(self, port: str, baudrate: int = 115200, timeout: float = 0.2) -> None:
+    def __init__(self, port: str, baudrate: int = 115200, timeout: float = 0.2,
+                 modem_trace_binary: bool = False) -> None:
         super().__init__()
         self.port = port
         self.baudrate = baudrate
         self.timeout = timeout
+        self.modem_trace_binary = modem_trace_binary
         self.ser = None
-        self._cache = ''
+        self._cache = b''
 
     def open(self):
         logger.info(f"Opening serial port {self.port} at {self.baudrate} baud")
@@ -120,6 +156,8 @@ class SerialConnector(BaseConsoleConnector):
         self._start_threads()
         self._emit(Event(EventType.OPEN, ''))
         logger.info("Serial connection opened")
+        if self.modem_trace_binary:
+            self.handle(Event(EventType.IN, 'AT$MTMODE=1'))
 
     def _close_resources(self):
         if self.ser and self.ser.is_open:
@@ -132,6 +170,26 @@ class SerialConnector(BaseConsoleConnector):
             self.ser.write(data)
         self._emit(event)
 
+    def _read_frame(self, data: bytes) -> int:
+        """Consume a binary trace frame at the start of data, return the bytes used (0 if incomplete)."""
+        if len(data) < MT_FRAME_HEADER_SIZE:
+            return 0
+        (length,) = struct.unpack_from('<H', data, len(MT_FRAME_SYNC))
+        size = MT_FRAME_HEADER_SIZE + length + MT_FRAME_CRC_SIZE
+        if len(data) < size:
+            return 0
+
+        body = data[len(MT_FRAME_SYNC):MT_FRAME_HEADER_SIZE + length]
+        (crc,) = struct.unpack_from('<I', data, MT_FRAME_HEADER_SIZE + length)
+        if zlib.crc32(body) != crc:
+            # Resynchronize on the next sync or line
+            self.modem_trace_errors += 1
+            logger.warning("Modem trace frame CRC mismatch")
+            return 1
+
+        self._modem_trace_write(body[2:])
+        return size
+
     def _read_task(self):
         self.ser.reset_input_buffer()
         self.ser.reset_output_buffer()
@@ -140,16 +198,32 @@ class SerialConnector(BaseConsoleConnector):
                 if self.ser.in_waiting:
                     data = self.ser.read(self.ser.in_waiting)
                     if data:
-                        text = data.decode('utf-8', errors='backslashreplace')
-                        text = self._cache + text
+                        data = self._cache + data
                         while True:
-                            newline_index = text.find('\n')
+                            if data[:1] == b'\x00':
+                                if not MT_FRAME_SYNC.startswith(data[:len(MT_FRAME_SYNC)]):
+                                    data = data[1:]
+                                    continue
+                                used = self._read_frame(data)
+                                if not used:
+                                    self._cache = data
+                                    break
+                                data = data[used:]
+                                continue
+
+                            newline_index = data.find(b'\n')
+                            sync_index = data.find(b'\x00')
+                            if sync_index != -1 and (newline_index == -1 or sync_index < newline_index):
+                                # A frame only starts at a line boundary, drop the broken line
+                                data = data[sync_index:]
+                                continue
                             if newline_index == -1:
-                                self._cache = text
+                                self._cache = data
                                 break
 
-                            line = text[:newline_index].rstrip('\r')
-                            text = text[newline_index + 1:]
+                            line = data[:newline_index].decode('utf-8', errors='backslashreplace')
+                            line = line.rstrip('\r')
+                            data = data[newline_index + 1:]
 
                             if len(line) > 10 and line[-9] == '\t':
                                 line = line[:-9]  # remove CRC
@@ -266,6 +340,8 @@ class SerialConsole(WestCommand):
                             help='File to store console output')
         parser.add_argument('--modem-trace-file', type=str, default=DEFAULT_MODEM_TRACE_FILE,
                             help='File to store modem trace output')
+        parser.add_argument('--modem-trace-binary', action='store_true',
+                            help='Switch the device to binary modem trace frames (AT$MTMODE=1)')
         parser.add_argument('--input', type=str, default='',
                             help='Initial input to send to the console. Can be a string or a path to a file whose contents will be sent.')
         return parser
@@ -281,7 +357,8 @@ class SerialConsole(WestCommand):
             connector.set_modem_trace_file(args.modem_trace_file)
             source_text = f'File: {port}'
         else:
-            connector = SerialConnector(port=port, baudrate=args.baudrate)
+            connector = SerialConnector(port=port, baudrate=args.baudrate,
+                                        modem_trace_binary=args.modem_trace_binary)
             connector.set_modem_trace_file(args.modem_trace_file)
             source_text = f'Device: {port}'
 
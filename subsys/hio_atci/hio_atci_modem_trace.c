@@ -17,6 +17,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/base64.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
 
 /* Standard includes */
 #include <errno.h>
@@ -36,15 +38,32 @@ LOG_MODULE_REGISTER(hio_atci_modem_trace, CONFIG_HIO_ATCI_LOG_LEVEL);
 #error "BUFFER_SIZE is too large for the base64 encoding. Please reduce it."
 #endif
 
+/*
+ * Binary frame, always written at a line boundary:
+ *
+ *   00 'M' 'T' | length (u16 LE) | payload | CRC32 (u32 LE)
+ *
+ * The NUL never occurs in the text output, so the host tells a frame from a
+ * line by its first byte. The CRC32 (IEEE) covers the length and the payload.
+ */
+#define FRAME_SYNC     "\0MT"
+#define FRAME_SYNC_LEN 3
+#define FRAME_LEN_SIZE 2
+#define FRAME_CRC_SIZE 4
+
+static uint8_t m_buf[CONFIG_HIO_ATCI_MODEM_TRACE_BUFF_SIZE];
+
+static uint64_t m_bytes;
+static uint32_t m_frames;
+static int64_t m_start;
+
 #if !defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_RAM)
 #error "Modem trace backend RAM is not enabled. Please enable it in prj.conf. CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_RAM=y"
 #endif
 
-int process(const struct hio_atci *atci)
+static int read_trace(uint8_t *buf, size_t size)
 {
-	static uint8_t buf[BUFFER_SIZE];
-
-	int len = nrf_modem_lib_trace_read(buf, sizeof(buf));
+	int len = nrf_modem_lib_trace_read(buf, size);
 
 	if (len < 0) {
 		if (len == -1) {
@@ -54,14 +73,21 @@ int process(const struct hio_atci *atci)
 		return len; // Error occurred
 	}
 
-	if (len == 0) {
-		return 0; // No data to process
-	}
+	m_bytes += len;
+
+	return len;
+}
 
-	// LOG_INF("nrf_modem_lib_trace_data_size: %zu", nrf_modem_lib_trace_data_size());
+static int process_text(const struct hio_atci *atci)
+{
+	int len = read_trace(m_buf, BUFFER_SIZE);
+	if (len <= 0) {
+		return len;
+	}
 
 	size_t olen = 0;
-	int ret = base64_encode(atci->ctx->tmp_buff, sizeof(atci->ctx->tmp_buff), &olen, buf, len);
+	int ret = base64_encode(atci->ctx->tmp_buff, sizeof(atci->ctx->tmp_buff), &olen, m_buf,
+				len);
 	if (ret) {
 		LOG_ERR("Base64 encoding failed: %d", ret);
 		return ret;
@@ -81,6 +107,45 @@ int process(const struct hio_atci *atci)
 	return size;
 }
 
+static int process_binary(const struct hio_atci *atci)
+{
+	int len = read_trace(m_buf, sizeof(m_buf));
+	if (len <= 0) {
+		return len;
+	}
+
+	uint8_t len_le[FRAME_LEN_SIZE];
+	sys_put_le16(len, len_le);
+
+	uint8_t crc_le[FRAME_CRC_SIZE];
+	uint32_t crc = crc32_ieee_update(0, len_le, sizeof(len_le));
+	sys_put_le32(crc32_ieee_update(crc, m_buf, len), crc_le);
+
+	/* The frame carries its own CRC, the line CRC would corrupt it */
+	uint8_t crc_mode = atci->ctx->crc_mode;
+	atci->ctx->crc_mode = 0;
+
+	hio_atci_io_write(atci, FRAME_SYNC, FRAME_SYNC_LEN);
+	hio_atci_io_write(atci, len_le, sizeof(len_le));
+	hio_atci_io_write(atci, m_buf, len);
+	hio_atci_io_write(atci, crc_le, sizeof(crc_le));
+
+	atci->ctx->crc_mode = crc_mode;
+
+	m_frames++;
+
+	return nrf_modem_lib_trace_data_size();
+}
+
+static int process(const struct hio_atci *atci)
+{
+	if (atci->ctx->modem_trace_mode == HIO_ATCI_MODEM_TRACE_MODE_BINARY) {
+		return process_binary(atci);
+	}
+
+	return process_text(atci);
+}
+
 int hio_atci_modem_trace_process(const struct hio_atci *atci)
 {
 	int ret = 0;
@@ -90,3 +155,50 @@ int hio_atci_modem_trace_process(const struct hio_atci *atci)
 
 	return ret;
 }
+
+static int at_mtmode_set(const struct hio_atci *atci, char *argv)
+{
+	if (!atci->ctx->modem_trace) {
+		return -ENOTSUP;
+	}
+
+	if (!argv || strlen(argv) != 1) {
+		return -EINVAL;
+	}
+
+	switch (argv[0]) {
+	case '0':
+		atci->ctx->modem_trace_mode = HIO_ATCI_MODEM_TRACE_MODE_TEXT;
+		break;
+	case '1':
+		atci->ctx->modem_trace_mode = HIO_ATCI_MODEM_TRACE_MODE_BINARY;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	m_bytes = 0;
+	m_frames = 0;
+	m_start = k_uptime_get();
+
+	return 0;
+}
+
+static int at_mtmode_read(const struct hio_atci *atci)
+{
+	if (!atci->ctx->modem_trace) {
+		return -ENOTSUP;
+	}
+
+	int64_t elapsed = k_uptime_get() - m_start;
+	uint64_t rate = elapsed > 0 ? m_bytes * MSEC_PER_SEC / elapsed : 0;
+
+	/* Mode, trace bytes and frames since the mode was set, bytes per second */
+	hio_atci_printfln(atci, "$MTMODE: %u,%llu,%u,%llu", atci->ctx->modem_trace_mode,
+			  (unsigned long long)m_bytes, m_frames, (unsigned long long)rate);
+
+	return 0;
+}
+
+HIO_ATCI_CMD_REGISTER(mtmode, "$MTMODE", 0, NULL, at_mtmode_set, at_mtmode_read, NULL,
+		      "Modem trace mode (0: text, 1: binary)");
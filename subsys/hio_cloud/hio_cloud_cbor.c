@@ -41,9 +41,19 @@ int hio_cloud_cbor_ncellmeas_put(zcbor_state_t *zs, const struct hio_lte_ncellme
 	zcbor_list_start_encode(zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH);
 	zcbor_uint32_put(zs, 1); /* version */
 	zcbor_uint32_put(zs, param->act);
-	zcbor_uint32_put(zs, param->num_cells);
+
+	/* Cells with a value out of range are left out */
+	uint8_t num_cells = 0;
+	for (uint8_t i = 0; i < param->num_cells; i++) {
+		num_cells += param->cells[i].valid;
+	}
+
+	zcbor_uint32_put(zs, num_cells);
 	for (uint8_t i = 0; i < param->num_cells; i++) {
 		const struct hio_lte_ncellmeas_cell_param *cell = &param->cells[i];
+		if (!cell->valid) {
+			continue;
+		}
 		zcbor_uint32_put(zs, cell->eci);
 		zcbor_uint32_put(zs, cell->mcc);
 		zcbor_uint32_put(zs, cell->mnc);
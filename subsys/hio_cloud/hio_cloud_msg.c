@@ -79,6 +79,10 @@
 #define UL_SHELL_RESPONSE_KEY_RESULT  0x01
 #define UL_SHELL_RESPONSE_KEY_OUTPUTS 0x02
 
+/* Kept free while streaming a response: truncation marker, result, and the
+ * closing of the response map and of the whole message */
+#define UL_SHELL_RESERVE 64
+
 #define UL_FIRMWARE_KEY_TARGET     0x00
 #define UL_FIRMWARE_KEY_TYPE       0x01
 #define UL_FIRMWARE_KEY_ID         0x02
@@ -1025,6 +1029,132 @@ int hio_cloud_msg_pack_upshell_add_response(struct hio_cloud_msg_upshell *upshel
 	return 0;
 }
 
+static size_t upshell_free(struct hio_cloud_msg_upshell *upshell)
+{
+	size_t free = upshell->zs->payload_end - upshell->zs->payload;
+
+	return free > UL_SHELL_RESERVE ? free - UL_SHELL_RESERVE : 0;
+}
+
+int hio_cloud_msg_pack_upshell_response_start(struct hio_cloud_msg_upshell *upshell,
+					      const char *command)
+{
+	if (upshell == NULL) {
+		LOG_ERR("Invalid upshell pointer");
+		return -EINVAL;
+	}
+
+	if (command == NULL) {
+		LOG_ERR("Invalid cmd pointer");
+		return -EINVAL;
+	}
+
+	size_t len = strlen(command);
+
+	/* map start + 2 keys + tstr header + list start */
+	if (upshell_free(upshell) < len + 10) {
+		return -ENOSPC;
+	}
+
+	upshell->truncated = 0;
+
+	if (!zcbor_map_start_encode(upshell->zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH)) {
+		LOG_ERR("Call `zcbor_map_start_encode` failed");
+		return -EBADMSG;
+	}
+
+	if (!zcbor_uint32_put(upshell->zs, UL_SHELL_RESPONSE_KEY_COMMAND)) {
+		LOG_ERR("Call `zcbor_uint32_put` failed");
+		return -EBADMSG;
+	}
+
+	if (!zcbor_tstr_encode_ptr(upshell->zs, command, len)) {
+		LOG_ERR("Call `zcbor_tstr_encode_ptr` failed");
+		return -EBADMSG;
+	}
+
+	if (!zcbor_uint32_put(upshell->zs, UL_SHELL_RESPONSE_KEY_OUTPUTS)) {
+		LOG_ERR("Call `zcbor_uint32_put` failed");
+		return -EBADMSG;
+	}
+
+	if (!zcbor_list_start_encode(upshell->zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH)) {
+		LOG_ERR("Call `zcbor_list_start_encode` failed");
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+int hio_cloud_msg_pack_upshell_response_line(struct hio_cloud_msg_upshell *upshell,
+					     const char *line, size_t len)
+{
+	if (upshell == NULL) {
+		LOG_ERR("Invalid upshell pointer");
+		return -EINVAL;
+	}
+
+	/* Keep the output in order: once a line is dropped, drop the rest */
+	if (upshell->truncated || upshell_free(upshell) < len + 5) {
+		upshell->truncated += len;
+		return 0;
+	}
+
+	if (!zcbor_tstr_encode_ptr(upshell->zs, line, len)) {
+		LOG_ERR("Call `zcbor_tstr_encode_ptr` failed");
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+int hio_cloud_msg_pack_upshell_response_end(struct hio_cloud_msg_upshell *upshell,
+					    const int result)
+{
+	if (upshell == NULL) {
+		LOG_ERR("Invalid upshell pointer");
+		return -EINVAL;
+	}
+
+	if (upshell->truncated) {
+		char marker[32];
+
+		LOG_WRN("Shell output truncated: %zu byte(s)", upshell->truncated);
+
+		int len = snprintf(marker, sizeof(marker), "... %zu byte(s) truncated",
+				   upshell->truncated);
+
+		if (!zcbor_tstr_encode_ptr(upshell->zs, marker, MIN(len, sizeof(marker) - 1))) {
+			LOG_ERR("Call `zcbor_tstr_encode_ptr` failed");
+			return -EBADMSG;
+		}
+	}
+
+	if (!zcbor_list_end_encode(upshell->zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH)) {
+		LOG_ERR("Call `zcbor_list_end_encode` failed");
+		return -EBADMSG;
+	}
+
+	if (result) {
+		if (!zcbor_uint32_put(upshell->zs, UL_SHELL_RESPONSE_KEY_RESULT)) {
+			LOG_ERR("Call `zcbor_uint32_put` failed");
+			return -EBADMSG;
+		}
+
+		if (!zcbor_int32_put(upshell->zs, result)) {
+			LOG_ERR("Call `zcbor_int32_put` failed");
+			return -EBADMSG;
+		}
+	}
+
+	if (!zcbor_map_end_encode(upshell->zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH)) {
+		LOG_ERR("Call `zcbor_map_end_encode` failed");
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
 int hio_cloud_msg_pack_upshell_end(struct hio_cloud_msg_upshell *upshell)
 {
 	if (upshell == NULL) {
@@ -61,6 +61,7 @@ struct hio_cloud_msg_dlshell {
 struct hio_cloud_msg_upshell {
 	struct hio_buf *buf;
 	zcbor_state_t zs[2];
+	size_t truncated;
 };
 
 struct hio_cloud_msg_dlfirmware {
@@ -116,6 +117,18 @@ int hio_cloud_msg_pack_upshell_start(struct hio_cloud_msg_upshell *upshell, stru
 int hio_cloud_msg_pack_upshell_add_response(struct hio_cloud_msg_upshell *upshell,
 					    const char *command, const int result,
 					    const char *output);
+
+/* Line-based variant of hio_cloud_msg_pack_upshell_add_response: start the
+ * response, add the output lines one by one, end with the result.
+ * Lines that no longer fit are counted and replaced by a single marker line,
+ * space for closing the message is always kept in reserve. */
+int hio_cloud_msg_pack_upshell_response_start(struct hio_cloud_msg_upshell *upshell,
+					      const char *command);
+int hio_cloud_msg_pack_upshell_response_line(struct hio_cloud_msg_upshell *upshell,
+					     const char *line, size_t len);
+int hio_cloud_msg_pack_upshell_response_end(struct hio_cloud_msg_upshell *upshell,
+					    const int result);
+
 int hio_cloud_msg_pack_upshell_end(struct hio_cloud_msg_upshell *upshell);
 
 int hio_cloud_msg_pack_firmware(struct hio_buf *buf, const struct hio_cloud_upfirmware *upfirmware);
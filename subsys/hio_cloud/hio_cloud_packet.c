@@ -78,6 +78,11 @@ int hio_cloud_packet_unpack(struct hio_cloud_packet *pck, struct hio_buf *buf)
 }
 
 
+/* Payload is copied into the send buffer in chunks of this size and each chunk
+ * is hashed right after it is copied, while it is still hot in the cache. A
+ * multiple of the SHA-256 block size keeps the hash engine on full blocks. */
+#define SIGNED_PACK_CHUNK_SIZE 256
+
 int hio_cloud_packet_signed_pack(struct hio_cloud_packet *pck, uint32_t serial_number,
 				 uint8_t claim_token[16], struct hio_buf *buf)
 {
@@ -89,19 +94,9 @@ int hio_cloud_packet_signed_pack(struct hio_cloud_packet *pck, uint32_t serial_n
 	int ret;
 
 	hio_buf_reset(buf);
-	hio_buf_seek(buf, HIO_CLOUD_PACKET_SIGNED_MIN_SIZE);
-
-	if (pck->data_len > 0) {
-		ret = hio_buf_append_mem(buf, pck->data, pck->data_len);
-		if (ret) {
-			LOG_ERR("Call `hio_buf_append_mem` failed: %d", ret);
-			return ret;
-		}
-	}
-
-	size_t used = hio_buf_get_used(buf);
 
-	ret = hio_buf_seek(buf, 8);
+	/* Hash is backfilled once the digest is known */
+	ret = hio_buf_seek(buf, HIO_CLOUD_PACKET_SIGNED_HASH_SIZE);
 	if (ret) {
 		LOG_ERR("Call `hio_buf_seek` failed: %d", ret);
 		return ret;
@@ -121,28 +116,47 @@ int hio_cloud_packet_signed_pack(struct hio_cloud_packet *pck, uint32_t serial_n
 		return ret;
 	}
 
-	uint8_t packet_hash[8];
-	ret = hio_cloud_calculate_hash(packet_hash, claim_token, 16, hio_buf_get_mem(buf) + 8, used - 8);
+	struct hio_cloud_hash hash;
+
+	ret = hio_cloud_hash_begin(&hash);
 	if (ret) {
-		LOG_ERR("Call `hio_cloud_calculate_hash` failed: %d", ret);
+		LOG_ERR("Call `hio_cloud_hash_begin` failed: %d", ret);
 		return ret;
 	}
 
-	ret = hio_buf_seek(buf, 0);
+	ret = hio_cloud_hash_update(&hash, claim_token, 16);
 	if (ret) {
-		LOG_ERR("Call `hio_buf_seek` failed: %d", ret);
+		LOG_ERR("Call `hio_cloud_hash_update` failed: %d", ret);
 		return ret;
 	}
 
-	ret = hio_buf_append_mem(buf, packet_hash, sizeof(packet_hash));
+	ret = hio_cloud_hash_update(&hash, hio_buf_get_mem(buf) + HIO_CLOUD_PACKET_SIGNED_HASH_SIZE,
+				    HIO_CLOUD_PACKET_SIGNED_SN_SIZE + HIO_CLOUD_PACKET_HEADER_SIZE);
 	if (ret) {
-		LOG_ERR("Call `hio_buf_append_mem` failed: %d", ret);
+		LOG_ERR("Call `hio_cloud_hash_update` failed: %d", ret);
 		return ret;
 	}
 
-	ret = hio_buf_seek(buf, used);
+	for (size_t offset = 0; offset < pck->data_len; offset += SIGNED_PACK_CHUNK_SIZE) {
+		size_t len = MIN(pck->data_len - offset, SIGNED_PACK_CHUNK_SIZE);
+
+		ret = hio_buf_append_mem(buf, pck->data + offset, len);
+		if (ret) {
+			LOG_ERR("Call `hio_buf_append_mem` failed: %d", ret);
+			hio_cloud_hash_abort(&hash);
+			return ret;
+		}
+
+		ret = hio_cloud_hash_update(&hash, pck->data + offset, len);
+		if (ret) {
+			LOG_ERR("Call `hio_cloud_hash_update` failed: %d", ret);
+			return ret;
+		}
+	}
+
+	ret = hio_cloud_hash_finish(&hash, hio_buf_get_mem(buf));
 	if (ret) {
-		LOG_ERR("Call `hio_buf_seek` failed: %d", ret);
+		LOG_ERR("Call `hio_cloud_hash_finish` failed: %d", ret);
 		return ret;
 	}
 
@@ -159,29 +173,53 @@ int hio_cloud_packet_signed_unpack(struct hio_cloud_packet *pck, uint32_t *seria
 		return -EBADMSG;
 	}
 
-	uint8_t packet_hash[8];
-	ret = hio_cloud_calculate_hash(packet_hash, claim_token, 16,
-				       hio_buf_get_mem(buf) + 8, hio_buf_get_used(buf) - 8);
+	uint8_t *mem = hio_buf_get_mem(buf);
+	size_t used = hio_buf_get_used(buf);
+
+	struct hio_cloud_hash hash;
+
+	ret = hio_cloud_hash_begin(&hash);
+	if (ret) {
+		LOG_ERR("Call `hio_cloud_hash_begin` failed: %d", ret);
+		return ret;
+	}
+
+	ret = hio_cloud_hash_update(&hash, claim_token, 16);
+	if (ret) {
+		LOG_ERR("Call `hio_cloud_hash_update` failed: %d", ret);
+		return ret;
+	}
+
+	ret = hio_cloud_hash_update(&hash, mem + HIO_CLOUD_PACKET_SIGNED_HASH_SIZE,
+				    used - HIO_CLOUD_PACKET_SIGNED_HASH_SIZE);
+	if (ret) {
+		LOG_ERR("Call `hio_cloud_hash_update` failed: %d", ret);
+		return ret;
+	}
+
+	uint8_t packet_hash[HIO_CLOUD_PACKET_SIGNED_HASH_SIZE];
+
+	ret = hio_cloud_hash_finish(&hash, packet_hash);
 	if (ret) {
-		LOG_ERR("Call `hio_cloud_calculate_hash` failed: %d", ret);
+		LOG_ERR("Call `hio_cloud_hash_finish` failed: %d", ret);
 		return ret;
 	}
 
-	if (memcmp(packet_hash, hio_buf_get_mem(buf), sizeof(packet_hash))) {
+	if (memcmp(packet_hash, mem, sizeof(packet_hash))) {
 		LOG_ERR("Packet hash mismatch");
 		return -EBADMSG;
 	}
 
 	if (serial_number) {
-		*serial_number = sys_get_be32(hio_buf_get_mem(buf) + 8);
+		*serial_number = sys_get_be32(mem + HIO_CLOUD_PACKET_SIGNED_HASH_SIZE);
 	}
 
-	uint16_t header = sys_get_be16(hio_buf_get_mem(buf) + 12);
+	uint16_t header = sys_get_be16(mem + HIO_CLOUD_PACKET_SIGNED_HEADER_SIZE);
 
 	pck->flags = (header >> 12) & BIT_MASK(4);
 	pck->sequence = header & BIT_MASK(12);
-	pck->data = hio_buf_get_mem(buf) + HIO_CLOUD_PACKET_SIGNED_MIN_SIZE;
-	pck->data_len = hio_buf_get_used(buf) - HIO_CLOUD_PACKET_SIGNED_MIN_SIZE;
+	pck->data = mem + HIO_CLOUD_PACKET_SIGNED_MIN_SIZE;
+	pck->data_len = used - HIO_CLOUD_PACKET_SIGNED_MIN_SIZE;
 
 	return 0;
 }
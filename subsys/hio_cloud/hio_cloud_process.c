@@ -6,6 +6,7 @@
 
 #include "hio_cloud_backend.h"
 #include "hio_cloud_process.h"
+#include "hio_cloud_replay.h"
 #include "hio_cloud_util.h"
 #include "hio_cloud_msg.h"
 #include "hio_cloud_transfer.h"
@@ -120,21 +121,67 @@ int hio_cloud_process_dlconfig(struct hio_cloud_msg_dlconfig *config)
 	return 0;
 }
 
-int hio_cloud_process_dlshell(struct hio_cloud_msg_dlshell *dlshell, struct hio_buf *buf)
+/* Encodes the captured output line by line straight from the dummy shell
+ * buffer, without another copy */
+static int pack_dlshell_output(struct hio_cloud_msg_upshell *upshell, const char *output,
+			       size_t size)
 {
-	const struct shell *sh = shell_backend_dummy_get_ptr();
+	const char *line = output;
+	const char *end = output + size;
+
+	for (const char *p = output; p <= end; p++) {
+		if (p < end && *p != '\n') {
+			continue;
+		}
+
+		size_t len = p - line;
+		if (len && line[len - 1] == '\r') {
+			len--;
+		}
+
+		/* Empty lines are dropped, same as pack_shell_output_as_list */
+		if (len) {
+			int ret = hio_cloud_msg_pack_upshell_response_line(upshell, line, len);
+			if (ret) {
+				return ret;
+			}
+		}
+
+		line = p + 1;
+	}
 
-	shell_backend_dummy_clear_output(sh);
+	return 0;
+}
 
+int hio_cloud_process_dlshell(struct hio_cloud_msg_dlshell *dlshell, struct hio_buf *buf)
+{
 	LOG_INF("Received shell: num cmds: %d", dlshell->commands);
 
 	int ret;
 	size_t size;
 	struct hio_cloud_msg_upshell upshell;
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+
+#if defined(CONFIG_HIO_CLOUD_SHELL_REPLAY)
+	ret = hio_cloud_replay_get(dlshell->message_id, buf);
+	if (!ret) {
+		LOG_INF("Replayed shell request, sending cached response");
+		return 0;
+	} else if (ret != -ENOENT) {
+		LOG_ERR("Call `hio_cloud_replay_get` failed: %d", ret);
+		return ret;
+	}
+
+	size_t offset = hio_buf_get_used(buf);
+#endif
 
 	HIO_BUF_DEFINE(command, CONFIG_SHELL_CMD_BUFF_SIZE);
 
-	hio_cloud_msg_pack_upshell_start(&upshell, buf, dlshell->message_id);
+	ret = hio_cloud_msg_pack_upshell_start(&upshell, buf, dlshell->message_id);
+	if (ret) {
+		LOG_ERR("Call `hio_cloud_msg_pack_upshell_start` failed: %d", ret);
+		return ret;
+	}
 
 	for (int i = 0; i < dlshell->commands; i++) {
 		hio_buf_reset(&command);
@@ -144,24 +191,38 @@ int hio_cloud_process_dlshell(struct hio_cloud_msg_dlshell *dlshell, struct hio_
 			return ret;
 		}
 
-		shell_backend_dummy_clear_output(sh);
 		const char *cmd = hio_buf_get_mem(&command);
 
+		ret = hio_cloud_msg_pack_upshell_response_start(&upshell, cmd);
+		if (ret == -ENOSPC) {
+			LOG_WRN("No space left, skipping commands %d..%d", i, dlshell->commands - 1);
+			break;
+		} else if (ret) {
+			LOG_ERR("Call `hio_cloud_msg_pack_upshell_response_start` failed: %d", ret);
+			return ret;
+		}
+
 		LOG_DBG("Execute command %d: %s", i, cmd);
 
+		shell_backend_dummy_clear_output(sh);
+
 		int result = shell_execute_cmd(sh, cmd);
 
-		const char *output = (char *)shell_backend_dummy_get_output(sh, &size);
+		const char *output = shell_backend_dummy_get_output(sh, &size);
 		if (!output) {
 			LOG_ERR("Failed to get output");
 			return -ENOMEM;
 		}
 
-		LOG_DBG("Shell output: %s", output);
+		ret = pack_dlshell_output(&upshell, output, size);
+		if (ret) {
+			LOG_ERR("Call `pack_dlshell_output` failed: %d", ret);
+			return ret;
+		}
 
-		ret = hio_cloud_msg_pack_upshell_add_response(&upshell, cmd, result, output);
+		ret = hio_cloud_msg_pack_upshell_response_end(&upshell, result);
 		if (ret) {
-			LOG_ERR("Call `cloud_msg_pack_upshell_add_cmd` failed: %d", ret);
+			LOG_ERR("Call `hio_cloud_msg_pack_upshell_response_end` failed: %d", ret);
 			return ret;
 		}
 	}
@@ -172,6 +233,16 @@ int hio_cloud_process_dlshell(struct hio_cloud_msg_dlshell *dlshell, struct hio_
 		return ret;
 	}
 
+#if defined(CONFIG_HIO_CLOUD_SHELL_REPLAY)
+	ret = hio_cloud_replay_put(dlshell->message_id, hio_buf_get_mem(buf) + offset,
+				   hio_buf_get_used(buf) - offset);
+	if (ret == -EMSGSIZE) {
+		LOG_DBG("Response too large to cache");
+	} else if (ret && ret != -EINVAL) {
+		LOG_WRN("Call `hio_cloud_replay_put` failed: %d", ret);
+	}
+#endif
+
 	return 0;
 }
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: LicenseRef-HARDWARIO-5-Clause
+ */
+
+#include "hio_cloud_replay.h"
+
+/* HIO includes */
+#include <hio/hio_buf.h>
+
+/* Zephyr includes */
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_cloud_replay, CONFIG_HIO_CLOUD_LOG_LEVEL);
+
+struct replay_entry {
+	hio_cloud_uuid_t message_id;
+	/* 0 = free slot; otherwise larger is more recently used */
+	uint32_t stamp;
+	size_t len;
+	uint8_t data[CONFIG_HIO_CLOUD_SHELL_REPLAY_MSG_SIZE];
+};
+
+static struct replay_entry m_entries[CONFIG_HIO_CLOUD_SHELL_REPLAY_CACHE_SIZE];
+static uint32_t m_stamp;
+
+static bool is_valid_id(const hio_cloud_uuid_t message_id)
+{
+	for (size_t i = 0; i < sizeof(hio_cloud_uuid_t); i++) {
+		if (message_id[i]) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static struct replay_entry *find(const hio_cloud_uuid_t message_id)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(m_entries); i++) {
+		if (m_entries[i].stamp &&
+		    !memcmp(m_entries[i].message_id, message_id, sizeof(hio_cloud_uuid_t))) {
+			return &m_entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+int hio_cloud_replay_get(const hio_cloud_uuid_t message_id, struct hio_buf *buf)
+{
+	if (!is_valid_id(message_id)) {
+		return -ENOENT;
+	}
+
+	struct replay_entry *entry = find(message_id);
+	if (!entry) {
+		return -ENOENT;
+	}
+
+	int ret = hio_buf_append_mem(buf, entry->data, entry->len);
+	if (ret) {
+		LOG_ERR("Call `hio_buf_append_mem` failed: %d", ret);
+		return ret;
+	}
+
+	entry->stamp = ++m_stamp;
+
+	return 0;
+}
+
+int hio_cloud_replay_put(const hio_cloud_uuid_t message_id, const uint8_t *data, size_t len)
+{
+	if (!is_valid_id(message_id)) {
+		return -EINVAL;
+	}
+
+	if (len > CONFIG_HIO_CLOUD_SHELL_REPLAY_MSG_SIZE) {
+		return -EMSGSIZE;
+	}
+
+	struct replay_entry *entry = find(message_id);
+
+	if (!entry) {
+		entry = &m_entries[0];
+
+		for (size_t i = 1; i < ARRAY_SIZE(m_entries); i++) {
+			if (m_entries[i].stamp < entry->stamp) {
+				entry = &m_entries[i];
+			}
+		}
+	}
+
+	memcpy(entry->message_id, message_id, sizeof(hio_cloud_uuid_t));
+	memcpy(entry->data, data, len);
+	entry->len = len;
+	entry->stamp = ++m_stamp;
+
+	return 0;
+}
+
+void hio_cloud_replay_clear(void)
+{
+	memset(m_entries, 0, sizeof(m_entries));
+	m_stamp = 0;
+}
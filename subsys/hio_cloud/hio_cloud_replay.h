@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: LicenseRef-HARDWARIO-5-Clause
+ */
+
+#ifndef HIO_INCLUDE_CLOUD_REPLAY_H_
+#define HIO_INCLUDE_CLOUD_REPLAY_H_
+
+#include "hio_cloud_msg.h"
+
+/* HIO includes */
+#include <hio/hio_buf.h>
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* LRU of packed UL_UPLOAD_SHELL responses keyed by the DL_DOWNLOAD_SHELL
+ * message_id. When the server replays a shell request (lost ACK), the cached
+ * response is sent again instead of re-running the commands. Only used from
+ * the cloud work queue. */
+
+/* Append the cached response for @p message_id to @p buf.
+ * Returns -ENOENT on miss (including the all-zero "no id" message_id). */
+int hio_cloud_replay_get(const hio_cloud_uuid_t message_id, struct hio_buf *buf);
+
+/* Store a response, evicting the least recently used entry if full.
+ * Returns -EMSGSIZE if it exceeds CONFIG_HIO_CLOUD_SHELL_REPLAY_MSG_SIZE. */
+int hio_cloud_replay_put(const hio_cloud_uuid_t message_id, const uint8_t *data, size_t len);
+
+void hio_cloud_replay_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HIO_INCLUDE_CLOUD_REPLAY_H_ */
@@ -6,6 +6,7 @@
 
 #include "hio_cloud_backend.h"
 #include "hio_cloud_transfer.h"
+#include "hio_cloud_util.h"
 
 /* HIO includes */
 #include <hio/hio_cloud.h>
@@ -210,6 +211,90 @@ static int cmd_psk_set(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_hash_info(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	shell_print(shell, "backend: %s", hio_cloud_hash_backend_name());
+	shell_print(shell, "context size: %zu bytes", sizeof(struct hio_cloud_hash));
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
+#define HASH_BENCH_SIZE 4096
+
+/* SHELL_COND_CMD_ARG drops the handler without CONFIG_HIO_CLOUD_HASH_BENCH, and
+ * this function with its buffer goes along with it */
+static int hash_bench(const struct shell *shell)
+{
+	static const size_t chunk_sizes[] = {16, 64, 256, 1024};
+	static uint8_t data[HASH_BENCH_SIZE];
+
+	int ret;
+
+	shell_print(shell, "backend: %s", hio_cloud_hash_backend_name());
+	shell_print(shell, "context size: %zu bytes", sizeof(struct hio_cloud_hash));
+	shell_print(shell, "data size: %zu bytes", sizeof(data));
+
+	for (size_t i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		struct hio_cloud_hash hash;
+		uint8_t digest[8];
+
+		uint32_t start = k_cycle_get_32();
+
+		ret = hio_cloud_hash_begin(&hash);
+		if (ret) {
+			shell_error(shell, "hio_cloud_hash_begin failed: %d", ret);
+			return ret;
+		}
+
+		for (size_t offset = 0; offset < sizeof(data); offset += chunk_sizes[i]) {
+			ret = hio_cloud_hash_update(&hash, &data[offset], chunk_sizes[i]);
+			if (ret) {
+				shell_error(shell, "hio_cloud_hash_update failed: %d", ret);
+				return ret;
+			}
+		}
+
+		ret = hio_cloud_hash_finish(&hash, digest);
+		if (ret) {
+			shell_error(shell, "hio_cloud_hash_finish failed: %d", ret);
+			return ret;
+		}
+
+		uint64_t ns = k_cyc_to_ns_floor64(k_cycle_get_32() - start);
+
+		shell_print(shell, "chunk %zu: %llu us, %llu kB/s", chunk_sizes[i], ns / 1000,
+			    ns ? (uint64_t)sizeof(data) * 1000000ULL / ns : 0);
+	}
+
+	return 0;
+}
+
+static int cmd_hash_bench(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	int ret = hash_bench(shell);
+	if (ret) {
+		return ret;
+	}
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
 static int print_help(const struct shell *shell, size_t argc, char **argv)
 {
 	if (argc > 1) {
@@ -237,6 +322,19 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(
+
+	sub_cloud_hash,
+
+	SHELL_CMD_ARG(info, NULL, "Get hash backend info.", cmd_hash_info, 1, 0),
+
+	SHELL_COND_CMD_ARG(CONFIG_HIO_CLOUD_HASH_BENCH, bench, NULL,
+			   "Measure hash backend throughput.", cmd_hash_bench, 1, 0),
+
+	SHELL_SUBCMD_SET_END
+
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(
 
 	psk,
@@ -263,6 +361,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 
 	SHELL_CMD_ARG(firmware, &sub_cloud_firmware, "Firmware commands.", print_help, 1, 0),
 
+	SHELL_CMD_ARG(hash, &sub_cloud_hash, "Hash backend commands.", print_help, 1, 0),
+
 	SHELL_SUBCMD_SET_END
 
 );
@@ -27,6 +27,7 @@
 #else
 #include <zephyr/fs/nvs.h>
 #endif
+#include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/settings/settings.h>
@@ -36,9 +37,30 @@
 
 LOG_MODULE_REGISTER(cloud_util, CONFIG_HIO_CLOUD_LOG_LEVEL);
 
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
+
+static psa_status_t m_psa_status = PSA_ERROR_BAD_STATE;
+
+/* HIO_CLOUD_HASH_AUTO may pick PSA on builds where no one else brings the
+ * crypto core up; done once instead of on every hash */
+static int hash_init(void)
+{
+	m_psa_status = psa_crypto_init();
+	if (m_psa_status != PSA_SUCCESS) {
+		LOG_ERR("Call `psa_crypto_init` failed: %d", m_psa_status);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+SYS_INIT(hash_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#endif
+
 int hio_cloud_hash_begin(struct hio_cloud_hash *h)
 {
-#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_MBEDTLS)
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_MBEDTLS)
 	int ret;
 
 	mbedtls_sha256_init(&h->ctx);
@@ -48,9 +70,14 @@ int hio_cloud_hash_begin(struct hio_cloud_hash *h)
 		mbedtls_sha256_free(&h->ctx);
 		return -EINVAL;
 	}
-#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_PSA)
+#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
 	psa_status_t status;
 
+	if (m_psa_status != PSA_SUCCESS) {
+		LOG_ERR("PSA crypto not initialized: %d", m_psa_status);
+		return -EINVAL;
+	}
+
 #if NCS_VERSION_NUMBER >= 0x30400
 	/* PSA_HASH_OPERATION_INIT is an empty initializer `{ }` here, which is
 	 * not valid in an assignment */
@@ -78,7 +105,7 @@ int hio_cloud_hash_begin(struct hio_cloud_hash *h)
 
 int hio_cloud_hash_update(struct hio_cloud_hash *h, const void *data, size_t len)
 {
-#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_MBEDTLS)
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_MBEDTLS)
 	int ret;
 
 	ret = mbedtls_sha256_update(&h->ctx, data, len);
@@ -87,7 +114,7 @@ int hio_cloud_hash_update(struct hio_cloud_hash *h, const void *data, size_t len
 		mbedtls_sha256_free(&h->ctx);
 		return -EINVAL;
 	}
-#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_PSA)
+#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
 	psa_status_t status;
 
 	status = psa_hash_update(&h->op, data, len);
@@ -113,7 +140,7 @@ int hio_cloud_hash_finish(struct hio_cloud_hash *h, uint8_t hash[8])
 {
 	uint8_t digest[32];
 
-#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_MBEDTLS)
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_MBEDTLS)
 	int ret;
 
 	ret = mbedtls_sha256_finish(&h->ctx, digest);
@@ -123,7 +150,7 @@ int hio_cloud_hash_finish(struct hio_cloud_hash *h, uint8_t hash[8])
 		return -EINVAL;
 	}
 	mbedtls_sha256_free(&h->ctx);
-#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_PSA)
+#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
 	psa_status_t status;
 	size_t hash_len;
 
@@ -152,15 +179,26 @@ int hio_cloud_hash_finish(struct hio_cloud_hash *h, uint8_t hash[8])
 
 void hio_cloud_hash_abort(struct hio_cloud_hash *h)
 {
-#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_MBEDTLS)
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_MBEDTLS)
 	mbedtls_sha256_free(&h->ctx);
-#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_PSA)
+#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
 	psa_hash_abort(&h->op);
 #else
 	/* TinyCrypt keeps no external resources tied to the state struct. */
 #endif
 }
 
+const char *hio_cloud_hash_backend_name(void)
+{
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_MBEDTLS)
+	return "mbedtls";
+#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
+	return "psa";
+#else
+	return "tinycrypt";
+#endif
+}
+
 int hio_cloud_calculate_hash(uint8_t hash[8],
 			     const uint8_t *buf1, size_t len1,
 			     const uint8_t *buf2, size_t len2)
@@ -18,9 +18,9 @@
 #include <hio/hio_cloud.h>
 
 /* Crypto includes */
-#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_MBEDTLS)
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_MBEDTLS)
 #include <mbedtls/sha256.h>
-#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_PSA)
+#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
 #include <psa/crypto.h>
 #else
 #include <tinycrypt/constants.h>
@@ -35,9 +35,9 @@ extern "C" {
  * @brief Incremental variant of hio_cloud_calculate_hash (XOR-folded SHA-256).
  */
 struct hio_cloud_hash {
-#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_MBEDTLS)
+#if IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_MBEDTLS)
 	mbedtls_sha256_context ctx;
-#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_PSA)
+#elif IS_ENABLED(CONFIG_HIO_CLOUD_HASH_BACKEND_PSA)
 	psa_hash_operation_t op;
 #else
 	struct tc_sha256_state_struct s;
@@ -59,6 +59,11 @@ int hio_cloud_hash_finish(struct hio_cloud_hash *h, uint8_t hash[8]);
  */
 void hio_cloud_hash_abort(struct hio_cloud_hash *h);
 
+/**
+ * @brief Name of the compiled-in hash backend ("tinycrypt", "mbedtls" or "psa").
+ */
+const char *hio_cloud_hash_backend_name(void);
+
 int hio_cloud_calculate_hash(uint8_t hash[8],
 			     const uint8_t *buf1, size_t len1,
 			     const uint8_t *buf2, size_t len2);
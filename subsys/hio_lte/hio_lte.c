@@ -1,8 +1,17 @@
 #include "hio_lte_config.h"
+#include "hio_lte_defer.h"
+#include "hio_lte_evq.h"
 #include "hio_lte_flow.h"
+#include "hio_lte_gnss.h"
+#include "hio_lte_hint.h"
+#include "hio_lte_hist.h"
+#include "hio_lte_psm.h"
+#include "hio_lte_rtt.h"
 #include "hio_lte_state.h"
 #include "hio_lte_str.h"
 #include "hio_lte_talk.h"
+#include "hio_lte_trace.h"
+#include "hio_lte_txn.h"
 #include "hio_lte_util.h"
 
 /* HIO includes */
@@ -14,10 +23,10 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/time_units.h>
-#include <zephyr/sys/ring_buffer.h>
 
 /* Standard includes */
 #include <errno.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -36,6 +45,8 @@ LOG_MODULE_REGISTER(hio_lte, CONFIG_HIO_LTE_LOG_LEVEL);
 #define SEND_WATCHDOG_GUARD_SEC 1
 #define CONEVAL_TIMEOUT         K_SECONDS(30)
 #define NCELLMEAS_TIMEOUT       K_SECONDS(60)
+/* Added to the search of the receiver, which ends it on its own */
+#define GNSS_WATCHDOG_GUARD_SEC 5
 
 #define WORK_Q_STACK_SIZE 4096
 #define WORK_Q_PRIORITY   K_LOWEST_APPLICATION_THREAD_PRIO
@@ -57,8 +68,11 @@ enum fsm_state {
 	FSM_STATE_RECEIVE,
 	FSM_STATE_CONEVAL,
 	FSM_STATE_NCELLMEAS,
+	FSM_STATE_GNSS,
 };
 
+BUILD_ASSERT(FSM_STATE_GNSS < HIO_LTE_TRACE_STATES_MAX, "FSM state does not fit the trace");
+
 struct fsm_state_desc {
 	enum fsm_state state;
 	int (*on_enter)(void);
@@ -67,20 +81,26 @@ struct fsm_state_desc {
 };
 
 static struct hio_lte_socket_config m_socket_config = {0};
+/* Sockets of hio_lte_add_socket by handle, 0 is m_socket_config. Opening and
+ * closing them is serialized by m_socket_lock */
+static struct hio_lte_socket_config m_added_socket_configs[CONFIG_HIO_LTE_SOCKETS_MAX];
+static bool m_added_sockets[CONFIG_HIO_LTE_SOCKETS_MAX];
+static K_MUTEX_DEFINE(m_socket_lock);
 int m_attach_retry_count = 0;
 enum fsm_state m_state;
+/* FSM event being handled on the LTE thread, for the transition trace */
+static uint8_t m_trace_event = HIO_LTE_TRACE_EVENT_NONE;
 K_MUTEX_DEFINE(m_state_lock);
 struct k_work_delayable m_timeout_work;
 struct k_work m_event_dispatch_work;
-uint8_t m_event_buf[8];
-struct ring_buf m_event_rb;
-K_MUTEX_DEFINE(m_event_rb_lock);
 
 static K_EVENT_DEFINE(m_states_event);
 #define SEND_RECV_BIT BIT(0)
 #define ATTACHED_BIT  BIT(1)
 #define CONNECTED_BIT BIT(2)
 #define DISABLED_BIT  BIT(3)
+#define CONEVAL_BIT   BIT(4)
+#define GNSS_BIT      BIT(5)
 
 #define FLAG_CSCON           BIT(0)
 #define FLAG_GNSS_ENABLE     BIT(1)
@@ -90,20 +110,56 @@ static K_EVENT_DEFINE(m_states_event);
 /* Bit index passed to atomic_*_bit, not a mask; BIT(5) would be 32 and index
  * past the 32-bit atomic word, so the next free index is used directly. */
 #define FLAG_SOCKET_RECONFIG 5
+#define FLAG_CONEVAL_REQ     6
+/* The pending reconfig keeps the server: its DTLS session stays valid */
+#define FLAG_RECONFIG_KEEP_DTLS 7
 atomic_t m_flag = ATOMIC_INIT(0);
 
 K_MUTEX_DEFINE(m_send_recv_lock);
+/* Transactions waiting for m_send_recv_lock */
+static atomic_t m_send_recv_waiting = ATOMIC_INIT(0);
 struct hio_lte_send_recv_param *m_send_recv_param = NULL;
+/* Copy of the datagrams of the transaction, m_send_recv_param points to the
+ * current one */
+static struct hio_lte_send_recv_param m_batch[CONFIG_HIO_LTE_SEND_BATCH_MAX];
+static size_t m_batch_count;
+static size_t m_batch_index;
+static size_t m_batch_done;
 static int m_send_recv_result;
 static int m_send_attempt;
 
 struct hio_lte_metrics m_metrics;
 K_MUTEX_DEFINE(m_metrics_lock);
 static uint32_t m_start = 0;
+/* Time lost on a narrowed attach that fell back to the full configuration */
+static uint32_t m_hint_lost_ms = 0;
 static uint32_t m_start_cscon1 = 0;
+/* Transaction in progress, recorded by transact when it ends; guarded by
+ * m_metrics_lock */
+static struct hio_lte_metrics_txn m_txn;
+static uint32_t m_txn_id;
+/* Transaction the next connection evaluation belongs to; FSM thread only */
+static uint32_t m_coneval_txn_id;
 
 struct hio_lte_cereg_param m_cereg_param;
 
+/* Request of hio_lte_gnss_get_fix, pending while FLAG_GNSS_ENABLE is set. The
+ * caller fills it in before setting the flag, then the LTE thread owns it */
+static K_MUTEX_DEFINE(m_gnss_lock);
+static k_timepoint_t m_gnss_end;
+static struct hio_lte_gnss_fix m_gnss_fix;
+static int m_gnss_result;
+static uint32_t m_gnss_search_ms;
+static bool m_gnss_started;
+static bool m_gnss_hot;
+/* Search in the GNSS state */
+static bool m_gnss_searching;
+static uint32_t m_gnss_search_start;
+/* READY or SLEEP, the idle state the search was started from */
+static enum fsm_state m_gnss_return_state;
+/* A READY request waits for the end of the search */
+static bool m_gnss_ready_deferred;
+
 static sys_slist_t cb_list = SYS_SLIST_STATIC_INIT(&cb_list);
 
 #define ON_ERROR_MAX_FLOW_CHECK_RETRIES 3
@@ -259,10 +315,17 @@ const char *fsm_state_str(enum fsm_state state)
 		return "coneval";
 	case FSM_STATE_NCELLMEAS:
 		return "ncellmeas";
+	case FSM_STATE_GNSS:
+		return "gnss";
 	}
 	return "unknown";
 }
 
+static const char *trace_state_str(uint8_t state)
+{
+	return fsm_state_str((enum fsm_state)state);
+}
+
 static void start_timer(k_timeout_t timeout)
 {
 	k_work_schedule(&m_timeout_work, timeout);
@@ -273,25 +336,30 @@ static void stop_timer(void)
 	k_work_cancel_delayable(&m_timeout_work);
 }
 
-static void delegate_event(enum hio_lte_fsm_event event)
+static void delegate_event_data(enum hio_lte_fsm_event event, const void *data)
 {
+	/* The modem may repeat a CSCON value; only real RRC transitions are
+	 * accounted */
 	if (event == HIO_LTE_FSM_EVENT_CSCON_1) {
-		atomic_set_bit(&m_flag, FLAG_CSCON);
-		m_start_cscon1 = k_uptime_get_32();
+		if (!atomic_test_and_set_bit(&m_flag, FLAG_CSCON)) {
+			m_start_cscon1 = k_uptime_get_32();
+		}
 	} else if (event == HIO_LTE_FSM_EVENT_CSCON_0) {
-		atomic_clear_bit(&m_flag, FLAG_CSCON);
-		k_mutex_lock(&m_metrics_lock, K_FOREVER);
-		m_metrics.cscon_1_last_duration_ms = k_uptime_get_32() - m_start_cscon1;
-		m_metrics.cscon_1_duration_ms += m_metrics.cscon_1_last_duration_ms;
-		k_mutex_unlock(&m_metrics_lock);
-	}
+		if (atomic_test_and_clear_bit(&m_flag, FLAG_CSCON)) {
+			uint32_t duration_ms = k_uptime_get_32() - m_start_cscon1;
 
-	k_mutex_lock(&m_event_rb_lock, K_FOREVER);
-	int ret = ring_buf_put(&m_event_rb, (uint8_t *)&event, 1);
-	k_mutex_unlock(&m_event_rb_lock);
+			k_mutex_lock(&m_metrics_lock, K_FOREVER);
+			m_metrics.cscon_1_last_duration_ms = duration_ms;
+			m_metrics.cscon_1_duration_ms += duration_ms;
+			hio_lte_hist_add(&m_metrics.connected_hist, duration_ms);
+			k_mutex_unlock(&m_metrics_lock);
 
-	if (ret < 0) {
-		LOG_WRN("Failed to put event in ring buffer");
+			hio_lte_txn_set_connected(m_start_cscon1, duration_ms);
+		}
+	}
+
+	int ret = hio_lte_evq_put(event, data);
+	if (ret) {
 		return;
 	}
 
@@ -301,6 +369,11 @@ static void delegate_event(enum hio_lte_fsm_event event)
 	}
 }
 
+static void delegate_event(enum hio_lte_fsm_event event)
+{
+	delegate_event_data(event, NULL);
+}
+
 static void hio_lte_notify(enum hio_lte_event event)
 {
 	struct hio_lte_cb *cb;
@@ -327,7 +400,14 @@ static void event_handler(enum hio_lte_fsm_event event)
 
 	struct fsm_state_desc *fsm_state = get_fsm_state(m_state);
 	if (fsm_state && fsm_state->event_handler) {
+		enum fsm_state from = m_state;
+
+		m_trace_event = event;
 		int ret = fsm_state->event_handler(event);
+		m_trace_event = HIO_LTE_TRACE_EVENT_NONE;
+
+		hio_lte_trace_event(from, m_state, event, ret);
+
 		if (ret < 0) {
 			stop_timer();
 			LOG_WRN("failed to handle event, error: %i", ret);
@@ -360,16 +440,27 @@ static void entering_state(struct fsm_state_desc *next_desc)
 	LOG_INF("%s", fsm_state_str(next_desc->state));
 
 	k_mutex_lock(&m_state_lock, K_FOREVER);
+	enum fsm_state from = m_state;
 	m_state = next_desc->state;
 	k_mutex_unlock(&m_state_lock);
+
+	hio_lte_trace_enter(from, next_desc->state);
+
+	/* Taken before on_enter, which may itself handle or raise events */
+	uint8_t event = k_current_get() == &m_work_q.thread ? m_trace_event
+							     : HIO_LTE_TRACE_EVENT_NONE;
+	int ret = 0;
+
 	if (next_desc->on_enter) {
-		int ret = next_desc->on_enter();
-		if (ret < 0) {
-			LOG_WRN("failed to enter state error: %i", ret);
-			if (next_desc->state != FSM_STATE_ERROR) {
-				delegate_event(HIO_LTE_FSM_EVENT_ERROR);
-			}
-			return;
+		ret = next_desc->on_enter();
+	}
+
+	hio_lte_trace_transition(from, next_desc->state, event, ret);
+
+	if (ret < 0) {
+		LOG_WRN("failed to enter state error: %i", ret);
+		if (next_desc->state != FSM_STATE_ERROR) {
+			delegate_event(HIO_LTE_FSM_EVENT_ERROR);
 		}
 	}
 }
@@ -412,15 +503,37 @@ static void timeout_work_handler(struct k_work *item)
 
 static void event_dispatch_work_handler(struct k_work *item)
 {
-	uint8_t events[sizeof(m_event_buf)];
-	uint8_t events_cnt;
+	struct hio_lte_evq_item ev;
 
-	k_mutex_lock(&m_event_rb_lock, K_FOREVER);
-	events_cnt = (uint8_t)ring_buf_get(&m_event_rb, events, ARRAY_SIZE(events));
-	k_mutex_unlock(&m_event_rb_lock);
+	while (!hio_lte_evq_get(&ev)) {
+		/* Publish the data the event was raised with before the FSM sees it */
+		switch (ev.event) {
+		case HIO_LTE_FSM_EVENT_REGISTERED:
+		case HIO_LTE_FSM_EVENT_DEREGISTERED:
+			if (ev.cereg.valid) {
+				hio_lte_state_set_cereg_param(&ev.cereg);
+			}
+			if (ev.cereg.valid && ev.event == HIO_LTE_FSM_EVENT_REGISTERED) {
+				hio_lte_psm_set_granted(ev.cereg.active_time,
+							ev.cereg.periodic_tau_ext);
+			}
+			break;
+		case HIO_LTE_FSM_EVENT_RAI:
+			hio_lte_state_set_rai_param(&ev.rai);
+			/* No state reacts to RAI */
+			continue;
+		case HIO_LTE_FSM_EVENT_NCELLMEAS: {
+			static struct hio_lte_ncellmeas_param ncellmeas;
+
+			hio_lte_evq_get_ncellmeas(&ncellmeas);
+			hio_lte_state_set_ncellmeas_param(&ncellmeas);
+			break;
+		}
+		default:
+			break;
+		}
 
-	for (uint8_t i = 0; i < events_cnt; i++) {
-		event_handler((enum hio_lte_fsm_event)events[i]);
+		event_handler(ev.event);
 	}
 }
 
@@ -451,14 +564,25 @@ int hio_lte_update_socket_config(const struct hio_lte_socket_config *socket_conf
 	}
 
 	k_mutex_lock(&m_state_lock, K_FOREVER);
+	bool same_server = m_socket_config.dtls_enabled && socket_config->dtls_enabled &&
+			   m_socket_config.port == socket_config->port &&
+			   !strcmp(m_socket_config.addr, socket_config->addr);
 	memcpy(&m_socket_config, socket_config, sizeof(struct hio_lte_socket_config));
 	enum fsm_state current = m_state;
+
+	/* Together with the config, so that a concurrent update cannot leave the
+	 * flags of the other server */
+	if (same_server) {
+		atomic_set_bit(&m_flag, FLAG_RECONFIG_KEEP_DTLS);
+	} else {
+		atomic_clear_bit(&m_flag, FLAG_RECONFIG_KEEP_DTLS);
+		/* Saved DTLS session belongs to the old server; force a full
+		 * handshake with the new one. */
+		atomic_clear_bit(&m_flag, FLAG_DTLS_SAVED);
+	}
 	k_mutex_unlock(&m_state_lock);
 
 	atomic_set_bit(&m_flag, FLAG_SOCKET_RECONFIG);
-	/* Saved DTLS session belongs to the old server; force a full handshake
-	 * with the new one. */
-	atomic_clear_bit(&m_flag, FLAG_DTLS_SAVED);
 
 	if (current == FSM_STATE_DISABLED) {
 		/* Not connected yet: the stored config is picked up on next enable. */
@@ -490,9 +614,7 @@ int hio_lte_reconnect(void)
 
 	k_work_cancel(&m_event_dispatch_work);
 
-	k_mutex_lock(&m_event_rb_lock, K_FOREVER);
-	ring_buf_reset(&m_event_rb);
-	k_mutex_unlock(&m_event_rb_lock);
+	hio_lte_evq_flush();
 
 	transition_state(FSM_STATE_DISABLED);
 
@@ -578,19 +700,304 @@ int hio_lte_get_ceer(char **ceer)
 	return hio_lte_state_get_ceer(ceer);
 }
 
-int hio_lte_send_recv(const struct hio_lte_send_recv_param *param)
+static void batch_load(size_t index)
+{
+	m_batch_index = index;
+	m_send_recv_param = &m_batch[index];
+	m_send_attempt = 0;
+}
+
+/* Called on the LTE thread when the current datagram is through; false when it
+ * was the last one */
+static bool batch_next(void)
+{
+	m_batch_done++;
+
+	if (m_batch_index + 1 >= m_batch_count) {
+		return false;
+	}
+
+	batch_load(m_batch_index + 1);
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	m_metrics.uplink_batched++;
+	k_mutex_unlock(&m_metrics_lock);
+
+	return true;
+}
+
+static bool is_socket_valid(int socket)
+{
+	if (socket == HIO_LTE_SOCKET_DEFAULT) {
+		return true;
+	}
+
+	if (socket < 0 || socket >= CONFIG_HIO_LTE_SOCKETS_MAX) {
+		return false;
+	}
+
+	k_mutex_lock(&m_socket_lock, K_FOREVER);
+	bool used = m_added_sockets[socket];
+	k_mutex_unlock(&m_socket_lock);
+
+	return used;
+}
+
+/* Called on the LTE thread: account how a DTLS connection came up */
+static void record_handshake(const struct hio_lte_flow_handshake *handshake)
+{
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+
+	if (handshake->load_failed) {
+		m_metrics.dtls_load_failures++;
+	}
+
+	switch (handshake->type) {
+	case HIO_LTE_FLOW_HANDSHAKE_RESTORED:
+		m_metrics.dtls_restored++;
+		break;
+	case HIO_LTE_FLOW_HANDSHAKE_RESUMED:
+		m_metrics.dtls_resumed_handshakes++;
+		m_metrics.dtls_handshake_bytes += CONFIG_HIO_LTE_DTLS_RESUMED_HANDSHAKE_BYTES;
+		hio_lte_hist_add(&m_metrics.dtls_handshake_hist, handshake->duration_ms);
+		break;
+	case HIO_LTE_FLOW_HANDSHAKE_FULL:
+		m_metrics.dtls_full_handshakes++;
+		m_metrics.dtls_handshake_bytes += CONFIG_HIO_LTE_DTLS_FULL_HANDSHAKE_BYTES;
+		hio_lte_hist_add(&m_metrics.dtls_handshake_hist, handshake->duration_ms);
+		break;
+	default:
+		break;
+	}
+
+	k_mutex_unlock(&m_metrics_lock);
+}
+
+/* Called on the LTE thread: save the DTLS connection of the default socket, to
+ * be loaded back on the wake up or by the next open */
+/* @p settle as in hio_lte_flow_close_socket */
+static int save_dtls_session(bool settle)
+{
+	if (!m_socket_config.dtls_enabled || atomic_test_bit(&m_flag, FLAG_DTLS_SAVED) ||
+	    !hio_lte_flow_is_socket_open(HIO_LTE_SOCKET_DEFAULT)) {
+		return 0;
+	}
+
+	int ret = hio_lte_flow_close_socket(true, settle);
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	if (ret) {
+		m_metrics.dtls_save_failures++;
+	} else {
+		m_metrics.dtls_saves++;
+	}
+	k_mutex_unlock(&m_metrics_lock);
+
+	if (ret) {
+		LOG_WRN("Call `hio_lte_flow_close_socket` failed: %d", ret);
+		return ret;
+	}
+
+	atomic_set_bit(&m_flag, FLAG_DTLS_SAVED);
+
+	return 0;
+}
+
+/* Called on the LTE thread: load the connection saved on the PSM entry back
+ * into the default socket; on failure the socket has to be reopened */
+static int resume_dtls_session(void)
+{
+	int ret = hio_lte_flow_load_dtls_session();
+	if (ret == -EALREADY || ret == -ENOTCONN) {
+		return 0;
+	}
+
+	struct hio_lte_flow_handshake handshake = {
+		.type = ret ? HIO_LTE_FLOW_HANDSHAKE_NONE : HIO_LTE_FLOW_HANDSHAKE_RESTORED,
+		.load_failed = ret != 0,
+	};
+
+	record_handshake(&handshake);
+
+	/* Loaded, or unusable for the next open either */
+	atomic_clear_bit(&m_flag, FLAG_DTLS_SAVED);
+
+	if (ret) {
+		LOG_WRN("Call `hio_lte_flow_load_dtls_session` failed: %d", ret);
+		return ret;
+	}
+
+	return 0;
+}
+
+/* Called on the LTE thread: an added socket is opened with the default one, or
+ * here before its first send when it was added later */
+static int open_added_socket(int socket)
+{
+	int ret = 0;
+
+	if (socket == HIO_LTE_SOCKET_DEFAULT) {
+		return 0;
+	}
+
+	k_mutex_lock(&m_socket_lock, K_FOREVER);
+
+	if (!m_added_sockets[socket]) {
+		ret = -EBADF;
+	} else if (!hio_lte_flow_is_socket_open(socket)) {
+		struct hio_lte_flow_handshake handshake;
+
+		ret = hio_lte_flow_open_socket(socket, &m_added_socket_configs[socket], false,
+					       &handshake);
+		if (!ret) {
+			record_handshake(&handshake);
+		}
+	}
+
+	k_mutex_unlock(&m_socket_lock);
+
+	return ret;
+}
+
+/* The check may close a broken added socket */
+static int flow_check(void)
+{
+	k_mutex_lock(&m_socket_lock, K_FOREVER);
+	int ret = hio_lte_flow_check();
+	k_mutex_unlock(&m_socket_lock);
+
+	return ret;
+}
+
+static void open_added_sockets(void)
+{
+	k_mutex_lock(&m_socket_lock, K_FOREVER);
+
+	for (int i = HIO_LTE_SOCKET_DEFAULT + 1; i < CONFIG_HIO_LTE_SOCKETS_MAX; i++) {
+		if (!m_added_sockets[i]) {
+			continue;
+		}
+
+		/* Retried before its next send; the default socket is usable */
+		struct hio_lte_flow_handshake handshake;
+		int ret = hio_lte_flow_open_socket(i, &m_added_socket_configs[i], false, &handshake);
+		if (ret) {
+			LOG_WRN("Call `hio_lte_flow_open_socket` failed: %d (socket %d)", ret, i);
+		} else {
+			record_handshake(&handshake);
+		}
+	}
+
+	k_mutex_unlock(&m_socket_lock);
+}
+
+int hio_lte_add_socket(const struct hio_lte_socket_config *socket_config, int *socket)
+{
+	if (!socket_config || !socket) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_socket_lock, K_FOREVER);
+
+	for (int i = HIO_LTE_SOCKET_DEFAULT + 1; i < CONFIG_HIO_LTE_SOCKETS_MAX; i++) {
+		if (m_added_sockets[i]) {
+			continue;
+		}
+
+		memcpy(&m_added_socket_configs[i], socket_config, sizeof(*socket_config));
+		m_added_sockets[i] = true;
+		k_mutex_unlock(&m_socket_lock);
+
+		*socket = i;
+
+		return 0;
+	}
+
+	k_mutex_unlock(&m_socket_lock);
+
+	return -ENOSPC;
+}
+
+int hio_lte_remove_socket(int socket)
+{
+	if (socket <= HIO_LTE_SOCKET_DEFAULT || socket >= CONFIG_HIO_LTE_SOCKETS_MAX) {
+		return -EINVAL;
+	}
+
+	/* No transaction uses the socket while it is closed */
+	k_mutex_lock(&m_send_recv_lock, K_FOREVER);
+	k_mutex_lock(&m_socket_lock, K_FOREVER);
+
+	int ret = m_added_sockets[socket] ? hio_lte_flow_remove_socket(socket) : -EINVAL;
+	m_added_sockets[socket] = false;
+
+	k_mutex_unlock(&m_socket_lock);
+	k_mutex_unlock(&m_send_recv_lock);
+
+	return ret;
+}
+
+static void record_txn(int result)
+{
+	struct hio_lte_cereg_param cereg;
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	m_txn.result = result;
+	struct hio_lte_metrics_txn txn = m_txn;
+	uint32_t id = m_txn_id;
+	k_mutex_unlock(&m_metrics_lock);
+
+	if (!hio_lte_state_get_cereg_param(&cereg) && cereg.valid) {
+		txn.eci = cereg.cid;
+	} else {
+		txn.eci = HIO_LTE_CELL_ECI_INVALID;
+	}
+
+	hio_lte_txn_record(id, &txn);
+}
+
+static int transact(const struct hio_lte_send_recv_param *params, size_t count, size_t *done,
+		    k_timeout_t timeout)
 {
-	LOG_INF("send_len: %u", param->send_len);
+	LOG_INF("count: %u, send_len: %u", count, params[0].send_len);
 
-	k_timepoint_t end = sys_timepoint_calc(param->timeout);
+	for (size_t i = 0; i < count; i++) {
+		if (!is_socket_valid(params[i].socket)) {
+			return -EINVAL;
+		}
+	}
 
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	atomic_inc(&m_send_recv_waiting);
 	k_mutex_lock(&m_send_recv_lock, sys_timepoint_timeout(end));
+	atomic_dec(&m_send_recv_waiting);
 
 	LOG_DBG("locked");
 
-	m_send_recv_param = (struct hio_lte_send_recv_param *)param;
+	hio_lte_psm_record(k_uptime_get(), params[count - 1].recv_buf != NULL);
+
+	memcpy(m_batch, params, count * sizeof(params[0]));
+	m_batch_count = count;
+	m_batch_done = 0;
+
+	/* Keep the RRC connection up for the datagrams that follow */
+	for (size_t i = 0; i + 1 < count; i++) {
+		m_batch[i].rai = false;
+	}
+
+	batch_load(0);
 	m_send_recv_result = 0;
-	m_send_attempt = 0;
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	memset(&m_txn, 0, sizeof(m_txn));
+	m_txn_id = hio_lte_txn_begin();
+	m_txn.timestamp = k_uptime_get_32();
+	m_txn.datagrams = count;
+	for (size_t i = 0; i < count; i++) {
+		m_txn.send_len = MIN(m_txn.send_len + params[i].send_len, UINT16_MAX);
+	}
+	k_mutex_unlock(&m_metrics_lock);
 
 	k_event_clear(&m_states_event, SEND_RECV_BIT);
 
@@ -600,7 +1007,12 @@ int hio_lte_send_recv(const struct hio_lte_send_recv_param *param)
 
 	k_event_wait(&m_states_event, SEND_RECV_BIT, false, sys_timepoint_timeout(end));
 
+	if (done) {
+		*done = m_batch_done;
+	}
+
 	if (sys_timepoint_expired(end)) {
+		record_txn(-ETIMEDOUT);
 		k_mutex_unlock(&m_send_recv_lock);
 		delegate_event(HIO_LTE_FSM_EVENT_TIMEOUT);
 		return -ETIMEDOUT;
@@ -608,6 +1020,8 @@ int hio_lte_send_recv(const struct hio_lte_send_recv_param *param)
 
 	int result = m_send_recv_result;
 
+	record_txn(result);
+
 	k_mutex_unlock(&m_send_recv_lock);
 
 	LOG_DBG("unlock");
@@ -615,6 +1029,95 @@ int hio_lte_send_recv(const struct hio_lte_send_recv_param *param)
 	return result;
 }
 
+int hio_lte_send_recv(const struct hio_lte_send_recv_param *param)
+{
+	return transact(param, 1, NULL, param->timeout);
+}
+
+int hio_lte_send_recv_batch(const struct hio_lte_send_recv_param *params, size_t count,
+			    size_t *done, k_timeout_t timeout)
+{
+	if (done) {
+		*done = 0;
+	}
+
+	if (!params || !count || count > ARRAY_SIZE(m_batch)) {
+		return -EINVAL;
+	}
+
+	/* Only the last datagram may wait for a reply */
+	for (size_t i = 0; i + 1 < count; i++) {
+		if (params[i].recv_buf) {
+			return -EINVAL;
+		}
+	}
+
+	return transact(params, count, done, timeout);
+}
+
+/* Ask the FSM for a connection evaluation; it is run from READY, so a sleeping
+ * modem is woken up as for NCELLMEAS */
+static void request_coneval(void)
+{
+	atomic_set_bit(&m_flag, FLAG_CONEVAL_REQ);
+
+	k_mutex_lock(&m_state_lock, K_FOREVER);
+	enum fsm_state current = m_state;
+	k_mutex_unlock(&m_state_lock);
+
+	if (current == FSM_STATE_SLEEP || current == FSM_STATE_READY) {
+		delegate_event(HIO_LTE_FSM_EVENT_READY);
+	}
+}
+
+int hio_lte_send_recv_deferred(const struct hio_lte_send_recv_param *param, k_timeout_t deadline)
+{
+	if (!param) {
+		return -EINVAL;
+	}
+
+	k_timepoint_t end = sys_timepoint_calc(deadline);
+	k_timeout_t interval = K_SECONDS(CONFIG_HIO_LTE_DEFER_EVAL_INTERVAL);
+
+	while (!sys_timepoint_expired(end)) {
+		/* Nothing to evaluate without a connection or with the modem off;
+		 * the send itself has to bring it up */
+		if (!k_event_test(&m_states_event, CONNECTED_BIT) ||
+		    atomic_test_bit(&m_flag, FLAG_CFUN4)) {
+			return hio_lte_send_recv(param);
+		}
+
+		/* Cleared before deciding: a result stored in between is seen
+		 * by the decision, one stored later ends the wait */
+		k_event_clear(&m_states_event, CONEVAL_BIT);
+
+		enum hio_lte_defer_action action = hio_lte_defer_decide(k_uptime_get());
+
+		if (action == HIO_LTE_DEFER_ACTION_SEND) {
+			LOG_INF("Radio conditions good, sending");
+			hio_lte_defer_release(false);
+			return hio_lte_send_recv(param);
+		}
+
+		if (action == HIO_LTE_DEFER_ACTION_EVALUATE) {
+			request_coneval();
+		}
+
+		k_timeout_t remaining = sys_timepoint_timeout(end);
+		k_timeout_t wait = K_TIMEOUT_EQ(remaining, K_FOREVER) ||
+						   remaining.ticks > interval.ticks
+					   ? interval
+					   : remaining;
+
+		k_event_wait(&m_states_event, CONEVAL_BIT, false, wait);
+	}
+
+	LOG_INF("Deadline reached, sending");
+	hio_lte_defer_release(true);
+
+	return hio_lte_send_recv(param);
+}
+
 int hio_lte_get_conn_param(struct hio_lte_conn_param *param)
 {
 	return hio_lte_state_get_conn_param(param);
@@ -625,6 +1128,49 @@ int hio_lte_get_cereg_param(struct hio_lte_cereg_param *param)
 	return hio_lte_state_get_cereg_param(param);
 }
 
+int hio_lte_get_psm_info(struct hio_lte_psm_info *info)
+{
+	if (!info) {
+		return -EINVAL;
+	}
+
+	struct hio_lte_psm_request req;
+
+	hio_lte_psm_get_applied(&req);
+	info->interval_s = hio_lte_psm_get_interval();
+	info->tau_requested_s = req.tau_s;
+	info->active_requested_s = req.active_s;
+	hio_lte_psm_get_granted(&info->active_granted_s, &info->tau_granted_s);
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	uint32_t connected_ms =
+		m_metrics.uplink_count ? m_metrics.cscon_1_duration_ms / m_metrics.uplink_count : 0;
+	k_mutex_unlock(&m_metrics_lock);
+
+	info->sleep_predicted_permille = hio_lte_psm_predict_sleep(connected_ms);
+
+	uint64_t total_ms = 0;
+	uint64_t sleep_ms = 0;
+
+	for (uint8_t state = 0; state <= FSM_STATE_GNSS; state++) {
+		struct hio_lte_trace_dwell dwell;
+
+		if (hio_lte_trace_get_dwell(state, &dwell)) {
+			continue;
+		}
+
+		total_ms += dwell.total_ms;
+
+		if (state == FSM_STATE_SLEEP) {
+			sleep_ms = dwell.total_ms;
+		}
+	}
+
+	info->sleep_observed_permille = total_ms ? (int)(sleep_ms * 1000 / total_ms) : -1;
+
+	return 0;
+}
+
 int hio_lte_get_metrics(struct hio_lte_metrics *metrics)
 {
 	if (!metrics) {
@@ -633,9 +1179,40 @@ int hio_lte_get_metrics(struct hio_lte_metrics *metrics)
 	k_mutex_lock(&m_metrics_lock, K_FOREVER);
 	memcpy(metrics, &m_metrics, sizeof(struct hio_lte_metrics));
 	k_mutex_unlock(&m_metrics_lock);
+
+	metrics->txn_count = hio_lte_txn_get_total();
+
+	struct hio_lte_evq_stats stats;
+
+	hio_lte_evq_get_stats(&stats);
+	metrics->event_count = stats.posted;
+	metrics->event_dropped = stats.dropped;
+	metrics->event_coalesced = stats.coalesced;
+	metrics->event_max_depth = stats.max_depth;
+
+	struct hio_lte_defer_stats defer_stats;
+
+	hio_lte_defer_get_stats(&defer_stats);
+	metrics->defer_evaluations = defer_stats.evaluations;
+	metrics->defer_sent_good = defer_stats.sent_good;
+	metrics->defer_sent_deadline = defer_stats.sent_deadline;
+
+	/* The technologies come first */
+	struct hio_lte_rtt_entry rtt;
+
+	metrics->recv_timeout_ltem_ms = hio_lte_rtt_get(0, &rtt) ? 0 : rtt.timeout_ms;
+	metrics->recv_timeout_nbiot_ms = hio_lte_rtt_get(1, &rtt) ? 0 : rtt.timeout_ms;
+
+	metrics->gnss_blocked = hio_lte_gnss_get_blocked();
+
 	return 0;
 }
 
+int hio_lte_get_metrics_txn(int index, struct hio_lte_metrics_txn *txn)
+{
+	return hio_lte_txn_get(index, txn);
+}
+
 int hio_lte_get_fsm_state(const char **state)
 {
 	if (!state) {
@@ -647,58 +1224,167 @@ int hio_lte_get_fsm_state(const char **state)
 	return 0;
 }
 
-int hio_lte_add_callback(struct hio_lte_cb *cb)
-{
-	if (!cb || !cb->handler) {
-		return -EINVAL;
-	}
+int hio_lte_add_callback(struct hio_lte_cb *cb)
+{
+	if (!cb || !cb->handler) {
+		return -EINVAL;
+	}
+
+	struct hio_lte_cb *iter;
+	SYS_SLIST_FOR_EACH_CONTAINER(&cb_list, iter, node) {
+		if (iter == cb) {
+			return -EALREADY;
+		}
+	}
+
+	sys_slist_append(&cb_list, &cb->node);
+	return 0;
+}
+
+int hio_lte_remove_callback(struct hio_lte_cb *cb)
+{
+	if (!cb) {
+		return -EINVAL;
+	}
+
+	bool removed = sys_slist_find_and_remove(&cb_list, &cb->node);
+	return removed ? 0 : -ENOENT;
+}
+
+int hio_lte_get_ncellmeas_param(struct hio_lte_ncellmeas_param *param)
+{
+	return hio_lte_state_get_ncellmeas_param(param);
+}
+
+int hio_lte_schedule_ncellmeas(void)
+{
+	if (g_hio_lte_config.test) {
+		LOG_WRN("LTE Test mode enabled");
+		return -ENOTSUP;
+	}
+
+	if (atomic_test_and_set_bit(&m_flag, FLAG_NCELLMEAS_REQ)) {
+		return -EALREADY;
+	}
+
+	k_mutex_lock(&m_state_lock, K_FOREVER);
+	enum fsm_state current = m_state;
+	k_mutex_unlock(&m_state_lock);
+
+	if (current == FSM_STATE_SLEEP) {
+		delegate_event(HIO_LTE_FSM_EVENT_READY);
+	}
+
+	return 0;
+}
+
+int hio_lte_gnss_get_fix(struct hio_lte_gnss_fix *fix, k_timeout_t timeout)
+{
+	if (!fix) {
+		return -EINVAL;
+	}
+
+	if (!IS_ENABLED(CONFIG_HIO_LTE_GNSS)) {
+		return -ENOTSUP;
+	}
+
+	if (g_hio_lte_config.test) {
+		LOG_WRN("LTE Test mode enabled");
+		return -ENOTSUP;
+	}
+
+	if (k_mutex_lock(&m_gnss_lock, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	k_mutex_lock(&m_state_lock, K_FOREVER);
+	enum fsm_state current = m_state;
+	k_mutex_unlock(&m_state_lock);
+
+	if (current == FSM_STATE_DISABLED) {
+		k_mutex_unlock(&m_gnss_lock);
+		return -ENODEV;
+	}
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	m_metrics.gnss_requests++;
+	k_mutex_unlock(&m_metrics_lock);
+
+	m_gnss_end = sys_timepoint_calc(timeout);
+	m_gnss_result = -EINPROGRESS;
+	m_gnss_search_ms = 0;
+	m_gnss_started = false;
+
+	k_event_clear(&m_states_event, GNSS_BIT);
+	atomic_set_bit(&m_flag, FLAG_GNSS_ENABLE);
+
+	delegate_event(HIO_LTE_FSM_EVENT_XGPS_ENABLE);
 
-	struct hio_lte_cb *iter;
-	SYS_SLIST_FOR_EACH_CONTAINER(&cb_list, iter, node) {
-		if (iter == cb) {
-			return -EALREADY;
-		}
-	}
+	if (!k_event_wait(&m_states_event, GNSS_BIT, false, timeout) &&
+	    atomic_test_and_clear_bit(&m_flag, FLAG_GNSS_ENABLE)) {
+		/* Stop a search in progress; the LTE thread ends the request by
+		 * posting GNSS_BIT before it clears the flag */
+		delegate_event(HIO_LTE_FSM_EVENT_XGPS_DISABLE);
 
-	sys_slist_append(&cb_list, &cb->node);
-	return 0;
-}
+		k_mutex_lock(&m_metrics_lock, K_FOREVER);
+		m_metrics.gnss_timeouts++;
+		k_mutex_unlock(&m_metrics_lock);
 
-int hio_lte_remove_callback(struct hio_lte_cb *cb)
-{
-	if (!cb) {
-		return -EINVAL;
+		k_mutex_unlock(&m_gnss_lock);
+		return -ETIMEDOUT;
 	}
 
-	bool removed = sys_slist_find_and_remove(&cb_list, &cb->node);
-	return removed ? 0 : -ENOENT;
+	int result = m_gnss_result;
+	if (!result) {
+		memcpy(fix, &m_gnss_fix, sizeof(*fix));
+	}
+
+	k_mutex_unlock(&m_gnss_lock);
+
+	return result;
 }
 
-int hio_lte_get_ncellmeas_param(struct hio_lte_ncellmeas_param *param)
+/* Called on the LTE thread: a search may start while no transaction runs or
+ * waits and the radio is idle */
+static bool gnss_can_start(void)
 {
-	return hio_lte_state_get_ncellmeas_param(param);
+	return atomic_test_bit(&m_flag, FLAG_GNSS_ENABLE) && !m_send_recv_param &&
+	       !atomic_get(&m_send_recv_waiting) && !atomic_test_bit(&m_flag, FLAG_CSCON);
 }
 
-int hio_lte_schedule_ncellmeas(void)
+/* Called on the LTE thread: end the request of hio_lte_gnss_get_fix unless
+ * its caller has given up on it. The fix is in m_gnss_fix on success */
+static void gnss_finish(int result)
 {
-	if (g_hio_lte_config.test) {
-		LOG_WRN("LTE Test mode enabled");
-		return -ENOTSUP;
+	if (!atomic_test_bit(&m_flag, FLAG_GNSS_ENABLE)) {
+		return;
 	}
 
-	if (atomic_test_and_set_bit(&m_flag, FLAG_NCELLMEAS_REQ)) {
-		return -EALREADY;
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	if (!result) {
+		m_gnss_fix.ttff_ms = m_gnss_search_ms;
+		m_gnss_fix.hot = m_gnss_hot;
+		m_metrics.gnss_fixes++;
+		hio_lte_hist_add(m_gnss_hot ? &m_metrics.gnss_ttff_hot_hist
+					    : &m_metrics.gnss_ttff_cold_hist,
+				 m_gnss_search_ms);
+	} else if (result == -ETIMEDOUT) {
+		m_metrics.gnss_timeouts++;
+	} else {
+		m_metrics.gnss_errors++;
 	}
+	k_mutex_unlock(&m_metrics_lock);
 
-	k_mutex_lock(&m_state_lock, K_FOREVER);
-	enum fsm_state current = m_state;
-	k_mutex_unlock(&m_state_lock);
-
-	if (current == FSM_STATE_SLEEP) {
-		delegate_event(HIO_LTE_FSM_EVENT_READY);
+	if (!result) {
+		LOG_INF("GNSS fix in %u ms (%s start)", m_gnss_search_ms,
+			m_gnss_hot ? "hot" : "cold");
+	} else {
+		LOG_WRN("GNSS request ended without a fix: %d", result);
 	}
 
-	return 0;
+	m_gnss_result = result;
+	k_event_post(&m_states_event, GNSS_BIT);
+	atomic_clear_bit(&m_flag, FLAG_GNSS_ENABLE);
 }
 
 /* End any in-flight hio_lte_send_recv transaction towards its caller with the
@@ -720,6 +1406,7 @@ static int on_enter_disabled(void)
 	/* The modem is being shut down, so any pending transaction can no longer
 	 * complete. Covers every path into DISABLED (explicit disable, reconnect). */
 	abort_pending_send_recv(-ENOTCONN);
+	gnss_finish(-ENODEV);
 
 	ret = hio_lte_flow_stop();
 	if (ret < 0) {
@@ -789,7 +1476,7 @@ static int on_enter_error(void)
 {
 	m_error_ctx.on_timeout_state = FSM_STATE_PREPARE; /* Default timeout state */
 
-	int ret = hio_lte_flow_check();
+	int ret = flow_check();
 	if (ret == 0) {
 		m_error_ctx.flow_check_failures = 0;
 
@@ -1068,6 +1755,14 @@ static int on_enter_attach(void)
 
 	struct hio_lte_attach_timeout timeout = get_attach_timeout(m_attach_retry_count);
 
+	/* The last-good cell either answers quickly or not at all */
+	k_timeout_t hint_timeout = K_SECONDS(CONFIG_HIO_LTE_ATTACH_HINT_TIMEOUT);
+	if (hio_lte_hint_is_applied() &&
+	    (K_TIMEOUT_EQ(timeout.attach_timeout, K_FOREVER) ||
+	     hint_timeout.ticks < timeout.attach_timeout.ticks)) {
+		timeout.attach_timeout = hint_timeout;
+	}
+
 	LOG_INF("Try to attach with timeout %lld s",
 		k_ticks_to_ms_floor64(timeout.attach_timeout.ticks) / MSEC_PER_SEC);
 
@@ -1084,7 +1779,27 @@ static int attach_event_handler(enum hio_lte_fsm_event event)
 		k_mutex_lock(&m_metrics_lock, K_FOREVER);
 		m_metrics.attach_last_duration_ms = k_uptime_get_32() - m_start;
 		m_metrics.attach_duration_ms += m_metrics.attach_last_duration_ms;
+		hio_lte_hist_add(&m_metrics.attach_hist,
+				 m_metrics.attach_last_duration_ms + m_hint_lost_ms);
+		if (hio_lte_hint_is_applied()) {
+			m_metrics.attach_hint_count++;
+			m_metrics.attach_hint_duration_ms += m_metrics.attach_last_duration_ms;
+		} else {
+			m_metrics.attach_full_count++;
+			m_metrics.attach_full_duration_ms +=
+				m_metrics.attach_last_duration_ms + m_hint_lost_ms;
+		}
+		m_hint_lost_ms = 0;
 		k_mutex_unlock(&m_metrics_lock);
+		if (hio_lte_hint_is_applied()) {
+			/* Registered; let the modem reselect across all the bands
+			 * again. A failed hinted attach restores them by the
+			 * prepare that follows. */
+			int ret = hio_lte_flow_restore_bands();
+			if (ret) {
+				LOG_WRN("Call `hio_lte_flow_restore_bands` failed: %d", ret);
+			}
+		}
 		k_event_post(&m_states_event, ATTACHED_BIT);
 		transition_state(FSM_STATE_OPEN_SOCKET);
 		break;
@@ -1092,10 +1807,21 @@ static int attach_event_handler(enum hio_lte_fsm_event event)
 		transition_state(FSM_STATE_RESET_LOOP);
 		break;
 	case HIO_LTE_FSM_EVENT_TIMEOUT:
+		if (hio_lte_hint_is_applied()) {
+			/* Not an attach failure yet: prepare again without the hint */
+			hio_lte_hint_reject();
+			k_mutex_lock(&m_metrics_lock, K_FOREVER);
+			m_metrics.attach_hint_fallback_count++;
+			m_hint_lost_ms += k_uptime_get_32() - m_start;
+			k_mutex_unlock(&m_metrics_lock);
+			transition_state(FSM_STATE_PREPARE);
+			break;
+		}
 		k_mutex_lock(&m_metrics_lock, K_FOREVER);
 		m_metrics.attach_fail_count++;
 		m_metrics.attach_last_duration_ms = k_uptime_get_32() - m_start;
 		m_metrics.attach_duration_ms += m_metrics.attach_last_duration_ms;
+		m_hint_lost_ms = 0;
 		k_mutex_unlock(&m_metrics_lock);
 		transition_state(FSM_STATE_RETRY_DELAY);
 		break;
@@ -1142,12 +1868,18 @@ static int on_enter_open_socket(void)
 
 	bool dtls_saved = atomic_test_and_clear_bit(&m_flag, FLAG_DTLS_SAVED);
 
-	int ret = hio_lte_flow_open_socket(&socket_config, dtls_saved);
+	struct hio_lte_flow_handshake handshake;
+	int ret = hio_lte_flow_open_socket(HIO_LTE_SOCKET_DEFAULT, &socket_config, dtls_saved,
+					   &handshake);
 	if (ret < 0) {
 		LOG_ERR("Call `hio_lte_flow_open_socket` failed: %d", ret);
 		return ret;
 	}
 
+	record_handshake(&handshake);
+
+	open_added_sockets();
+
 	delegate_event(HIO_LTE_FSM_EVENT_SOCKET_OPENED);
 
 	return 0;
@@ -1176,12 +1908,20 @@ static int open_socket_event_handler(enum hio_lte_fsm_event event)
 }
 
 /* Close the current socket and reopen it on the (already updated) socket
- * config. The old server's DTLS session must not be saved or reused, so pass
- * false — this also skips the 1 s CONN_SAVE delay. Caller has already cleared
+ * config. A new server's DTLS session must not be saved or reused, so pass
+ * false — this also skips the 1 s CONN_SAVE delay; for the same server the
+ * session is saved and loaded into the new socket. Caller has already cleared
  * FLAG_SOCKET_RECONFIG. */
 static int reopen_socket_on_reconfig(void)
 {
-	int ret = hio_lte_flow_close_socket(false);
+	int ret;
+
+	if (IS_ENABLED(CONFIG_HIO_LTE_DTLS_SESSION_SAVE) &&
+	    atomic_test_and_clear_bit(&m_flag, FLAG_RECONFIG_KEEP_DTLS)) {
+		ret = save_dtls_session(true);
+	} else {
+		ret = hio_lte_flow_close_socket(false, false);
+	}
 	if (ret < 0) {
 		LOG_ERR("Call `hio_lte_flow_close_socket` failed: %d", ret);
 	}
@@ -1204,6 +1944,10 @@ static int on_enter_ready(void)
 
 	if (m_send_recv_param) {
 		delegate_event(HIO_LTE_FSM_EVENT_SEND);
+	} else if (atomic_test_bit(&m_flag, FLAG_CONEVAL_REQ)) {
+		delegate_event(HIO_LTE_FSM_EVENT_READY);
+	} else if (atomic_test_bit(&m_flag, FLAG_GNSS_ENABLE)) {
+		delegate_event(HIO_LTE_FSM_EVENT_XGPS_ENABLE);
 	}
 
 	start_timer(K_MSEC(500));
@@ -1225,12 +1969,18 @@ static int ready_event_handler(enum hio_lte_fsm_event event)
 			return 0; /* ignore SEND event */
 		}
 		stop_timer();
-		int ret = hio_lte_flow_check();
+		int ret = flow_check();
 		if (ret < 0) {
 			return ret;
 		}
 		transition_state(FSM_STATE_SEND);
 		break;
+	case HIO_LTE_FSM_EVENT_READY:
+		if (atomic_test_and_clear_bit(&m_flag, FLAG_CONEVAL_REQ)) {
+			stop_timer();
+			transition_state(FSM_STATE_CONEVAL);
+		}
+		break;
 	case HIO_LTE_FSM_EVENT_DEREGISTERED:
 		if (atomic_test_bit(&m_flag, FLAG_CFUN4)) {
 			return 0; /* ignore DEREGISTERED event */
@@ -1240,6 +1990,16 @@ static int ready_event_handler(enum hio_lte_fsm_event event)
 	case HIO_LTE_FSM_EVENT_CSCON_0:
 		if (atomic_test_bit(&m_flag, FLAG_NCELLMEAS_REQ)) {
 			transition_state(FSM_STATE_NCELLMEAS);
+		} else if (gnss_can_start()) {
+			m_gnss_return_state = FSM_STATE_READY;
+			transition_state(FSM_STATE_GNSS);
+		}
+		break;
+	case HIO_LTE_FSM_EVENT_XGPS_ENABLE:
+		/* Otherwise started on CSCON_0 or in SLEEP */
+		if (gnss_can_start()) {
+			m_gnss_return_state = FSM_STATE_READY;
+			transition_state(FSM_STATE_GNSS);
 		}
 		break;
 	case HIO_LTE_FSM_EVENT_XMODEMSLEEP:
@@ -1255,14 +2015,17 @@ static int ready_event_handler(enum hio_lte_fsm_event event)
 		if (atomic_test_bit(&m_flag, FLAG_NCELLMEAS_REQ)) {
 			return 0; /* ignore TIMEOUT event, wait for CSCON_0 */
 		}
+		if (hio_lte_psm_is_update_pending()) {
+			int ret = hio_lte_flow_psm_update();
+			if (ret) {
+				LOG_WRN("Call `hio_lte_flow_psm_update` failed: %d", ret);
+			}
+		}
 		hio_lte_state_get_cereg_param(&m_cereg_param);
 		if (m_cereg_param.active_time == -1) {
-			int ret = hio_lte_flow_close_socket(m_socket_config.dtls_enabled);
-			if (!ret && m_socket_config.dtls_enabled) {
-				atomic_set_bit(&m_flag, FLAG_DTLS_SAVED);
-			}
+			save_dtls_session(true);
 			LOG_WRN("PSM is not supported, disabling LTE modem to save power");
-			ret = hio_lte_flow_cfun(4);
+			int ret = hio_lte_flow_cfun(4);
 			if (ret < 0) {
 				LOG_ERR("Call `hio_lte_flow_cfun` failed: %d", ret);
 				return ret;
@@ -1284,8 +2047,16 @@ static int on_leave_ready(void)
 
 static int on_enter_sleep(void)
 {
+	/* Kept by the modem over the sleep; saved against a reattach. Nothing
+	 * uses the socket until the wake up, so no need to wait for the store */
+	if (IS_ENABLED(CONFIG_HIO_LTE_DTLS_SESSION_SAVE) && !m_send_recv_param) {
+		save_dtls_session(false);
+	}
+
 	if (m_send_recv_param) {
 		delegate_event(HIO_LTE_FSM_EVENT_SEND);
+	} else if (atomic_test_bit(&m_flag, FLAG_GNSS_ENABLE)) {
+		delegate_event(HIO_LTE_FSM_EVENT_XGPS_ENABLE);
 	}
 
 	return 0;
@@ -1307,12 +2078,23 @@ static int sleep_event_handler(enum hio_lte_fsm_event event)
 			transition_state(FSM_STATE_ATTACH);
 			return 0;
 		}
+		if (resume_dtls_session()) {
+			/* A new full handshake; the send follows from READY */
+			transition_state(FSM_STATE_OPEN_SOCKET);
+			return 0;
+		}
 		if (event == HIO_LTE_FSM_EVENT_SEND) {
 			transition_state(FSM_STATE_SEND);
 		} else {
 			transition_state(FSM_STATE_READY);
 		}
 		break;
+	case HIO_LTE_FSM_EVENT_XGPS_ENABLE:
+		if (gnss_can_start()) {
+			m_gnss_return_state = FSM_STATE_SLEEP;
+			transition_state(FSM_STATE_GNSS);
+		}
+		break;
 	case HIO_LTE_FSM_EVENT_ERROR:
 		transition_state(FSM_STATE_ERROR);
 		break;
@@ -1325,13 +2107,45 @@ static int sleep_event_handler(enum hio_lte_fsm_event event)
 	return 0;
 }
 
-static int on_enter_send(void)
+/* An added socket failing must not take the default one down with it: close
+ * it so its next send reopens it and end only this transaction */
+static void close_added_socket(int socket)
+{
+	k_mutex_lock(&m_socket_lock, K_FOREVER);
+
+	int ret = hio_lte_flow_remove_socket(socket);
+	if (ret) {
+		LOG_ERR("Call `hio_lte_flow_remove_socket` failed: %d", ret);
+	}
+
+	k_mutex_unlock(&m_socket_lock);
+}
+
+static int end_added_socket_txn(int result)
+{
+	m_send_recv_result = result;
+	m_send_recv_param = NULL;
+	k_event_post(&m_states_event, SEND_RECV_BIT);
+	delegate_event(HIO_LTE_FSM_EVENT_READY);
+
+	return 0;
+}
+
+static int send_current(void)
 {
 	int ret;
 
-	if (!m_send_recv_param) {
-		delegate_event(HIO_LTE_FSM_EVENT_READY);
-		return 0;
+	ret = open_added_socket(m_send_recv_param->socket);
+	if (ret) {
+		LOG_ERR("Call `open_added_socket` failed: %d", ret);
+		return end_added_socket_txn(ret);
+	}
+
+	/* Another transaction waits for this one: keep the RRC connection for it
+	 * instead of releasing it and setting up a new one right after */
+	if (m_send_recv_param->rai && atomic_get(&m_send_recv_waiting)) {
+		LOG_INF("Release assistance held for a waiting transaction");
+		m_send_recv_param->rai = false;
 	}
 
 	k_mutex_lock(&m_metrics_lock, K_FOREVER);
@@ -1345,6 +2159,10 @@ static int on_enter_send(void)
 
 	m_send_attempt++;
 
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	m_txn.attempts++;
+	k_mutex_unlock(&m_metrics_lock);
+
 	/* nrf_send with NRF_MSG_WAITACK blocks until the data is on-air, which
 	 * spans the whole time-to-CSCON-1 (the modem only attempts a connection
 	 * in response to a send). Bound that wait by SNDTIMEO derived from the
@@ -1357,9 +2175,13 @@ static int on_enter_send(void)
 		K_TIMEOUT_EQ(remaining, K_FOREVER) ? -1 : k_ticks_to_sec_ceil32(remaining.ticks);
 	int sndtimeo_sec = hio_lte_util_send_timeout_sec(remaining_sec);
 
-	ret = hio_lte_flow_set_sndtimeo(sndtimeo_sec);
+	ret = hio_lte_flow_set_sndtimeo(m_send_recv_param->socket, sndtimeo_sec);
 	if (ret < 0) {
 		LOG_ERR("Call `hio_lte_flow_set_sndtimeo` failed: %d", ret);
+		if (m_send_recv_param->socket != HIO_LTE_SOCKET_DEFAULT) {
+			close_added_socket(m_send_recv_param->socket);
+			return end_added_socket_txn(ret);
+		}
 		return ret;
 	}
 
@@ -1370,15 +2192,28 @@ static int on_enter_send(void)
 	 * The normal path stops this timer right after the send returns. */
 	start_timer(K_SECONDS(sndtimeo_sec + SEND_WATCHDOG_GUARD_SEC));
 
+	uint32_t send_start = k_uptime_get_32();
+
 	ret = hio_lte_flow_send(m_send_recv_param);
-	if (ret < 0) {
-		stop_timer();
-		LOG_ERR("Call `hio_lte_flow_send` failed: %d", ret);
 
-		k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	uint32_t on_air_ms = k_uptime_get_32() - send_start;
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	m_txn.on_air_ms += on_air_ms;
+	if (ret < 0) {
 		m_metrics.uplink_errors++;
-		k_mutex_unlock(&m_metrics_lock);
+	} else {
+		hio_lte_hist_add(&m_metrics.on_air_hist, on_air_ms);
+	}
+	k_mutex_unlock(&m_metrics_lock);
 
+	if (ret < 0) {
+		stop_timer();
+		LOG_ERR("Call `hio_lte_flow_send` failed: %d", ret);
+		if (m_send_recv_param->socket != HIO_LTE_SOCKET_DEFAULT) {
+			close_added_socket(m_send_recv_param->socket);
+			return end_added_socket_txn(ret);
+		}
 		return ret;
 	}
 
@@ -1394,6 +2229,22 @@ static int on_enter_send(void)
 	return 0;
 }
 
+static int on_enter_send(void)
+{
+	if (!m_send_recv_param) {
+		delegate_event(HIO_LTE_FSM_EVENT_READY);
+		return 0;
+	}
+
+	/* The caller may start the next transaction before the evaluation
+	 * that follows this one is done */
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	m_coneval_txn_id = m_txn_id;
+	k_mutex_unlock(&m_metrics_lock);
+
+	return send_current();
+}
+
 static int send_event_handler(enum hio_lte_fsm_event event)
 {
 	switch (event) {
@@ -1409,6 +2260,11 @@ static int send_event_handler(enum hio_lte_fsm_event event)
 			if (m_send_recv_param->recv_buf) {
 				transition_state(FSM_STATE_RECEIVE);
 			} else {
+				/* Next datagram right away, within the same
+				 * RRC connection */
+				if (batch_next()) {
+					return send_current();
+				}
 				if (m_send_recv_param->rai) {
 					k_sleep(K_MSEC(500));
 				}
@@ -1483,13 +2339,23 @@ static int on_enter_receive(void)
 	}
 	k_mutex_unlock(&m_metrics_lock);
 
+	uint32_t recv_start = k_uptime_get_32();
+
 	ret = hio_lte_flow_recv(m_send_recv_param);
-	if (ret < 0) {
-		LOG_ERR("Call `hio_lte_flow_recv` failed: %d", ret);
 
-		k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	uint32_t recv_ms = k_uptime_get_32() - recv_start;
+
+	k_mutex_lock(&m_metrics_lock, K_FOREVER);
+	m_txn.recv_ms = recv_ms;
+	if (ret < 0) {
 		m_metrics.downlink_errors++;
-		k_mutex_unlock(&m_metrics_lock);
+	} else {
+		hio_lte_hist_add(&m_metrics.recv_hist, recv_ms);
+	}
+	k_mutex_unlock(&m_metrics_lock);
+
+	if (ret < 0) {
+		LOG_ERR("Call `hio_lte_flow_recv` failed: %d", ret);
 
 		/* End the transaction: the reply did not arrive in the RCVTIMEO
 		 * window. Report -ETIMEDOUT to the caller instead of letting the
@@ -1505,11 +2371,13 @@ static int on_enter_receive(void)
 
 	k_mutex_lock(&m_metrics_lock, K_FOREVER);
 	m_metrics.downlink_bytes += *m_send_recv_param->recv_len;
+	m_txn.recv_len = MIN(*m_send_recv_param->recv_len, UINT16_MAX);
 	k_mutex_unlock(&m_metrics_lock);
 
 	k_sleep(K_MSEC(100));
 	delegate_event(HIO_LTE_FSM_EVENT_RECV);
 
+	m_batch_done++;
 	m_send_recv_param = NULL;
 	k_event_post(&m_states_event, SEND_RECV_BIT);
 
@@ -1547,11 +2415,27 @@ static int receive_event_handler(enum hio_lte_fsm_event event)
 
 static int on_enter_coneval(void)
 {
+	struct hio_lte_conn_param conn_param;
+
 	int ret = hio_lte_flow_coneval();
 	if (ret < 0) {
 		LOG_WRN("Call `hio_lte_flow_coneval` failed: %d", ret);
 	}
 
+	if (!ret && !hio_lte_state_get_conn_param(&conn_param)) {
+		hio_lte_defer_update(&conn_param, k_uptime_get());
+		if (conn_param.valid) {
+			hio_lte_txn_set_rsrp(m_coneval_txn_id, conn_param.rsrp);
+		}
+	} else {
+		hio_lte_defer_update(NULL, k_uptime_get());
+	}
+
+	/* Later evaluations (socket reopen, deferred send) belong to none */
+	m_coneval_txn_id = HIO_LTE_TXN_ID_NONE;
+
+	k_event_post(&m_states_event, CONEVAL_BIT);
+
 	delegate_event(HIO_LTE_FSM_EVENT_READY);
 
 	return 0;
@@ -1633,6 +2517,170 @@ static int on_leave_ncellmeas(void)
 	return 0;
 }
 
+/* Stop the search and add its time to the request */
+static void gnss_search_end(void)
+{
+	if (!m_gnss_searching) {
+		return;
+	}
+
+	m_gnss_searching = false;
+
+	int ret = hio_lte_gnss_stop();
+	if (ret) {
+		LOG_WRN("Call `hio_lte_gnss_stop` failed: %d", ret);
+	}
+
+	m_gnss_search_ms += k_uptime_get_32() - m_gnss_search_start;
+}
+
+/* Whole seconds left of the caller's deadline, INT_MAX for K_FOREVER */
+static int gnss_remaining_sec(void)
+{
+	k_timeout_t remaining = sys_timepoint_timeout(m_gnss_end);
+
+	if (K_TIMEOUT_EQ(remaining, K_FOREVER)) {
+		return INT_MAX;
+	}
+
+	return k_ticks_to_sec_floor32(remaining.ticks);
+}
+
+static void gnss_search_start(void)
+{
+	/* Searches are bounded by the caller's deadline and by the Kconfig limit */
+	int timeout_sec = CLAMP(gnss_remaining_sec(), 1, CONFIG_HIO_LTE_GNSS_FIX_TIMEOUT);
+
+	int ret = hio_lte_gnss_start(timeout_sec);
+	if (ret < 0) {
+		LOG_ERR("Call `hio_lte_gnss_start` failed: %d", ret);
+		gnss_finish(-EIO);
+		delegate_event(HIO_LTE_FSM_EVENT_XGPS_DISABLE);
+		return;
+	}
+
+	m_gnss_searching = true;
+	m_gnss_search_start = k_uptime_get_32();
+
+	start_timer(K_SECONDS(timeout_sec + GNSS_WATCHDOG_GUARD_SEC));
+}
+
+static int on_enter_gnss(void)
+{
+	int ret;
+
+	m_gnss_ready_deferred = false;
+
+	/* With LTE off (no PSM) only the receiver is activated */
+	if (atomic_test_bit(&m_flag, FLAG_CFUN4)) {
+		ret = hio_lte_flow_cfun(31);
+		if (ret < 0) {
+			LOG_ERR("Call `hio_lte_flow_cfun` failed: %d", ret);
+			return ret;
+		}
+	}
+
+	if (!m_gnss_started) {
+		m_gnss_started = true;
+		m_gnss_hot = hio_lte_gnss_is_hot();
+	}
+
+	gnss_search_start();
+
+	return 0;
+}
+
+static int gnss_event_handler(enum hio_lte_fsm_event event)
+{
+	switch (event) {
+	case HIO_LTE_FSM_EVENT_XGPS:
+		__fallthrough;
+	case HIO_LTE_FSM_EVENT_TIMEOUT: {
+		/* A fix, or the receiver gave up: the single fix search is capped
+		 * by the Kconfig limit, so search again while the caller's
+		 * deadline allows */
+		gnss_search_end();
+		stop_timer();
+
+		int ret = event == HIO_LTE_FSM_EVENT_XGPS ? hio_lte_gnss_read_fix(&m_gnss_fix)
+							   : -ETIMEDOUT;
+		if (ret && gnss_remaining_sec() > 0) {
+			LOG_INF("GNSS search without a fix, searching again");
+			gnss_search_start();
+			break;
+		}
+
+		gnss_finish(ret ? -ETIMEDOUT : 0);
+		transition_state(m_gnss_return_state);
+		break;
+	}
+	case HIO_LTE_FSM_EVENT_XGPS_DISABLE:
+		/* Stale if a new request is already pending */
+		if (!atomic_test_bit(&m_flag, FLAG_GNSS_ENABLE)) {
+			transition_state(m_gnss_return_state);
+		}
+		break;
+	case HIO_LTE_FSM_EVENT_SEND:
+		/* The uplink goes first; on_enter of the idle state resends the
+		 * SEND event and the search resumes in the next idle window */
+		LOG_INF("GNSS search preempted by an uplink");
+		k_mutex_lock(&m_metrics_lock, K_FOREVER);
+		m_metrics.gnss_preempted++;
+		k_mutex_unlock(&m_metrics_lock);
+		transition_state(m_gnss_return_state);
+		break;
+	case HIO_LTE_FSM_EVENT_READY:
+		/* NCELLMEAS or CONEVAL, neither is urgent */
+		m_gnss_ready_deferred = true;
+		break;
+	case HIO_LTE_FSM_EVENT_XMODEMSLEEP:
+		m_gnss_return_state = FSM_STATE_SLEEP;
+		break;
+	case HIO_LTE_FSM_EVENT_SOCKET_RECONFIG:
+		/* Picked up by on_enter_ready; SLEEP keeps it for the wake up */
+		if (m_gnss_return_state == FSM_STATE_READY) {
+			transition_state(FSM_STATE_READY);
+		}
+		break;
+	case HIO_LTE_FSM_EVENT_DEREGISTERED:
+		if (atomic_test_bit(&m_flag, FLAG_CFUN4)) {
+			return 0; /* ignore DEREGISTERED event */
+		}
+		transition_state(FSM_STATE_ATTACH);
+		break;
+	case HIO_LTE_FSM_EVENT_ERROR:
+		transition_state(FSM_STATE_ERROR);
+		break;
+	case HIO_LTE_FSM_EVENT_DISABLE:
+		transition_state(FSM_STATE_DISABLED);
+		break;
+	default:
+		break;
+	}
+	return 0;
+}
+
+static int on_leave_gnss(void)
+{
+	stop_timer();
+
+	gnss_search_end();
+
+	if (atomic_test_bit(&m_flag, FLAG_CFUN4)) {
+		int ret = hio_lte_flow_cfun(30);
+		if (ret < 0) {
+			LOG_WRN("Call `hio_lte_flow_cfun` failed: %d", ret);
+		}
+	}
+
+	if (m_gnss_ready_deferred) {
+		m_gnss_ready_deferred = false;
+		delegate_event(HIO_LTE_FSM_EVENT_READY);
+	}
+
+	return 0;
+}
+
 /* clang-format off */
 static struct fsm_state_desc m_fsm_states[] = {
 	{FSM_STATE_DISABLED, on_enter_disabled, on_leave_disabled, disabled_event_handler},
@@ -1648,6 +2696,7 @@ static struct fsm_state_desc m_fsm_states[] = {
 	{FSM_STATE_RECEIVE, on_enter_receive, NULL, receive_event_handler},
 	{FSM_STATE_CONEVAL, on_enter_coneval, NULL, coneval_event_handler},
 	{FSM_STATE_NCELLMEAS, on_enter_ncellmeas, on_leave_ncellmeas, ncellmeas_event_handler},
+	{FSM_STATE_GNSS, on_enter_gnss, on_leave_gnss, gnss_event_handler},
 };
 /* clang-format on */
 
@@ -1678,14 +2727,35 @@ static int init(void)
 		return ret;
 	}
 
-	ret = hio_lte_flow_init(delegate_event);
+	hio_lte_defer_init();
+	hio_lte_rtt_init();
+
+	ret = hio_lte_evq_init();
+	if (ret) {
+		LOG_ERR("Call `hio_lte_evq_init` failed: %d", ret);
+		return ret;
+	}
+
+	ret = hio_lte_flow_init(delegate_event_data);
 	if (ret) {
 		LOG_ERR("Call `hio_lte_flow_init` failed: %d", ret);
 		return ret;
 	}
 
+	ret = hio_lte_gnss_init(delegate_event_data);
+	if (ret) {
+		LOG_ERR("Call `hio_lte_gnss_init` failed: %d", ret);
+		return ret;
+	}
+
 	m_state = FSM_STATE_DISABLED;
 
+	ret = hio_lte_trace_init(m_state, trace_state_str);
+	if (ret) {
+		LOG_ERR("Call `hio_lte_trace_init` failed: %d", ret);
+		return ret;
+	}
+
 	k_work_queue_init(&m_work_q);
 
 	k_work_queue_start(&m_work_q, m_work_q_stack, K_THREAD_STACK_SIZEOF(m_work_q_stack),
@@ -1694,7 +2764,6 @@ static int init(void)
 
 	k_work_init_delayable(&m_timeout_work, timeout_work_handler);
 	k_work_init(&m_event_dispatch_work, event_dispatch_work_handler);
-	ring_buf_init(&m_event_rb, sizeof(m_event_buf), m_event_buf);
 
 	return 0;
 }
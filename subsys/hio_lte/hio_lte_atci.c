@@ -0,0 +1,62 @@
+#include "hio_lte_trace.h"
+
+/* HIO includes */
+#include <hio/hio_atci.h>
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+static int at_ltetrace_read(const struct hio_atci *atci)
+{
+	struct hio_lte_trace_entry entry;
+
+	for (int i = 0; !hio_lte_trace_get(i, &entry); i++) {
+		hio_atci_printfln(atci, "$LTETRACE: %u,\"%s\",\"%s\",\"%s\",%d,%u", entry.timestamp,
+				  hio_lte_trace_state_str(entry.from),
+				  hio_lte_trace_state_str(entry.to),
+				  hio_lte_trace_event_str(entry.event), entry.result,
+				  (entry.flags & HIO_LTE_TRACE_FLAG_TRANSITION) ? 1 : 0);
+	}
+
+	return 0;
+}
+
+static int at_ltetrace_test(const struct hio_atci *atci)
+{
+	hio_atci_printfln(atci, "$LTETRACE: \"timestamp\",\"from\",\"to\",\"event\",\"result\","
+				"\"transition\"");
+
+	return 0;
+}
+
+static int at_ltestats_read(const struct hio_atci *atci)
+{
+	struct hio_lte_trace_dwell dwell;
+
+	for (uint8_t state = 0; state < HIO_LTE_TRACE_STATES_MAX; state++) {
+		if (hio_lte_trace_get_dwell(state, &dwell) || !dwell.entries) {
+			continue;
+		}
+
+		hio_atci_printfln(atci, "$LTESTATS: \"%s\",%llu,%u", hio_lte_trace_state_str(state),
+				  (unsigned long long)dwell.total_ms, dwell.entries);
+	}
+
+	return 0;
+}
+
+static int at_ltestats_test(const struct hio_atci *atci)
+{
+	hio_atci_printfln(atci, "$LTESTATS: \"state\",\"time_ms\",\"entries\"");
+
+	return 0;
+}
+
+HIO_ATCI_CMD_REGISTER(ltetrace, "$LTETRACE", 0, NULL, NULL, at_ltetrace_read, at_ltetrace_test,
+		      "LTE FSM transitions and events");
+HIO_ATCI_CMD_REGISTER(ltestats, "$LTESTATS", 0, NULL, NULL, at_ltestats_read, at_ltestats_test,
+		      "Time spent in each LTE FSM state");
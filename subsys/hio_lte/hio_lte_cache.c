@@ -0,0 +1,287 @@
+#include "hio_lte_cache.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_cache, CONFIG_HIO_LTE_LOG_LEVEL);
+
+#define SETTINGS_SUBTREE "hio_lte_cache"
+#define SETTINGS_KEY     SETTINGS_SUBTREE "/data"
+
+/* Bump whenever the layout or the meaning of the items changes */
+#define CACHE_VERSION 2
+
+struct cache_data {
+	uint8_t version;
+	char fw_version[64];
+	uint64_t imei;
+	char hw_version[64];
+	uint32_t valid;
+	uint32_t crc[HIO_LTE_CACHE_ITEM_COUNT];
+};
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct cache_data m_data;
+static bool m_dirty;
+
+/* Written to the modem but not yet stored in its NVM; promoted to valid by the
+ * save following a successful CFUN=0 */
+static uint32_t m_pending;
+static uint32_t m_pending_crc[HIO_LTE_CACHE_ITEM_COUNT];
+
+static uint32_t value_crc(const char *value)
+{
+	return crc32_ieee((const uint8_t *)value, strlen(value));
+}
+
+#if defined(CONFIG_SETTINGS)
+static int load_direct_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+			  void *param)
+{
+	struct cache_data data;
+
+	if (!settings_name_steq(key, "data", NULL)) {
+		return 0;
+	}
+
+	if (len != sizeof(data)) {
+		LOG_WRN("Size mismatch: expected %zu, got %zu", sizeof(data), len);
+		return 0;
+	}
+
+	int ret = read_cb(cb_arg, &data, len);
+	if (ret < 0) {
+		LOG_ERR("Call `read_cb` failed: %d", ret);
+		return ret;
+	}
+
+	if (data.version != CACHE_VERSION) {
+		LOG_WRN("Version mismatch: expected %u, got %u", CACHE_VERSION, data.version);
+		return 0;
+	}
+
+	m_data = data;
+
+	return 0;
+}
+#endif
+
+int hio_lte_cache_init(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	memset(&m_data, 0, sizeof(m_data));
+	m_data.version = CACHE_VERSION;
+	m_dirty = false;
+	m_pending = 0;
+
+#if defined(CONFIG_SETTINGS)
+	int ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Call `settings_subsys_init` failed: %d", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+
+	ret = settings_load_subtree_direct(SETTINGS_SUBTREE, load_direct_cb, NULL);
+	if (ret) {
+		LOG_ERR("Call `settings_load_subtree_direct` failed: %d", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+#endif
+
+	LOG_DBG("Loaded %u cached item(s) for FW '%s'", (unsigned int)POPCOUNT(m_data.valid),
+		m_data.fw_version);
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+int hio_lte_cache_begin(const char *fw_version)
+{
+	if (!fw_version) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (strlen(fw_version) < sizeof(m_data.fw_version) &&
+	    !strcmp(m_data.fw_version, fw_version)) {
+		k_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+	if (m_data.fw_version[0]) {
+		LOG_INF("Modem FW changed (was '%s'), dropping cache", m_data.fw_version);
+	}
+
+	memset(&m_data, 0, sizeof(m_data));
+	m_data.version = CACHE_VERSION;
+	strncpy(m_data.fw_version, fw_version, sizeof(m_data.fw_version) - 1);
+	m_dirty = true;
+	m_pending = 0;
+
+	k_mutex_unlock(&m_lock);
+
+	return -ESTALE;
+}
+
+bool hio_lte_cache_check(enum hio_lte_cache_item item, const char *value)
+{
+	if (!IS_ENABLED(CONFIG_HIO_LTE_MODEM_CACHE)) {
+		return false;
+	}
+
+	if (item == HIO_LTE_CACHE_ITEM_NONE || item >= HIO_LTE_CACHE_ITEM_COUNT || !value) {
+		return false;
+	}
+
+	uint32_t crc = value_crc(value);
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	bool hit = m_data.fw_version[0] && (m_data.valid & BIT(item)) && m_data.crc[item] == crc;
+
+	k_mutex_unlock(&m_lock);
+
+	return hit;
+}
+
+void hio_lte_cache_update(enum hio_lte_cache_item item, const char *value)
+{
+	if (item == HIO_LTE_CACHE_ITEM_NONE || item >= HIO_LTE_CACHE_ITEM_COUNT || !value) {
+		return;
+	}
+
+	uint32_t crc = value_crc(value);
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	/* The persisted entry still describes the modem NVM until the next CFUN=0 */
+	m_pending |= BIT(item);
+	m_pending_crc[item] = crc;
+
+	k_mutex_unlock(&m_lock);
+}
+
+int hio_lte_cache_get_identity(uint64_t *imei, char *hw_version, size_t size)
+{
+	if (!imei || !hw_version || !size) {
+		return -EINVAL;
+	}
+
+	if (!IS_ENABLED(CONFIG_HIO_LTE_MODEM_CACHE)) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (!m_data.fw_version[0] || !m_data.imei || !m_data.hw_version[0]) {
+		k_mutex_unlock(&m_lock);
+		return -ENOENT;
+	}
+
+	*imei = m_data.imei;
+	strncpy(hw_version, m_data.hw_version, size - 1);
+	hw_version[size - 1] = '\0';
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+void hio_lte_cache_set_identity(uint64_t imei, const char *hw_version)
+{
+	if (!hw_version) {
+		return;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (m_data.imei != imei || strncmp(m_data.hw_version, hw_version,
+					   sizeof(m_data.hw_version) - 1)) {
+		m_data.imei = imei;
+		memset(m_data.hw_version, 0, sizeof(m_data.hw_version));
+		strncpy(m_data.hw_version, hw_version, sizeof(m_data.hw_version) - 1);
+		m_dirty = true;
+	}
+
+	k_mutex_unlock(&m_lock);
+}
+
+int hio_lte_cache_save(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	for (int i = 0; i < HIO_LTE_CACHE_ITEM_COUNT; i++) {
+		if (!(m_pending & BIT(i))) {
+			continue;
+		}
+
+		if (!(m_data.valid & BIT(i)) || m_data.crc[i] != m_pending_crc[i]) {
+			m_data.valid |= BIT(i);
+			m_data.crc[i] = m_pending_crc[i];
+			m_dirty = true;
+		}
+	}
+
+	m_pending = 0;
+
+	if (!m_dirty) {
+		k_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+#if defined(CONFIG_SETTINGS)
+	int ret = settings_save_one(SETTINGS_KEY, &m_data, sizeof(m_data));
+	if (ret) {
+		LOG_ERR("Call `settings_save_one` failed: %d", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+#endif
+
+	m_dirty = false;
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+int hio_lte_cache_invalidate(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	bool was_valid = m_data.valid != 0;
+
+	m_pending = 0;
+
+	if (was_valid) {
+		m_data.valid = 0;
+		memset(m_data.crc, 0, sizeof(m_data.crc));
+		m_dirty = true;
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	/* The modem may store whatever was written at the next CFUN=0, so the
+	 * persisted copy must not survive until then */
+	return was_valid ? hio_lte_cache_save() : 0;
+}
@@ -0,0 +1,54 @@
+#ifndef SUBSYS_HIO_LTE_CACHE_H_
+#define SUBSYS_HIO_LTE_CACHE_H_
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Modem settings that are kept in the modem NVM across CFUN=0 and power cycles.
+ * Session settings (URC subscriptions, CFUN, COPS, ...) are not cached and are
+ * written on every prepare. */
+enum hio_lte_cache_item {
+	HIO_LTE_CACHE_ITEM_NONE = 0,
+	HIO_LTE_CACHE_ITEM_XSYSTEMMODE,
+	HIO_LTE_CACHE_ITEM_XEPCO,
+	HIO_LTE_CACHE_ITEM_XDATAPRFL,
+	HIO_LTE_CACHE_ITEM_XBANDLOCK,
+	HIO_LTE_CACHE_ITEM_CPSMS,
+	HIO_LTE_CACHE_ITEM_CGDCONT,
+	HIO_LTE_CACHE_ITEM_CGAUTH,
+	HIO_LTE_CACHE_ITEM_COUNT /* Must be last */
+};
+
+int hio_lte_cache_init(void);
+
+/* Bind the cache to the running modem firmware; a different version than the
+ * cached one drops all entries. Returns -ESTALE in that case. */
+int hio_lte_cache_begin(const char *fw_version);
+
+/* True if @p value (the AT parameters) was applied last time for @p item and
+ * stored by the modem. */
+bool hio_lte_cache_check(enum hio_lte_cache_item item, const char *value);
+
+/* Record that @p value was written; it only counts for hio_lte_cache_check()
+ * after the next hio_lte_cache_save(). */
+void hio_lte_cache_update(enum hio_lte_cache_item item, const char *value);
+
+int hio_lte_cache_get_identity(uint64_t *imei, char *hw_version, size_t size);
+void hio_lte_cache_set_identity(uint64_t imei, const char *hw_version);
+
+/* Mark the written entries valid and persist them; call only after a
+ * successful CFUN=0, when the modem stored its NVM. */
+int hio_lte_cache_save(void);
+int hio_lte_cache_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_CACHE_H_ */
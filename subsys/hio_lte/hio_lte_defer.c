@@ -0,0 +1,103 @@
+#include "hio_lte_defer.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/time_units.h>
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_defer, CONFIG_HIO_LTE_LOG_LEVEL);
+
+#define EVAL_INTERVAL_MS ((int64_t)CONFIG_HIO_LTE_DEFER_EVAL_INTERVAL * MSEC_PER_SEC)
+
+static K_MUTEX_DEFINE(m_lock);
+
+static bool m_evaluated;
+static bool m_valid;
+static int m_eest;
+static int64_t m_eval_ts;
+static bool m_requested;
+static int64_t m_request_ts;
+
+static struct hio_lte_defer_stats m_stats;
+
+void hio_lte_defer_init(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_evaluated = false;
+	m_valid = false;
+	m_eest = 0;
+	m_eval_ts = 0;
+	m_requested = false;
+	m_request_ts = 0;
+	memset(&m_stats, 0, sizeof(m_stats));
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_defer_update(const struct hio_lte_conn_param *param, int64_t now)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_evaluated = true;
+	m_valid = param && param->valid && param->result == 0;
+	m_eest = m_valid ? param->eest : 0;
+	m_eval_ts = now;
+
+	LOG_DBG("Energy estimate: %d (valid: %d)", m_eest, m_valid);
+
+	k_mutex_unlock(&m_lock);
+}
+
+enum hio_lte_defer_action hio_lte_defer_decide(int64_t now)
+{
+	enum hio_lte_defer_action action = HIO_LTE_DEFER_ACTION_WAIT;
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	bool fresh = m_evaluated && now - m_eval_ts < EVAL_INTERVAL_MS;
+
+	/* A request the FSM did not get to is retried after the same interval */
+	if (fresh && m_valid && m_eest >= CONFIG_HIO_LTE_DEFER_MIN_EEST) {
+		action = HIO_LTE_DEFER_ACTION_SEND;
+	} else if (!fresh && (!m_requested || now - m_request_ts >= EVAL_INTERVAL_MS)) {
+		m_requested = true;
+		m_request_ts = now;
+		m_stats.evaluations++;
+		action = HIO_LTE_DEFER_ACTION_EVALUATE;
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return action;
+}
+
+void hio_lte_defer_release(bool deadline)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (deadline) {
+		m_stats.sent_deadline++;
+	} else {
+		m_stats.sent_good++;
+	}
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_defer_get_stats(struct hio_lte_defer_stats *stats)
+{
+	if (!stats) {
+		return;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+	*stats = m_stats;
+	k_mutex_unlock(&m_lock);
+}
@@ -0,0 +1,52 @@
+#ifndef SUBSYS_HIO_LTE_DEFER_H_
+#define SUBSYS_HIO_LTE_DEFER_H_
+
+/* HIO includes */
+#include <hio/hio_lte.h>
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* What a deferred send should do next (see hio_lte_send_recv_deferred) */
+enum hio_lte_defer_action {
+	/* The last evaluation is fresh and good enough */
+	HIO_LTE_DEFER_ACTION_SEND = 0,
+	/* The last evaluation is stale; request a new one */
+	HIO_LTE_DEFER_ACTION_EVALUATE,
+	/* Wait for the pending evaluation or for better conditions */
+	HIO_LTE_DEFER_ACTION_WAIT,
+};
+
+struct hio_lte_defer_stats {
+	/* Evaluations requested by deferred sends */
+	uint32_t evaluations;
+	/* Deferred sends released by a good evaluation */
+	uint32_t sent_good;
+	/* Deferred sends released by their deadline */
+	uint32_t sent_deadline;
+};
+
+void hio_lte_defer_init(void);
+
+/* Result of a CONEVAL at @p now (ms); NULL if the evaluation failed */
+void hio_lte_defer_update(const struct hio_lte_conn_param *param, int64_t now);
+
+/* Both the age of a usable result and the spacing of the requested
+ * evaluations are bounded by CONFIG_HIO_LTE_DEFER_EVAL_INTERVAL */
+enum hio_lte_defer_action hio_lte_defer_decide(int64_t now);
+
+/* Account a deferred send released by a good evaluation or by its deadline */
+void hio_lte_defer_release(bool deadline);
+
+void hio_lte_defer_get_stats(struct hio_lte_defer_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_DEFER_H_ */
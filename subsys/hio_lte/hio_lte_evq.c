@@ -0,0 +1,281 @@
+#include "hio_lte_evq.h"
+#include "hio_lte_flow.h"
+#include "hio_lte_parse.h"
+#include "hio_lte_str.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_evq, CONFIG_HIO_LTE_LOG_LEVEL);
+
+#define QUEUE_SIZE CONFIG_HIO_LTE_EVENT_QUEUE_SIZE
+#define QUEUE_MASK (QUEUE_SIZE - 1)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(QUEUE_SIZE), "CONFIG_HIO_LTE_EVENT_QUEUE_SIZE must be a power of 2");
+
+#define CSCON_UNKNOWN -1
+
+/* Bounded MPSC ring: every slot carries a sequence number telling whether it
+ * is free for position pos (seq == pos) or holds the event of position pos
+ * (seq == pos + 1). Producers claim a position by CAS on the tail. */
+struct slot {
+	atomic_t seq;
+	struct hio_lte_evq_item item;
+};
+
+static struct slot m_slots[QUEUE_SIZE];
+static atomic_t m_tail;
+static atomic_t m_head;
+/* Positions before this one are dropped by the consumer (flush) */
+static atomic_t m_discard;
+
+/* Value of the newest CSCON event still waiting in the queue */
+static atomic_t m_cscon_queued = ATOMIC_INIT(CSCON_UNKNOWN);
+static atomic_t m_ncellmeas_pending;
+
+/* Single writer (the AT monitor), read by the LTE thread; odd sequence means
+ * a write in progress */
+static struct {
+	atomic_t seq;
+	struct hio_lte_ncellmeas_param param;
+} m_ncellmeas;
+
+static atomic_t m_posted;
+static atomic_t m_dropped;
+static atomic_t m_coalesced;
+static atomic_t m_max_depth;
+
+static inline int32_t seq_diff(atomic_val_t a, atomic_val_t b)
+{
+	return (int32_t)((uint32_t)a - (uint32_t)b);
+}
+
+static void update_max_depth(atomic_val_t pos)
+{
+	atomic_val_t depth = (atomic_val_t)seq_diff(pos + 1, atomic_get(&m_head));
+	atomic_val_t max = atomic_get(&m_max_depth);
+
+	while (depth > max) {
+		if (atomic_cas(&m_max_depth, max, depth)) {
+			break;
+		}
+		max = atomic_get(&m_max_depth);
+	}
+}
+
+static void set_ncellmeas(const struct hio_lte_ncellmeas_param *param)
+{
+	atomic_inc(&m_ncellmeas.seq);
+	memcpy(&m_ncellmeas.param, param, sizeof(m_ncellmeas.param));
+	atomic_inc(&m_ncellmeas.seq);
+}
+
+/* True if the event carries nothing new and needs no slot of its own */
+static bool coalesce(enum hio_lte_fsm_event event, const void *data)
+{
+	switch (event) {
+	case HIO_LTE_FSM_EVENT_CSCON_0:
+	case HIO_LTE_FSM_EVENT_CSCON_1: {
+		atomic_val_t value = event == HIO_LTE_FSM_EVENT_CSCON_1 ? 1 : 0;
+
+		/* Nothing can come between the two for the FSM to tell them apart */
+		return atomic_set(&m_cscon_queued, value) == value;
+	}
+	case HIO_LTE_FSM_EVENT_NCELLMEAS:
+		if (data) {
+			set_ncellmeas(data);
+		}
+
+		/* The queued event picks up the newer result */
+		return atomic_set(&m_ncellmeas_pending, 1) == 1;
+	default:
+		return false;
+	}
+}
+
+static void uncoalesce(enum hio_lte_fsm_event event)
+{
+	switch (event) {
+	case HIO_LTE_FSM_EVENT_CSCON_0:
+	case HIO_LTE_FSM_EVENT_CSCON_1:
+		atomic_set(&m_cscon_queued, CSCON_UNKNOWN);
+		break;
+	case HIO_LTE_FSM_EVENT_NCELLMEAS:
+		atomic_clear(&m_ncellmeas_pending);
+		break;
+	default:
+		break;
+	}
+}
+
+int hio_lte_evq_init(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(m_slots); i++) {
+		atomic_set(&m_slots[i].seq, (atomic_val_t)i);
+	}
+
+	atomic_clear(&m_tail);
+	atomic_clear(&m_head);
+	atomic_clear(&m_discard);
+	atomic_set(&m_cscon_queued, CSCON_UNKNOWN);
+	atomic_clear(&m_ncellmeas_pending);
+	atomic_clear(&m_posted);
+	atomic_clear(&m_dropped);
+	atomic_clear(&m_coalesced);
+	atomic_clear(&m_max_depth);
+
+	return 0;
+}
+
+int hio_lte_evq_put(enum hio_lte_fsm_event event, const void *data)
+{
+	if (event >= HIO_LTE_FSM_EVENT_COUNT) {
+		return -EINVAL;
+	}
+
+	if (coalesce(event, data)) {
+		atomic_inc(&m_coalesced);
+		return 0;
+	}
+
+	atomic_val_t pos = atomic_get(&m_tail);
+	struct slot *slot;
+
+	for (;;) {
+		slot = &m_slots[pos & QUEUE_MASK];
+
+		int32_t diff = seq_diff(atomic_get(&slot->seq), pos);
+
+		if (diff == 0) {
+			if (atomic_cas(&m_tail, pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			uncoalesce(event);
+			atomic_inc(&m_dropped);
+			LOG_WRN("Queue full, dropping event: %s", hio_lte_str_fsm_event(event));
+			return -ENOSPC;
+		}
+
+		pos = atomic_get(&m_tail);
+	}
+
+	memset(&slot->item, 0, sizeof(slot->item));
+	slot->item.event = event;
+
+	if (data) {
+		switch (event) {
+		case HIO_LTE_FSM_EVENT_REGISTERED:
+		case HIO_LTE_FSM_EVENT_DEREGISTERED:
+			slot->item.cereg = *(const struct hio_lte_cereg_param *)data;
+			break;
+		case HIO_LTE_FSM_EVENT_RAI:
+			slot->item.rai = *(const struct hio_lte_rai_param *)data;
+			break;
+		default:
+			break;
+		}
+	}
+
+	/* Publish the slot to the consumer */
+	atomic_set(&slot->seq, pos + 1);
+
+	atomic_inc(&m_posted);
+	update_max_depth(pos);
+
+	return 0;
+}
+
+int hio_lte_evq_get(struct hio_lte_evq_item *item)
+{
+	if (!item) {
+		return -EINVAL;
+	}
+
+	atomic_val_t pos = atomic_get(&m_head);
+
+	for (;;) {
+		struct slot *slot = &m_slots[pos & QUEUE_MASK];
+
+		if (seq_diff(atomic_get(&slot->seq), pos + 1) < 0) {
+			return -ENODATA;
+		}
+
+		bool flushed = seq_diff(pos, atomic_get(&m_discard)) < 0;
+
+		*item = slot->item;
+
+		/* Free the slot for the producers one lap ahead */
+		atomic_set(&slot->seq, pos + QUEUE_SIZE);
+		atomic_set(&m_head, ++pos);
+
+		switch (item->event) {
+		case HIO_LTE_FSM_EVENT_CSCON_0:
+			atomic_cas(&m_cscon_queued, 0, CSCON_UNKNOWN);
+			break;
+		case HIO_LTE_FSM_EVENT_CSCON_1:
+			atomic_cas(&m_cscon_queued, 1, CSCON_UNKNOWN);
+			break;
+		case HIO_LTE_FSM_EVENT_NCELLMEAS:
+			atomic_clear(&m_ncellmeas_pending);
+			break;
+		default:
+			break;
+		}
+
+		if (!flushed) {
+			return 0;
+		}
+	}
+}
+
+int hio_lte_evq_get_ncellmeas(struct hio_lte_ncellmeas_param *param)
+{
+	if (!param) {
+		return -EINVAL;
+	}
+
+	for (;;) {
+		atomic_val_t seq = atomic_get(&m_ncellmeas.seq);
+
+		if (seq & 1) {
+			k_yield();
+			continue;
+		}
+
+		memcpy(param, &m_ncellmeas.param, sizeof(*param));
+
+		if (atomic_get(&m_ncellmeas.seq) == seq) {
+			hio_lte_parse_ncellmeas_link(param);
+			return 0;
+		}
+	}
+}
+
+void hio_lte_evq_flush(void)
+{
+	atomic_set(&m_discard, atomic_get(&m_tail));
+	atomic_set(&m_cscon_queued, CSCON_UNKNOWN);
+}
+
+void hio_lte_evq_get_stats(struct hio_lte_evq_stats *stats)
+{
+	if (!stats) {
+		return;
+	}
+
+	stats->posted = (uint32_t)atomic_get(&m_posted);
+	stats->dropped = (uint32_t)atomic_get(&m_dropped);
+	stats->coalesced = (uint32_t)atomic_get(&m_coalesced);
+	stats->max_depth = (uint32_t)atomic_get(&m_max_depth);
+}
@@ -0,0 +1,64 @@
+#ifndef SUBSYS_HIO_LTE_EVQ_H_
+#define SUBSYS_HIO_LTE_EVQ_H_
+
+#include "hio_lte_flow.h"
+
+/* HIO includes */
+#include <hio/hio_lte.h>
+
+/* Standard includes */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* FSM event together with the data it was raised with, so the LTE thread
+ * handles each event with the state that belonged to it */
+struct hio_lte_evq_item {
+	enum hio_lte_fsm_event event;
+	union {
+		/* HIO_LTE_FSM_EVENT_REGISTERED, HIO_LTE_FSM_EVENT_DEREGISTERED */
+		struct hio_lte_cereg_param cereg;
+		/* HIO_LTE_FSM_EVENT_RAI */
+		struct hio_lte_rai_param rai;
+	};
+};
+
+struct hio_lte_evq_stats {
+	uint32_t posted;
+	/* Lost because the queue was full */
+	uint32_t dropped;
+	/* Merged into an event still waiting in the queue */
+	uint32_t coalesced;
+	uint32_t max_depth;
+};
+
+int hio_lte_evq_init(void);
+
+/*
+ * Post an event from any thread (lock-free, multiple producers). @p data points
+ * to the payload of the event type (see struct hio_lte_evq_item; a
+ * struct hio_lte_ncellmeas_param for HIO_LTE_FSM_EVENT_NCELLMEAS) or is NULL.
+ *
+ * A CSCON event equal to the newest CSCON still queued and an NCELLMEAS event
+ * while another one is queued are coalesced. Returns -ENOSPC when full.
+ */
+int hio_lte_evq_put(enum hio_lte_fsm_event event, const void *data);
+
+/* Take the oldest event; single consumer only. -ENODATA when empty. */
+int hio_lte_evq_get(struct hio_lte_evq_item *item);
+
+/* Latest NCELLMEAS result; its size keeps it out of the queue slots */
+int hio_lte_evq_get_ncellmeas(struct hio_lte_ncellmeas_param *param);
+
+/* Drop everything posted so far; safe to call from any thread */
+void hio_lte_evq_flush(void);
+
+void hio_lte_evq_get_stats(struct hio_lte_evq_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_EVQ_H_ */
@@ -1,9 +1,16 @@
+#include "hio_lte_cache.h"
 #include "hio_lte_config.h"
 #include "hio_lte_flow.h"
+#include "hio_lte_hint.h"
 #include "hio_lte_parse.h"
+#include "hio_lte_plan.h"
+#include "hio_lte_psm.h"
+#include "hio_lte_resp.h"
+#include "hio_lte_rtt.h"
 #include "hio_lte_state.h"
 #include "hio_lte_str.h"
 #include "hio_lte_talk.h"
+#include "hio_lte_urc.h"
 #include "hio_lte_util.h"
 
 /* HIO includes */
@@ -61,102 +68,159 @@ static K_EVENT_DEFINE(m_flow_events);
 
 static HIO_LTE_FSM_EVENT_delegate_cb m_event_delegate_cb;
 
-static struct nrf_sockaddr_in m_addr_info;
 static struct cgdcont_param m_cgdcont;
 
-static int m_socket_fd = -1;
+/* Indexed by the socket handle, -1 when closed */
+static int m_socket_fds[CONFIG_HIO_LTE_SOCKETS_MAX];
+/* DTLS connection of the default socket saved and not loaded back */
+static bool m_dtls_suspended;
 
-static void process_urc(const char *line, void *user_data)
+static void urc_ready(const char *params, void *user_data)
+{
+	m_event_delegate_cb(HIO_LTE_FSM_EVENT_READY, NULL);
+}
+
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_ready, "Ready", urc_ready, NULL);
+
+static void urc_xsim(const char *params, void *user_data)
+{
+	if (params[0] == '1') {
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_SIMDETECTED, NULL);
+	}
+}
+
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_xsim, "%XSIM", urc_xsim, NULL);
+
+static void urc_xtime(const char *params, void *user_data)
+{
+	m_event_delegate_cb(HIO_LTE_FSM_EVENT_XTIME, NULL);
+}
+
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_xtime, "%XTIME", urc_xtime, NULL);
+
+static void urc_cereg(const char *params, void *user_data)
 {
 	int ret;
-	ARG_UNUSED(user_data);
+	struct hio_lte_cereg_param cereg_param = {0};
 
-	if (!line) {
-		LOG_ERR("URC line is NULL");
+	ret = hio_lte_parse_urc_cereg(params, &cereg_param);
+	if (ret) {
+		LOG_WRN("Call `hio_lte_parse_urc_cereg` failed: %d", ret);
 		return;
 	}
 
-	if (g_hio_lte_config.test) {
-		return; /* Test mode active, ignoring URC */
+	if (!cereg_param.valid) {
+		LOG_WRN("CEREG was %d\n", (enum hio_lte_cereg_param_stat)cereg_param.stat);
+		return;
 	}
 
-	LOG_INF("URC: %s", line);
+	/* The parameters travel with the event and are stored when the FSM
+	 * handles it */
+	if (cereg_param.stat == HIO_LTE_CEREG_PARAM_STAT_REGISTERED_HOME ||
+	    cereg_param.stat == HIO_LTE_CEREG_PARAM_STAT_REGISTERED_ROAMING) {
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_REGISTERED, &cereg_param);
+	} else {
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_DEREGISTERED, &cereg_param);
+	}
+}
 
-	if (!strcmp(line, "Ready")) {
-		m_event_delegate_cb(HIO_LTE_FSM_EVENT_READY);
-	} else if (!strncmp(line, "%XSIM: 1", 8)) {
-		m_event_delegate_cb(HIO_LTE_FSM_EVENT_SIMDETECTED);
-	} else if (!strncmp(line, "%XTIME:", 7)) {
-		m_event_delegate_cb(HIO_LTE_FSM_EVENT_XTIME);
-	} else if (!strncmp(line, "+CEREG: ", 8)) {
-		struct hio_lte_cereg_param cereg_param = {0};
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_cereg, "+CEREG", urc_cereg, NULL);
 
-		ret = hio_lte_parse_urc_cereg(&line[8], &cereg_param);
-		if (ret) {
-			LOG_WRN("Call `hio_lte_parse_urc_cereg` failed: %d", ret);
-			return;
-		}
+static void urc_mdmev(const char *params, void *user_data)
+{
+	if (!strncmp(params, "RESET LOOP", 10)) {
+		LOG_WRN("Modem reset loop detected");
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_RESET_LOOP, NULL);
+	}
+}
 
-		if (!cereg_param.valid) {
-			LOG_WRN("CEREG was %d\n", (enum hio_lte_cereg_param_stat)cereg_param.stat);
-			return;
-		}
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_mdmev, "%MDMEV", urc_mdmev, NULL);
 
-		hio_lte_state_set_cereg_param(&cereg_param);
+static void urc_cscon(const char *params, void *user_data)
+{
+	if (params[0] == '0') {
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_CSCON_0, NULL);
+	} else if (params[0] == '1') {
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_CSCON_1, NULL);
+	}
+}
 
-		if (cereg_param.stat == HIO_LTE_CEREG_PARAM_STAT_REGISTERED_HOME ||
-		    cereg_param.stat == HIO_LTE_CEREG_PARAM_STAT_REGISTERED_ROAMING) {
-			m_event_delegate_cb(HIO_LTE_FSM_EVENT_REGISTERED);
-		} else {
-			m_event_delegate_cb(HIO_LTE_FSM_EVENT_DEREGISTERED);
-		}
-	} else if (!strncmp(line, "%MDMEV: ", 8)) {
-		if (!strncmp(&line[8], "RESET LOOP", 10)) {
-			LOG_WRN("Modem reset loop detected");
-			m_event_delegate_cb(HIO_LTE_FSM_EVENT_RESET_LOOP);
-		}
-	} else if (!strncmp(line, "+CSCON: 0", 9)) {
-		m_event_delegate_cb(HIO_LTE_FSM_EVENT_CSCON_0);
-	} else if (!strncmp(line, "+CSCON: 1", 9)) {
-		m_event_delegate_cb(HIO_LTE_FSM_EVENT_CSCON_1);
-	} else if (!strncmp(line, "%XMODEMSLEEP: ", 14)) {
-		int p1 = 0, p2 = 0;
-
-		ret = hio_lte_parse_urc_xmodemsleep(line + 14, &p1, &p2);
-		if (ret) {
-			LOG_WRN("Call `hio_lte_parse_urc_xmodemsleep` failed: %d", ret);
-			return;
-		}
-		if (p2 > 0 || p1 == 4) {
-			m_event_delegate_cb(HIO_LTE_FSM_EVENT_XMODEMSLEEP);
-		}
-	} else if (!strncmp(line, "%RAI: ", 6)) {
-		struct hio_lte_rai_param rai_param = {0};
-		ret = hio_lte_parse_urc_rai(line + 6, &rai_param);
-		if (ret) {
-			LOG_WRN("Call `hio_lte_parse_urc_rai` failed: %d", ret);
-			return;
-		}
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_cscon, "+CSCON", urc_cscon, NULL);
 
-		hio_lte_state_set_rai_param(&rai_param);
-	} else if (!strncmp(line, "%NCELLMEAS: ", 12)) {
-		struct hio_lte_ncellmeas_param ncellmeas_param = {0};
-		ret = hio_lte_parse_urc_ncellmeas(line + 12, 5, &ncellmeas_param);
-		if (ret) {
-			LOG_WRN("Call `hio_lte_parse_urc_ncellmeas` failed: %d", ret);
-		}
-		if (ncellmeas_param.valid) {
-			LOG_INF("NCELLMEAS: %d cells, %d ncells", ncellmeas_param.num_cells,
-				ncellmeas_param.num_ncells);
-		} else {
-			LOG_WRN("NCELLMEAS data not valid");
-			return;
-		}
-		hio_lte_state_set_ncellmeas_param(&ncellmeas_param);
-		m_event_delegate_cb(HIO_LTE_FSM_EVENT_NCELLMEAS);
+static void urc_xmodemsleep(const char *params, void *user_data)
+{
+	int ret;
+	int p1 = 0, p2 = 0;
+
+	ret = hio_lte_parse_urc_xmodemsleep(params, &p1, &p2);
+	if (ret) {
+		LOG_WRN("Call `hio_lte_parse_urc_xmodemsleep` failed: %d", ret);
+		return;
+	}
+	if (p2 > 0 || p1 == 4) {
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_XMODEMSLEEP, NULL);
 	}
 }
 
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_xmodemsleep, "%XMODEMSLEEP", urc_xmodemsleep,
+			     NULL);
+
+static void urc_rai(const char *params, void *user_data)
+{
+	int ret;
+	struct hio_lte_rai_param rai_param = {0};
+
+	ret = hio_lte_parse_urc_rai(params, &rai_param);
+	if (ret) {
+		LOG_WRN("Call `hio_lte_parse_urc_rai` failed: %d", ret);
+		return;
+	}
+
+	m_event_delegate_cb(HIO_LTE_FSM_EVENT_RAI, &rai_param);
+}
+
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_rai, "%RAI", urc_rai, NULL);
+
+static void urc_ncellmeas(const char *params, void *user_data)
+{
+	int ret;
+	struct hio_lte_ncellmeas_param ncellmeas_param;
+
+	/* Fills the whole struct in place, no need to clear it */
+	ret = hio_lte_parse_urc_ncellmeas(params, 5, &ncellmeas_param);
+	if (ret) {
+		LOG_WRN("Call `hio_lte_parse_urc_ncellmeas` failed: %d", ret);
+	}
+	if (ncellmeas_param.valid) {
+		LOG_INF("NCELLMEAS: %d cells, %d ncells", ncellmeas_param.num_cells,
+			ncellmeas_param.num_ncells);
+	} else {
+		LOG_WRN("NCELLMEAS data not valid");
+		return;
+	}
+	m_event_delegate_cb(HIO_LTE_FSM_EVENT_NCELLMEAS, &ncellmeas_param);
+}
+
+HIO_LTE_URC_HANDLER_REGISTER(hio_lte_flow_urc_ncellmeas, "%NCELLMEAS", urc_ncellmeas, NULL);
+
+static void process_urc(const char *line, void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (!line) {
+		LOG_ERR("URC line is NULL");
+		return;
+	}
+
+	if (g_hio_lte_config.test) {
+		return; /* Test mode active, ignoring URC */
+	}
+
+	LOG_INF("URC: %s", line);
+
+	hio_lte_urc_dispatch(line);
+}
+
 static void str_remove_trailing_quotes(char *str)
 {
 	int l = strlen(str);
@@ -241,66 +305,108 @@ static int fill_bands(char *bands)
 	return 0;
 }
 
-int hio_lte_flow_prepare(void)
-{
-	int ret;
+static uint64_t m_prepare_imei;
 
-	ret = hio_lte_talk_at_cfun(0);
+/* The cached identity is trusted only after AT+CGSN confirmed it once per boot;
+ * a swapped modem or a cleared NVM would otherwise go unnoticed */
+static bool m_prepare_imei_checked;
+
+static int prepare_cfun_0_handle(const char *value)
+{
+	/* Anything written before this CFUN=0 is now in the modem NVM */
+	int ret = hio_lte_cache_save();
 	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cfun: 0` failed: %d", ret);
-		return ret;
+		LOG_WRN("Call `hio_lte_cache_save` failed: %d", ret);
 	}
 
-	char cgsn[64] = {0};
-	ret = hio_lte_talk_at_cgsn(cgsn, sizeof(cgsn));
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cgsn` failed: %d", ret);
+	return 0;
+}
+
+static int prepare_shortswver_handle(const char *value)
+{
+	LOG_INF("SW version: %s", value);
+
+	hio_lte_state_set_modem_fw_version(value);
+
+	int ret = hio_lte_cache_begin(value);
+	if (ret && ret != -ESTALE) {
+		LOG_ERR("Call `hio_lte_cache_begin` failed: %d", ret);
 		return ret;
 	}
 
+	return 0;
+}
+
+static bool prepare_identity_cached(void)
+{
+	char hw_version[64];
+
+	if (hio_lte_cache_get_identity(&m_prepare_imei, hw_version, sizeof(hw_version))) {
+		return false;
+	}
+
+	LOG_INF("IMEI: %llu (cached)", (unsigned long long)m_prepare_imei);
+	LOG_INF("HW version: %s (cached)", hw_version);
+
+	hio_lte_state_set_imei(m_prepare_imei);
+
+	return true;
+}
+
+static bool prepare_cgsn_skip(void)
+{
+	return m_prepare_imei_checked && prepare_identity_cached();
+}
+
+static int prepare_cgsn_handle(const char *value)
+{
+	char cgsn[64];
+	uint64_t cached_imei;
+	char hw_version[64];
+
+	strncpy(cgsn, value, sizeof(cgsn) - 1);
+	cgsn[sizeof(cgsn) - 1] = '\0';
+
 	str_remove_trailing_quotes(cgsn);
 
 	LOG_INF("CGSN: %s", cgsn);
 
-	hio_lte_state_set_imei(strtoull(cgsn, NULL, 10));
+	m_prepare_imei = strtoull(cgsn, NULL, 10);
 
-	char hw_version[64] = {0};
-	ret = hio_lte_talk_at_hwversion(hw_version, sizeof(hw_version));
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_hwversion` failed: %d", ret);
-		return ret;
-	}
+	hio_lte_state_set_imei(m_prepare_imei);
 
-	LOG_INF("HW version: %s", hw_version);
+	if (!hio_lte_cache_get_identity(&cached_imei, hw_version, sizeof(hw_version)) &&
+	    cached_imei != m_prepare_imei) {
+		LOG_WRN("IMEI changed (was %llu), dropping cache",
+			(unsigned long long)cached_imei);
 
-	char sw_version[64] = {0};
-	ret = hio_lte_talk_at_shortswver(sw_version, sizeof(sw_version));
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_shortswver` failed: %d", ret);
-		return ret;
+		int ret = hio_lte_cache_invalidate();
+		if (ret) {
+			LOG_WRN("Call `hio_lte_cache_invalidate` failed: %d", ret);
+		}
+
+		/* Empty HW version makes the next step read it again */
+		hio_lte_cache_set_identity(m_prepare_imei, "");
 	}
 
-	LOG_INF("SW version: %s", sw_version);
+	m_prepare_imei_checked = true;
 
-	ret = hio_lte_talk_at_xpofwarn(1, 30);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xpofwarn` failed: %d", ret);
-		return ret;
-	}
+	return 0;
+}
 
-	ret = hio_lte_talk_at_xtemphighlvl(70);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xtemphighlvl` failed: %d", ret);
-		return ret;
-	}
+static int prepare_hwversion_handle(const char *value)
+{
+	LOG_INF("HW version: %s", value);
 
-	ret = hio_lte_talk_at_xtemp(1);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xtemp` failed: %d", ret);
-		return ret;
-	}
+	hio_lte_cache_set_identity(m_prepare_imei, value);
 
-	int gnss_mode = 0;
+	return 0;
+}
+
+static int prepare_xsystemmode_build(char *buf, size_t size)
+{
+	/* The GNSS receiver is only activated with XSYSTEMMODE allowing it */
+	int gnss_mode = IS_ENABLED(CONFIG_HIO_LTE_GNSS) ? 1 : 0;
 
 	char *pos_let_m = strstr(g_hio_lte_config.mode, "lte-m");
 	char *pos_nb_iot = strstr(g_hio_lte_config.mode, "nb-iot");
@@ -312,164 +418,240 @@ int hio_lte_flow_prepare(void)
 		preference = pos_let_m < pos_nb_iot ? 1 : 2;
 	}
 
-	ret = hio_lte_talk_at_xsystemmode(lte_m_mode, nb_iot_mode, gnss_mode, preference);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xsystemmode` failed: %d", ret);
-		return ret;
-	}
+	snprintf(buf, size, "AT%%XSYSTEMMODE=%d,%d,%d,%d", lte_m_mode, nb_iot_mode, gnss_mode,
+		 preference);
 
-	ret = hio_lte_talk_at_cmd("AT%XEPCO=0");
-	if (ret) {
-		LOG_ERR("Call `AT%%XEPCO=0` failed: %d", ret);
-		return ret;
-	}
+	return 0;
+}
 
-	ret = hio_lte_talk_at_xdataprfl(0);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xdataprfl` failed: %d", ret);
-		return ret;
-	}
+/* Last-good cell read at the start of each prepare */
+static struct hio_lte_hint m_prepare_hint;
+static bool m_prepare_hint_valid;
 
-	if (!strlen(g_hio_lte_config.bands)) {
-		ret = hio_lte_talk_at_xbandlock(0, NULL);
-	} else {
-		char bands[] = "00000000000000000000000000000000000000000000000000000000000"
-			       "000000000"
-			       "00000000000000000000";
+/* Configured band lock, narrowed to the band of the last cell if @p narrow */
+static int build_xbandlock(char *buf, size_t size, bool narrow)
+{
+	int ret;
+
+	char bands[] = "00000000000000000000000000000000000000000000000000000000000"
+		       "000000000"
+		       "00000000000000000000";
 
+	size_t len = strlen(bands);
+	bool configured = strlen(g_hio_lte_config.bands) > 0;
+
+	if (configured) {
 		ret = fill_bands(bands);
 		if (ret) {
 			LOG_ERR("Call `fill_bands` failed: %d", ret);
 			return ret;
 		}
-		ret = hio_lte_talk_at_xbandlock(1, bands);
-	}
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xbandlock` failed: %d", ret);
-		return ret;
 	}
 
-	ret = hio_lte_talk_at_xsim(1);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xsim` failed: %d", ret);
-		return ret;
-	}
+	/* Narrow to the band of the last cell, as long as it is one we may use */
+	int band = m_prepare_hint.band;
+	if (narrow && m_prepare_hint_valid && band > 0 && (size_t)band <= len &&
+	    (!configured || bands[len - band] == '1')) {
+		memset(bands, '0', len);
+		bands[len - band] = '1';
 
-	ret = hio_lte_talk_at_xnettime(1, NULL);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xnettime` failed: %d", ret);
-		return ret;
-	}
+		LOG_INF("Band lock narrowed to band %d (last cell)", band);
 
-	ret = hio_lte_talk_at_mdmev(1);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_mdmev` failed: %d", ret);
-		return ret;
-	}
+		hio_lte_hint_set_applied(true);
 
-	/* Enable RAI with notifications */
-	ret = hio_lte_talk_at_rai(2);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_rai` failed: %d", ret);
-		return ret;
-	}
+		snprintf(buf, size, "AT%%XBANDLOCK=1,\"%s\"", bands);
 
-	ret = hio_lte_talk_at_cpsms((int[]){1}, "00111000", "00000000");
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cpsms` failed: %d", ret);
-		return ret;
+		return 0;
 	}
 
-	ret = hio_lte_talk_at_ceppi(1);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_ceppi` failed: %d", ret);
-		return ret;
+	if (!configured) {
+		snprintf(buf, size, "AT%%XBANDLOCK=0");
+		return 0;
 	}
 
-	ret = hio_lte_talk_at_cereg(5);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cereg` failed: %d", ret);
-		return ret;
-	}
+	snprintf(buf, size, "AT%%XBANDLOCK=1,\"%s\"", bands);
 
-	ret = hio_lte_talk_at_cgerep(1);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cgerep` failed: %d", ret);
-		return ret;
-	}
+	return 0;
+}
 
-	ret = hio_lte_talk_at_cmee(1);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cmee` failed: %d", ret);
-		return ret;
-	}
+static int prepare_xbandlock_build(char *buf, size_t size)
+{
+	return build_xbandlock(buf, size, true);
+}
 
-	ret = hio_lte_talk_at_cnec(24);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cnec` failed: %d", ret);
-		return ret;
-	}
+static struct hio_lte_psm_request m_prepare_psm;
 
-	ret = hio_lte_talk_at_powerclass(
-		g_hio_lte_config.powerclass == HIO_LTE_CONFIG_POWERCLASS_23_DBM ? 3 : 5);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_powerclass` failed: %d", ret);
-		return ret;
-	}
+static int prepare_cpsms_build(char *buf, size_t size)
+{
+	hio_lte_psm_get_request(&m_prepare_psm);
 
-	ret = hio_lte_talk_at_cscon(1);
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cscon` failed: %d", ret);
-		return ret;
+	snprintf(buf, size, "AT+CPSMS=1,\"\",\"\",\"%s\",\"%s\"", m_prepare_psm.tau,
+		 m_prepare_psm.active);
+
+	/* Skipped as cached, so the modem already holds it */
+	if (hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CPSMS, buf)) {
+		hio_lte_psm_set_applied(&m_prepare_psm);
 	}
 
-	if (!strlen(g_hio_lte_config.network)) {
-		ret = hio_lte_talk_at_cops(0, NULL, NULL);
+	return 0;
+}
+
+static int prepare_cpsms_handle(const char *value)
+{
+	hio_lte_psm_set_applied(&m_prepare_psm);
+
+	return 0;
+}
+
+static int prepare_powerclass_build(char *buf, size_t size)
+{
+	snprintf(buf, size, "AT%%POWERCLASS=%d",
+		 g_hio_lte_config.powerclass == HIO_LTE_CONFIG_POWERCLASS_23_DBM ? 3 : 5);
+
+	return 0;
+}
+
+static int prepare_cops_build(char *buf, size_t size)
+{
+	if (!strlen(g_hio_lte_config.network) && m_prepare_hint_valid) {
+		char plmn[6 + 1];
+
+		/* Zero-padded, so a 2-digit MNC of the 001 test network survives the
+		 * integer; real MCCs start at 2 and keep their length anyway */
+		snprintf(plmn, sizeof(plmn), "%05d", m_prepare_hint.plmn);
+
+		LOG_INF("Network selection narrowed to PLMN %s (last cell)", plmn);
+
+		hio_lte_hint_set_applied(true);
+
+		/* Manual with automatic fallback: the modem searches the other
+		 * PLMNs by itself if the hinted one is gone */
+		snprintf(buf, size, "AT+COPS=4,2,\"%s\"", plmn);
+	} else if (!strlen(g_hio_lte_config.network)) {
+		snprintf(buf, size, "AT+COPS=0");
 	} else {
-		ret = hio_lte_talk_at_cops(1, (int[]){2}, g_hio_lte_config.network);
-	}
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cops` failed: %d", ret);
-		return ret;
+		snprintf(buf, size, "AT+COPS=1,2,\"%s\"", g_hio_lte_config.network);
 	}
 
-	/* subscribes modem sleep notifications */
-	ret = hio_lte_talk_at_xmodemsleep(1, (int[]){500}, (int[]){10240});
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_xmodemsleep` failed: %d", ret);
-		return ret;
-	}
+	return 0;
+}
 
+static int prepare_cgdcont_build(char *buf, size_t size)
+{
 	if (!strlen(g_hio_lte_config.apn)) {
-		ret = hio_lte_talk_at_cgdcont(0, "IP", NULL);
+		snprintf(buf, size, "AT+CGDCONT=0,\"IP\"");
 	} else {
-		ret = hio_lte_talk_at_cgdcont(0, "IP", g_hio_lte_config.apn);
-	}
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cgdcont` failed: %d", ret);
-		return ret;
+		snprintf(buf, size, "AT+CGDCONT=0,\"IP\",\"%s\"", g_hio_lte_config.apn);
 	}
 
+	return 0;
+}
+
+static int prepare_cgauth_build(char *buf, size_t size)
+{
 	if (g_hio_lte_config.auth == HIO_LTE_CONFIG_AUTH_PAP ||
 	    g_hio_lte_config.auth == HIO_LTE_CONFIG_AUTH_CHAP) {
 		int protocol = g_hio_lte_config.auth == HIO_LTE_CONFIG_AUTH_PAP ? 1 : 2;
-		ret = hio_lte_talk_at_cgauth(0, &protocol, g_hio_lte_config.username,
-					     g_hio_lte_config.password);
-		if (ret) {
-			LOG_ERR("Call `hio_lte_talk_at_cgauth` failed: %d", ret);
-			return ret;
-		}
+		snprintf(buf, size, "AT+CGAUTH=0,%d,\"%s\",\"%s\"", protocol,
+			 g_hio_lte_config.username, g_hio_lte_config.password);
 	} else {
-		ret = hio_lte_talk_at_cgauth(0, (int[]){0}, NULL, NULL);
-		if (ret) {
-			LOG_ERR("Call `hio_lte_talk_at_cgauth` failed: %d", ret);
-			return ret;
-		}
+		snprintf(buf, size, "AT+CGAUTH=0,0");
 	}
 
 	return 0;
 }
 
+/* Steps with .cache set live in the modem NVM; they are only written when the
+ * command differs from what was applied last time with the same modem FW (see
+ * hio_lte_cache.h) */
+static const struct hio_lte_plan_step m_prepare_plan[] = {
+	{.name = "cfun", .cmd = "AT+CFUN=0", .handle = prepare_cfun_0_handle},
+	{.name = "shortswver",
+	 .cmd = "AT%SHORTSWVER",
+	 .expect = "%SHORTSWVER: ",
+	 .handle = prepare_shortswver_handle},
+	{.name = "cgsn",
+	 .cmd = "AT+CGSN=1",
+	 .expect = "+CGSN: ",
+	 .handle = prepare_cgsn_handle,
+	 .skip = prepare_cgsn_skip},
+	{.name = "hwversion",
+	 .cmd = "AT%HWVERSION",
+	 .expect = "%HWVERSION: ",
+	 .handle = prepare_hwversion_handle,
+	 .skip = prepare_identity_cached},
+	{.name = "xpofwarn", .cmd = "AT%XPOFWARN=1,30", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "xtemphighlvl", .cmd = "AT%XTEMPHIGHLVL=70", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "xtemp", .cmd = "AT%XTEMP=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "xsystemmode",
+	 .build = prepare_xsystemmode_build,
+	 .cache = HIO_LTE_CACHE_ITEM_XSYSTEMMODE},
+	{.name = "xepco", .cmd = "AT%XEPCO=0", .cache = HIO_LTE_CACHE_ITEM_XEPCO},
+	{.name = "xdataprfl", .cmd = "AT%XDATAPRFL=0", .cache = HIO_LTE_CACHE_ITEM_XDATAPRFL},
+	{.name = "xbandlock",
+	 .build = prepare_xbandlock_build,
+	 .cache = HIO_LTE_CACHE_ITEM_XBANDLOCK},
+	{.name = "xsim", .cmd = "AT%XSIM=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "xnettime", .cmd = "AT%XNETTIME=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "mdmev", .cmd = "AT%MDMEV=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	/* Enable RAI with notifications */
+	{.name = "rai", .cmd = "AT%RAI=2", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "cpsms",
+	 .build = prepare_cpsms_build,
+	 .handle = prepare_cpsms_handle,
+	 .cache = HIO_LTE_CACHE_ITEM_CPSMS},
+	{.name = "ceppi", .cmd = "AT+CEPPI=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "cereg", .cmd = "AT+CEREG=5", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "cgerep", .cmd = "AT+CGEREP=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "cmee", .cmd = "AT+CMEE=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "cnec", .cmd = "AT+CNEC=24", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "powerclass", .build = prepare_powerclass_build},
+	{.name = "cscon", .cmd = "AT+CSCON=1", .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "cops", .build = prepare_cops_build},
+	/* Subscribes modem sleep notifications */
+	{.name = "xmodemsleep",
+	 .cmd = "AT%XMODEMSLEEP=1,500,10240",
+	 .flags = HIO_LTE_PLAN_FLAG_QUIET},
+	{.name = "cgdcont", .build = prepare_cgdcont_build, .cache = HIO_LTE_CACHE_ITEM_CGDCONT},
+	/* Quiet keeps the credentials out of the default log */
+	{.name = "cgauth",
+	 .build = prepare_cgauth_build,
+	 .cache = HIO_LTE_CACHE_ITEM_CGAUTH,
+	 .flags = HIO_LTE_PLAN_FLAG_QUIET},
+};
+
+int hio_lte_flow_prepare(void)
+{
+	m_prepare_hint_valid = !hio_lte_hint_get(&m_prepare_hint);
+
+	/* Set again by the steps that narrow the configuration */
+	hio_lte_hint_set_applied(false);
+
+	return hio_lte_plan_run("prepare", m_prepare_plan, ARRAY_SIZE(m_prepare_plan));
+}
+
+int hio_lte_flow_restore_bands(void)
+{
+	int ret;
+	char cmd[128];
+
+	ret = build_xbandlock(cmd, sizeof(cmd), false);
+	if (ret) {
+		LOG_ERR("Call `build_xbandlock` failed: %d", ret);
+		return ret;
+	}
+
+	ret = hio_lte_talk_at_cmd(cmd);
+	if (ret) {
+		LOG_ERR("Call `hio_lte_talk_at_cmd` failed: %d", ret);
+		return ret;
+	}
+
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_XBANDLOCK, cmd);
+
+	return 0;
+}
+
 int hio_lte_flow_cfun(int cfun)
 {
 	int ret;
@@ -480,6 +662,13 @@ int hio_lte_flow_cfun(int cfun)
 		return ret;
 	}
 
+	if (!cfun) {
+		ret = hio_lte_cache_save();
+		if (ret) {
+			LOG_WRN("Call `hio_lte_cache_save` failed: %d", ret);
+		}
+	}
+
 	return 0;
 }
 
@@ -573,10 +762,29 @@ int hio_lte_flow_sim_fplmn(void)
 static int update_cgdcont(void)
 {
 	int ret;
-	char tmp[200] = {0};
-	int lines = hio_lte_talk_at_cgdcont_q(tmp, sizeof(tmp));
-	char *line = tmp;
-	for (int i = 0; i < lines; i++) {
+	char buf[256];
+
+	ret = hio_lte_talk_at_cgdcont_q(buf, sizeof(buf));
+	if (ret) {
+		LOG_ERR("Call `hio_lte_talk_at_cgdcont_q` failed: %d", ret);
+		return ret;
+	}
+
+	struct hio_lte_resp resp;
+	const char *value;
+	size_t len;
+	char line[128];
+
+	hio_lte_resp_init(&resp, buf);
+
+	/* hio_tok parses up to NUL, so each line is copied out */
+	while ((value = hio_lte_resp_value(&resp, "+CGDCONT: ", &len))) {
+		ret = hio_lte_resp_copy(value, len, line, sizeof(line));
+		if (ret) {
+			LOG_ERR("Call `hio_lte_resp_copy` failed: %d", ret);
+			return ret;
+		}
+
 		ret = hio_lte_parse_cgcont(line, &m_cgdcont);
 		if (ret) {
 			LOG_ERR("Call `hio_lte_parse_cgcont` failed: %d", ret);
@@ -591,13 +799,29 @@ static int update_cgdcont(void)
 		    strlen(m_cgdcont.addr) > 0) {
 			return 0;
 		}
-
-		line = &tmp[strlen(line) + 1]; /* Move to next line */
 	}
+
 	return -EINVAL; /* No CGDCONT found */
 }
 
-static int socket_setup(bool dtls_enabled, bool load_dtls_session)
+static int dtls_conn_load(int fd)
+{
+	int load_dtls = 1;
+	int ret = nrf_setsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CONN_LOAD, &load_dtls,
+				 sizeof(load_dtls));
+	if (ret) {
+		int err = errno;
+		LOG_WRN("Set SEC_DTLS_CONN_LOAD failed: %d (errno %d)", ret, err);
+		return -EIO;
+	}
+
+	LOG_INF("DTLS session restored");
+
+	return 0;
+}
+
+static int socket_setup(int fd, bool dtls_enabled, bool load_dtls_session,
+			struct hio_lte_flow_handshake *handshake)
 {
 	int ret;
 
@@ -612,7 +836,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 		.tv_usec = 0,
 	};
 
-	ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_SNDTIMEO, (const void *)&tv,
+	ret = nrf_setsockopt(fd, NRF_SOL_SOCKET, NRF_SO_SNDTIMEO, (const void *)&tv,
 			     sizeof(struct nrf_timeval));
 	if (ret < 0) {
 		LOG_ERR("Call `nrf_setsockopt` failed: %d", -ret);
@@ -622,7 +846,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 	tv.tv_sec = RESPONSE_TIMEOUT_SEC;
 	tv.tv_usec = 0;
 
-	ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_RCVTIMEO, (const void *)&tv,
+	ret = nrf_setsockopt(fd, NRF_SOL_SOCKET, NRF_SO_RCVTIMEO, (const void *)&tv,
 			     sizeof(struct nrf_timeval));
 	if (ret < 0) {
 		LOG_ERR("Call `nrf_setsockopt` failed: %d", ret);
@@ -632,7 +856,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 	/* Bind socket to the specified PDN context ID */
 	if (m_cgdcont.cid > 0) {
 		LOG_INF("Binding to PDN context ID: %d", m_cgdcont.cid);
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_BINDTOPDN, &m_cgdcont.cid,
+		ret = nrf_setsockopt(fd, NRF_SOL_SOCKET, NRF_SO_BINDTOPDN, &m_cgdcont.cid,
 				     sizeof(m_cgdcont.cid));
 		if (ret < 0) {
 			LOG_ERR("Set BINDTOPDN failed: %d", -ret);
@@ -643,7 +867,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 	if (dtls_enabled) {
 		/* Set up DTLS security tag */
 		nrf_sec_tag_t sec_tags[] = {SEC_TAG};
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_TAG_LIST, sec_tags,
+		ret = nrf_setsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_TAG_LIST, sec_tags,
 				     sizeof(sec_tags));
 		if (ret) {
 			LOG_ERR("Set SEC_TAG_LIST failed: %d", -ret);
@@ -652,7 +876,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 
 		/* Enable DTLS connection ID if configured */
 		int cid_option = NRF_SO_SEC_DTLS_CID_SUPPORTED;
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CID, &cid_option,
+		ret = nrf_setsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CID, &cid_option,
 				     sizeof(cid_option));
 		if (ret) {
 			LOG_ERR("Set SEC_DTLS_CID failed: %d", -ret);
@@ -661,7 +885,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 
 		/* Set DTLS handshake timeout */
 		int timeout = TLS_DTLS_HANDSHAKE_TIMEO_7S;
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_HANDSHAKE_TIMEO,
+		ret = nrf_setsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_HANDSHAKE_TIMEO,
 				     &timeout, sizeof(timeout));
 		if (ret) {
 			LOG_ERR("Set SEC_DTLS_HANDSHAKE_TIMEO failed: %d", -ret);
@@ -670,7 +894,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 
 		/* Set up peer verification */
 		int verify = NRF_SO_SEC_PEER_VERIFY_REQUIRED;
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_PEER_VERIFY, &verify,
+		ret = nrf_setsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_PEER_VERIFY, &verify,
 				     sizeof(verify));
 
 		if (ret) {
@@ -680,7 +904,7 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 
 		/* Enable session caching */
 		int session_cache = NRF_SO_SEC_SESSION_CACHE_ENABLED;
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_SESSION_CACHE,
+		ret = nrf_setsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_SESSION_CACHE,
 				     &session_cache, sizeof(session_cache));
 		if (ret) {
 			LOG_ERR("Set SEC_SESSION_CACHE failed: %d", ret);
@@ -688,15 +912,11 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 		}
 
 		if (load_dtls_session) {
-			/* Load saved DTLS session */
-			int load_dtls = 1;
-			ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CONN_LOAD,
-					     &load_dtls, sizeof(load_dtls));
-			if (ret) {
-				int err = errno;
-				LOG_WRN("Set SEC_DTLS_CONN_LOAD failed: %d (errno %d)", ret, err);
+			/* Load saved DTLS session; a full handshake otherwise */
+			if (dtls_conn_load(fd)) {
+				handshake->load_failed = true;
 			} else {
-				LOG_INF("DTLS session restored");
+				handshake->type = HIO_LTE_FLOW_HANDSHAKE_RESTORED;
 			}
 		}
 	}
@@ -704,28 +924,42 @@ static int socket_setup(bool dtls_enabled, bool load_dtls_session)
 	return 0;
 }
 
-static int open_socket(const struct hio_lte_socket_config *socket_config, bool load_dtls_session)
+static int open_cops_handle(const char *value)
 {
-	int ret;
-	char cops[32] = {0};
-	ret = hio_lte_talk_at_cops_q(cops, sizeof(cops));
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cops_q` failed: %d", ret);
-		return ret;
-	}
-	LOG_INF("COPS: %s", cops);
+	LOG_INF("COPS: %s", value);
+
+	return 0;
+}
 
+static const struct hio_lte_plan_step m_open_plan[] = {
+	{.name = "cops", .cmd = "AT+COPS?", .expect = "+COPS: ", .handle = open_cops_handle},
 	/* Debugging AT commands */
-	hio_lte_talk_at_cmd("AT+CEREG?");
-	hio_lte_talk_at_cmd("AT%XCBAND");
-	hio_lte_talk_at_cmd("AT+CEINFO?");
-	hio_lte_talk_at_cmd("AT+CGATT?");
-	hio_lte_talk_at_cmd("AT+CGACT?");
+	{.name = "cereg", .cmd = "AT+CEREG?", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+	{.name = "xcband", .cmd = "AT%XCBAND", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+	{.name = "ceinfo", .cmd = "AT+CEINFO?", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+	{.name = "cgatt", .cmd = "AT+CGATT?", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+	{.name = "cgact", .cmd = "AT+CGACT?", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+};
+
+static int open_socket(int socket, const struct hio_lte_socket_config *socket_config,
+		       bool load_dtls_session, struct hio_lte_flow_handshake *handshake)
+{
+	int ret;
 
-	ret = update_cgdcont();
-	if (ret) {
-		LOG_ERR("Call `update_cgdcont_param` failed: %d", ret);
-		return ret;
+	memset(handshake, 0, sizeof(*handshake));
+
+	/* The added sockets share the attach and the PDN of the default one */
+	if (socket == HIO_LTE_SOCKET_DEFAULT) {
+		ret = hio_lte_plan_run("open", m_open_plan, ARRAY_SIZE(m_open_plan));
+		if (ret) {
+			return ret;
+		}
+
+		ret = update_cgdcont();
+		if (ret) {
+			LOG_ERR("Call `update_cgdcont_param` failed: %d", ret);
+			return ret;
+		}
 	}
 
 	int protocol = NRF_IPPROTO_UDP;
@@ -733,50 +967,63 @@ static int open_socket(const struct hio_lte_socket_config *socket_config, bool l
 		protocol = NRF_SPROTO_DTLS1v2;
 	}
 
-	m_addr_info.sin_family = NRF_AF_INET;
-	m_addr_info.sin_port = nrf_htons(socket_config->port);
-	if (nrf_inet_pton(m_addr_info.sin_family, socket_config->addr, &m_addr_info.sin_addr) <=
-	    0) {
+	struct nrf_sockaddr_in addr_info = {
+		.sin_family = NRF_AF_INET,
+		.sin_port = nrf_htons(socket_config->port),
+	};
+
+	if (nrf_inet_pton(addr_info.sin_family, socket_config->addr, &addr_info.sin_addr) <= 0) {
 		LOG_ERR("Invalid IP address: %s", socket_config->addr);
 		return -EINVAL;
 	}
 
-	if (m_socket_fd >= 0) {
+	if (m_socket_fds[socket] >= 0) {
 		// NRF_SO_SEC_SESSION_CACHE_PURGE
-		LOG_INF("Closing existing socket: %d", m_socket_fd);
-		nrf_close(m_socket_fd);
-		m_socket_fd = -1;
+		LOG_INF("Closing existing socket: %d", m_socket_fds[socket]);
+		nrf_close(m_socket_fds[socket]);
+		m_socket_fds[socket] = -1;
 	}
 
-	ret = nrf_socket(m_addr_info.sin_family, NRF_SOCK_DGRAM, protocol);
+	ret = nrf_socket(addr_info.sin_family, NRF_SOCK_DGRAM, protocol);
 	if (ret == -1) {
-		LOG_ERR("Call `nrf_socket` failed: %d", ret);
 		ret = -errno;
+		LOG_ERR("Call `nrf_socket` failed: %d", ret);
+		return ret;
 	}
 
-	m_socket_fd = ret;
+	int fd = ret;
 
-	ret = socket_setup(socket_config->dtls_enabled, load_dtls_session);
+	if (socket == HIO_LTE_SOCKET_DEFAULT) {
+		m_dtls_suspended = false;
+	}
+
+	ret = socket_setup(fd, socket_config->dtls_enabled, load_dtls_session, handshake);
 	if (ret < 0) {
-		nrf_close(m_socket_fd);
-		m_socket_fd = -1;
+		nrf_close(fd);
 		LOG_ERR("Creating socket failed: %d", ret);
 		return ret;
 	}
 
-	LOG_INF("Connection to addr: %s, port: %d", socket_config->addr, socket_config->port);
+	LOG_INF("Connection %d to addr: %s, port: %d", socket, socket_config->addr,
+		socket_config->port);
+
+	m_socket_fds[socket] = fd;
+
+	/* The DTLS handshake, if any, runs within the connect */
+	uint32_t connect_start = k_uptime_get_32();
 
-	ret = nrf_connect(m_socket_fd, (struct nrf_sockaddr *)&m_addr_info, sizeof(m_addr_info));
+	ret = nrf_connect(fd, (struct nrf_sockaddr *)&addr_info, sizeof(addr_info));
 	if (ret == -1) {
 		ret = -errno;
 		if (ret == -NRF_EINPROGRESS) {
-			LOG_INF("Connecting: %d", m_socket_fd);
+			LOG_INF("Connecting: %d", fd);
 			k_sleep(K_SECONDS(30));
+			handshake->type = HIO_LTE_FLOW_HANDSHAKE_NONE;
 			return 0;
 		} else if (ret != -NRF_EINPROGRESS) {
 			LOG_ERR("Call `nrf_connect` failed: %d", ret);
-			nrf_close(m_socket_fd);
-			m_socket_fd = -1;
+			nrf_close(fd);
+			m_socket_fds[socket] = -1;
 			return ret;
 		}
 	}
@@ -785,43 +1032,82 @@ static int open_socket(const struct hio_lte_socket_config *socket_config, bool l
 	if (socket_config->dtls_enabled) {
 		/* Get Cipher */
 		nrf_socklen_t optlen = sizeof(ciph);
-		int ret = nrf_getsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_CIPHERSUITE_USED,
-					 &ciph, &optlen);
+		int ret = nrf_getsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_CIPHERSUITE_USED, &ciph,
+					 &optlen);
 		LOG_INF("DTLS Cipher suite used: 0x%04x %s (ret %d)", ciph,
 			hio_lte_str_ciphersuite(ciph), ret);
 
 		int cid_status;
 		optlen = sizeof(cid_status);
-		ret = nrf_getsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CID_STATUS,
-				     &cid_status, &optlen);
+		ret = nrf_getsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CID_STATUS, &cid_status,
+				     &optlen);
 		LOG_INF("DTLS CID status: %d (ret %d)", cid_status, ret);
+
+		handshake->duration_ms = k_uptime_get_32() - connect_start;
+
+		if (handshake->type != HIO_LTE_FLOW_HANDSHAKE_RESTORED) {
+			int status = NRF_SO_SEC_HANDSHAKE_STATUS_FULL;
+			optlen = sizeof(status);
+			ret = nrf_getsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_HANDSHAKE_STATUS,
+					     &status, &optlen);
+			if (ret) {
+				LOG_WRN("Get SEC_HANDSHAKE_STATUS failed: %d", ret);
+			}
+
+			handshake->type = status == NRF_SO_SEC_HANDSHAKE_STATUS_CACHED
+						  ? HIO_LTE_FLOW_HANDSHAKE_RESUMED
+						  : HIO_LTE_FLOW_HANDSHAKE_FULL;
+		}
+
+		LOG_INF("DTLS handshake: %s in %u ms",
+			handshake->type == HIO_LTE_FLOW_HANDSHAKE_FULL      ? "full"
+			: handshake->type == HIO_LTE_FLOW_HANDSHAKE_RESUMED ? "resumed"
+									    : "restored",
+			handshake->duration_ms);
+	}
+
+	/* The state and the MTU describe the default socket */
+	if (socket == HIO_LTE_SOCKET_DEFAULT) {
+		hio_lte_state_set_dtls_ciphersuite_used(ciph);
 	}
-	hio_lte_state_set_dtls_ciphersuite_used(ciph);
 
 	LOG_INF("Connected");
 	return 0;
 }
 
-int hio_lte_flow_open_socket(const struct hio_lte_socket_config *socket_config,
-			     bool load_dtls_session)
+int hio_lte_flow_open_socket(int socket, const struct hio_lte_socket_config *socket_config,
+			     bool load_dtls_session, struct hio_lte_flow_handshake *handshake)
 {
-	return open_socket(socket_config, load_dtls_session);
+	struct hio_lte_flow_handshake unused;
+
+	if (socket < 0 || (size_t)socket >= ARRAY_SIZE(m_socket_fds) || !socket_config) {
+		return -EINVAL;
+	}
+
+	return open_socket(socket, socket_config, load_dtls_session,
+			   handshake ? handshake : &unused);
 }
 
-static int close_socket(bool save_dtls_session)
+static int close_socket(bool save_dtls_session, bool settle)
 {
-	if (m_socket_fd < 0) {
+	int fd = m_socket_fds[HIO_LTE_SOCKET_DEFAULT];
+
+	if (fd < 0) {
 		LOG_DBG("Socket is closed");
 		return 0;
 	}
 	if (save_dtls_session) {
 		int store_dtls = 1;
-		int ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CONN_SAVE,
-					 &store_dtls, sizeof(store_dtls));
+		int ret = nrf_setsockopt(fd, NRF_SOL_SECURE, NRF_SO_SEC_DTLS_CONN_SAVE, &store_dtls,
+					 sizeof(store_dtls));
 		if (ret) {
 			LOG_WRN("Set SEC_DTLS_CONN_SAVE failed: %d", ret);
-		} else {
-			LOG_INF("DTLS session saved");
+			return -EIO;
+		}
+
+		LOG_INF("DTLS session saved");
+		m_dtls_suspended = true;
+		if (settle) {
 			k_sleep(K_MSEC(1000));
 		}
 	}
@@ -832,60 +1118,92 @@ static int close_socket(bool save_dtls_session)
 	return 0;
 }
 
-int hio_lte_flow_close_socket(bool save_dtls_session)
+int hio_lte_flow_close_socket(bool save_dtls_session, bool settle)
 {
-	return close_socket(save_dtls_session);
+	return close_socket(save_dtls_session, settle);
 }
 
-int hio_lte_flow_check(void)
+int hio_lte_flow_load_dtls_session(void)
 {
-	int ret;
-
-	char resp[128] = {0};
+	int fd = m_socket_fds[HIO_LTE_SOCKET_DEFAULT];
 
-	/* Best-effort: capture the last network release/reject cause so field
-	 * failures (e.g. RRC release with extended wait time) are visible in
-	 * the log and via `lte state`. */
-	ret = hio_lte_talk_at_cmd_with_resp_prefix("AT+CEER", resp, sizeof(resp), "+CEER: ");
-	if (!ret && resp[0] != '\0') {
-		LOG_WRN("CEER: %s", resp);
-		hio_lte_state_set_ceer(resp);
+	if (fd < 0) {
+		return -ENOTCONN;
 	}
 
-	/* Best-effort diagnostics for the China low-throughput case: whether the
-	 * network imposes APN rate control (rate / time_window / remaining block
-	 * time) and the granted eDRX cycle. Raw queries — the full modem
-	 * response is logged via tx:/rx:, no parsing needed yet. */
-	hio_lte_talk_at_cmd("AT%APNRATECTRL=0,0");
-	hio_lte_talk_at_cmd("AT+CEDRXRDP");
+	if (!m_dtls_suspended) {
+		return -EALREADY;
+	}
 
-	/* Check functional mode */
-	ret = hio_lte_talk_at_cmd_with_resp_prefix("AT+CFUN?", resp, sizeof(resp), "+CFUN: ");
+	int ret = dtls_conn_load(fd);
 	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cmd_with_resp_prefix` AT+CFUN? failed: %d", ret);
 		return ret;
 	}
 
-	if (strcmp(resp, "1") != 0) {
-		LOG_ERR("Unexpected CFUN response: %s", resp);
-		return -ENODEV;
+	m_dtls_suspended = false;
+
+	return 0;
+}
+
+int hio_lte_flow_remove_socket(int socket)
+{
+	if (socket <= HIO_LTE_SOCKET_DEFAULT || (size_t)socket >= ARRAY_SIZE(m_socket_fds)) {
+		return -EINVAL;
 	}
 
-	/* Check network registration status */
-	ret = hio_lte_talk_at_cmd_with_resp_prefix("AT+CEREG?", resp, sizeof(resp), "+CEREG: ");
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cmd_with_resp_prefix` AT+CEREG? failed: %d", ret);
-		return ret;
+	if (m_socket_fds[socket] >= 0) {
+		LOG_INF("Closing socket %d: %d", socket, m_socket_fds[socket]);
+		nrf_close(m_socket_fds[socket]);
+		m_socket_fds[socket] = -1;
+	}
+
+	return 0;
+}
+
+bool hio_lte_flow_is_socket_open(int socket)
+{
+	if (socket < 0 || (size_t)socket >= ARRAY_SIZE(m_socket_fds)) {
+		return false;
+	}
+
+	return m_socket_fds[socket] >= 0;
+}
+
+static int check_ceer_handle(const char *value)
+{
+	/* Best-effort: capture the last network release/reject cause so field
+	 * failures (e.g. RRC release with extended wait time) are visible in
+	 * the log and via `lte state`. */
+	if (value[0] != '\0') {
+		LOG_WRN("CEER: %s", value);
+		hio_lte_state_set_ceer(value);
 	}
 
-	if (resp[0] == '0') {
+	return 0;
+}
+
+static int check_cfun_handle(const char *value)
+{
+	if (strcmp(value, "1") != 0) {
+		LOG_ERR("Unexpected CFUN response: %s", value);
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+static int check_cereg_handle(const char *value)
+{
+	int ret;
+
+	if (value[0] == '0') {
 		LOG_ERR("CEREG unsubscribe unsolicited result codes");
 		return -EOPNOTSUPP;
 	}
 
 	struct hio_lte_cereg_param cereg_param;
 
-	ret = hio_lte_parse_urc_cereg(resp + 2, &cereg_param);
+	ret = hio_lte_parse_urc_cereg(value + 2, &cereg_param);
 	if (ret) {
 		LOG_WRN("Call `hio_lte_parse_urc_cereg` failed: %d", ret);
 		return ret;
@@ -895,61 +1213,108 @@ int hio_lte_flow_check(void)
 
 	if (cereg_param.stat != HIO_LTE_CEREG_PARAM_STAT_REGISTERED_HOME &&
 	    cereg_param.stat != HIO_LTE_CEREG_PARAM_STAT_REGISTERED_ROAMING) {
-		LOG_ERR("Unexpected CEREG response: %s", resp);
+		LOG_ERR("Unexpected CEREG response: %s", value);
 		return -ENETUNREACH;
 	}
 
-	/* Check if PDN is active */
-	ret = hio_lte_talk_at_cmd_with_resp_prefix("AT+CGATT?", resp, sizeof(resp), "+CGATT: ");
-	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cmd_with_resp_prefix` AT+CGATT? failed: %d", ret);
-		return ret;
-	}
+	return 0;
+}
 
-	if (strcmp(resp, "1") != 0) {
-		LOG_ERR("Unexpected CGATT response: %s", resp);
+static int check_cgatt_handle(const char *value)
+{
+	if (strcmp(value, "1") != 0) {
+		LOG_ERR("Unexpected CGATT response: %s", value);
 		return -ENETDOWN;
 	}
 
+	return 0;
+}
+
+static int check_cgact_handle(const char *value)
+{
+	if (strcmp(value, "0,1") != 0) {
+		LOG_ERR("Unexpected CGACT response: %s", value);
+		return -ENOTCONN;
+	}
+
+	return 0;
+}
+
+static const struct hio_lte_plan_step m_check_plan[] = {
+	{.name = "ceer",
+	 .cmd = "AT+CEER",
+	 .expect = "+CEER: ",
+	 .handle = check_ceer_handle,
+	 .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+	/* Best-effort diagnostics for the China low-throughput case: whether the
+	 * network imposes APN rate control (rate / time_window / remaining block
+	 * time) and the granted eDRX cycle. Raw queries — the full modem
+	 * response is logged via tx:/rx:, no parsing needed yet. */
+	{.name = "apnratectrl", .cmd = "AT%APNRATECTRL=0,0", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+	{.name = "cedrxrdp", .cmd = "AT+CEDRXRDP", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+	/* Check functional mode */
+	{.name = "cfun", .cmd = "AT+CFUN?", .expect = "+CFUN: ", .handle = check_cfun_handle},
+	/* Check network registration status */
+	{.name = "cereg", .cmd = "AT+CEREG?", .expect = "+CEREG: ", .handle = check_cereg_handle},
+	/* Check if PDN is active */
+	{.name = "cgatt", .cmd = "AT+CGATT?", .expect = "+CGATT: ", .handle = check_cgatt_handle},
 	/* Check PDN connections */
-	ret = hio_lte_talk_at_cmd_with_resp_prefix("AT+CGACT?", resp, sizeof(resp), "+CGACT: ");
+	{.name = "cgact", .cmd = "AT+CGACT?", .expect = "+CGACT: ", .handle = check_cgact_handle},
+	{.name = "cgpaddr", .cmd = "AT+CGPADDR=0", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+};
+
+int hio_lte_flow_check(void)
+{
+	int ret;
+
+	ret = hio_lte_plan_run("check", m_check_plan, ARRAY_SIZE(m_check_plan));
 	if (ret) {
-		LOG_ERR("Call `hio_lte_talk_at_cmd_with_resp_prefix` AT+CGACT? failed: %d", ret);
 		return ret;
 	}
 
-	if (strcmp(resp, "0,1") != 0) {
-		LOG_ERR("Unexpected CGACT response: %s", resp);
-		return -ENOTCONN;
-	}
-
-	hio_lte_talk_at_cmd("AT+CGPADDR=0");
+	int fd = m_socket_fds[HIO_LTE_SOCKET_DEFAULT];
 
-	if (m_socket_fd < 0) {
+	if (fd < 0) {
 		LOG_ERR("Socket is not opened");
 		return -ENOTSOCK;
 	}
 
 	int error;
 	nrf_socklen_t len = sizeof(error);
-	ret = nrf_getsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_ERROR, &error, &len);
+	ret = nrf_getsockopt(fd, NRF_SOL_SOCKET, NRF_SO_ERROR, &error, &len);
 	if (ret != 0 || error != 0) {
 		LOG_ERR("Socket error: %d (ret %d)", error, ret);
 		return -ENOTSOCK;
 	}
 
+	/* A broken added socket is closed rather than failing the check: it is
+	 * reopened before its next send and the default socket stays usable */
+	for (int i = HIO_LTE_SOCKET_DEFAULT + 1; i < CONFIG_HIO_LTE_SOCKETS_MAX; i++) {
+		if (m_socket_fds[i] < 0) {
+			continue;
+		}
+
+		len = sizeof(error);
+		ret = nrf_getsockopt(m_socket_fds[i], NRF_SOL_SOCKET, NRF_SO_ERROR, &error, &len);
+		if (ret != 0 || error != 0) {
+			LOG_WRN("Socket %d error: %d (ret %d), closing", i, error, ret);
+			nrf_close(m_socket_fds[i]);
+			m_socket_fds[i] = -1;
+		}
+	}
+
 	return 0;
 }
 
-int hio_lte_flow_set_sndtimeo(int timeout_sec)
+int hio_lte_flow_set_sndtimeo(int socket, int timeout_sec)
 {
 	struct nrf_timeval tv = {
 		.tv_sec = timeout_sec,
 		.tv_usec = 0,
 	};
 
-	int ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_SNDTIMEO, (const void *)&tv,
-				 sizeof(struct nrf_timeval));
+	int ret = nrf_setsockopt(m_socket_fds[socket], NRF_SOL_SOCKET, NRF_SO_SNDTIMEO,
+				 (const void *)&tv, sizeof(struct nrf_timeval));
 	if (ret < 0) {
 		LOG_ERR("Call `nrf_setsockopt` SNDTIMEO failed: %d", -ret);
 		return ret;
@@ -961,6 +1326,7 @@ int hio_lte_flow_set_sndtimeo(int timeout_sec)
 int hio_lte_flow_send(const struct hio_lte_send_recv_param *param)
 {
 	int ret;
+	int fd = m_socket_fds[param->socket];
 
 	/* Always rewrite the RAI option: a value armed by a previous exchange
 	 * (ONE_RESP/LAST) would otherwise stick to the socket and make the
@@ -973,7 +1339,7 @@ int hio_lte_flow_send(const struct hio_lte_send_recv_param *param)
 	} else {
 		option = NRF_RAI_ONGOING;
 	}
-	ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_RAI, &option, sizeof(option));
+	ret = nrf_setsockopt(fd, NRF_SOL_SOCKET, NRF_SO_RAI, &option, sizeof(option));
 	if (ret) {
 		LOG_ERR("Call `nrf_setsockopt` failed: %d", -ret);
 		return ret;
@@ -991,7 +1357,7 @@ int hio_lte_flow_send(const struct hio_lte_send_recv_param *param)
 	 * One datagram per call: on a UDP socket nrf_send transmits the whole
 	 * datagram or fails, so a single send maps to a single FLAP packet on
 	 * the wire. */
-	ssize_t sentb = nrf_send(m_socket_fd, param->send_buf, param->send_len, NRF_MSG_WAITACK);
+	ssize_t sentb = nrf_send(fd, param->send_buf, param->send_len, NRF_MSG_WAITACK);
 	if (sentb == -1) {
 		ret = -errno;
 		if (ret == -NRF_EAGAIN) {
@@ -1008,7 +1374,7 @@ int hio_lte_flow_send(const struct hio_lte_send_recv_param *param)
 
 	if (param->rai && !param->recv_buf) {
 		option = NRF_RAI_NO_DATA;
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_RAI, &option,
+		ret = nrf_setsockopt(fd, NRF_SOL_SOCKET, NRF_SO_RAI, &option,
 				     sizeof(option));
 		if (ret) {
 			LOG_ERR("Call `nrf_setsockopt` failed: %d", -ret);
@@ -1029,34 +1395,45 @@ int hio_lte_flow_recv(const struct hio_lte_send_recv_param *param)
 		return -EINVAL;
 	}
 
+	int fd = m_socket_fds[param->socket];
+
 	struct hio_lte_cereg_param cereg = {0};
 	hio_lte_state_get_cereg_param(&cereg);
 
+	/* The static rules only until the cell or its technology has replies */
+	int timeout_ms = hio_lte_rtt_get_timeout_ms(&cereg);
+	if (timeout_ms < 0) {
+		timeout_ms = hio_lte_util_recv_timeout_sec(&cereg) * MSEC_PER_SEC;
+	}
+
 	struct nrf_timeval tv = {
-		.tv_sec = hio_lte_util_recv_timeout_sec(&cereg),
-		.tv_usec = 0,
+		.tv_sec = timeout_ms / MSEC_PER_SEC,
+		.tv_usec = (timeout_ms % MSEC_PER_SEC) * USEC_PER_MSEC,
 	};
 
-	ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_RCVTIMEO, (const void *)&tv,
+	ret = nrf_setsockopt(fd, NRF_SOL_SOCKET, NRF_SO_RCVTIMEO, (const void *)&tv,
 			     sizeof(struct nrf_timeval));
 	if (ret < 0) {
 		LOG_ERR("Call `nrf_setsockopt` failed: %d", -ret);
-		nrf_close(m_socket_fd);
-		m_socket_fd = -1;
+		nrf_close(fd);
+		m_socket_fds[param->socket] = -1;
 		return ret;
 	}
 
-	LOG_INF("Receiving data from socket_fd %d, expecting up to %u bytes, timeout %lld s",
-		m_socket_fd, param->recv_size, (long long)tv.tv_sec);
+	LOG_INF("Receiving data from socket_fd %d, expecting up to %u bytes, timeout %d ms",
+		fd, param->recv_size, timeout_ms);
+
+	uint32_t start = k_uptime_get_32();
 
 	ssize_t readb =
-		nrf_recv(m_socket_fd, (void *)((uint8_t *)param->recv_buf + *param->recv_len),
+		nrf_recv(fd, (void *)((uint8_t *)param->recv_buf + *param->recv_len),
 			 param->recv_size - *param->recv_len, 0);
 	if (readb < 0) {
 		ret = -errno;
 
 		if (ret == -NRF_EAGAIN) {
 			LOG_ERR("Receive operation timed out");
+			hio_lte_rtt_timeout(&cereg, timeout_ms);
 			return -ETIMEDOUT;
 		} else if (ret == -NRF_ECONNREFUSED) {
 			LOG_ERR("Connection refused");
@@ -1073,6 +1450,8 @@ int hio_lte_flow_recv(const struct hio_lte_send_recv_param *param)
 		LOG_INF("Received %zd bytes", readb);
 		*param->recv_len += readb;
 
+		hio_lte_rtt_add(&cereg, k_uptime_get_32() - start);
+
 		if (*param->recv_len >= param->recv_size) {
 			LOG_INF("Received all expected data");
 		}
@@ -1080,7 +1459,7 @@ int hio_lte_flow_recv(const struct hio_lte_send_recv_param *param)
 
 	if (param->rai) {
 		int option = NRF_RAI_NO_DATA;
-		ret = nrf_setsockopt(m_socket_fd, NRF_SOL_SOCKET, NRF_SO_RAI, &option,
+		ret = nrf_setsockopt(fd, NRF_SOL_SOCKET, NRF_SO_RAI, &option,
 				     sizeof(option));
 		if (ret) {
 			LOG_ERR("Call `nrf_setsockopt` failed: %d", -ret);
@@ -1094,7 +1473,7 @@ int hio_lte_flow_coneval(void)
 {
 	int ret;
 
-	char buf[128] = {0};
+	char buf[128];
 
 	ret = hio_lte_talk_at_coneval(buf, sizeof(buf));
 	if (ret) {
@@ -1102,9 +1481,28 @@ int hio_lte_flow_coneval(void)
 		return ret;
 	}
 
+	struct hio_lte_resp resp;
+
+	hio_lte_resp_init(&resp, buf);
+
+	size_t len;
+	const char *value = hio_lte_resp_value(&resp, "%CONEVAL: ", &len);
+	if (!value) {
+		LOG_ERR("Missing %%CONEVAL response");
+		return -EILSEQ;
+	}
+
+	char line[128];
+
+	ret = hio_lte_resp_copy(value, len, line, sizeof(line));
+	if (ret) {
+		LOG_ERR("Call `hio_lte_resp_copy` failed: %d", ret);
+		return ret;
+	}
+
 	struct hio_lte_conn_param conn_params;
 
-	ret = hio_lte_parse_coneval(buf, &conn_params);
+	ret = hio_lte_parse_coneval(line, &conn_params);
 	if (ret) {
 		LOG_ERR("Failed to parse coneval: %d", ret);
 		return ret;
@@ -1118,6 +1516,46 @@ int hio_lte_flow_coneval(void)
 
 	hio_lte_state_set_conn_param(&conn_params);
 
+	if (conn_params.valid) {
+		struct hio_lte_hint hint = {
+			.plmn = conn_params.plmn,
+			.band = conn_params.band,
+			.earfcn = conn_params.earfcn,
+		};
+
+		ret = hio_lte_hint_update(&hint);
+		if (ret) {
+			LOG_WRN("Call `hio_lte_hint_update` failed: %d", ret);
+		}
+	}
+
+	return 0;
+}
+
+int hio_lte_flow_psm_update(void)
+{
+	int ret;
+
+	struct hio_lte_psm_request req;
+
+	hio_lte_psm_get_request(&req);
+
+	LOG_INF("Requesting TAU %d s, active time %d s", req.tau_s, req.active_s);
+
+	int mode = 1;
+	ret = hio_lte_talk_at_cpsms(&mode, req.tau, req.active);
+	if (ret) {
+		LOG_ERR("Call `hio_lte_talk_at_cpsms` failed: %d", ret);
+		return ret;
+	}
+
+	/* Same command as the prepare step, so the next prepare finds it cached */
+	char cmd[64];
+	snprintf(cmd, sizeof(cmd), "AT+CPSMS=1,\"\",\"\",\"%s\",\"%s\"", req.tau, req.active);
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_CPSMS, cmd);
+
+	hio_lte_psm_set_applied(&req);
+
 	return 0;
 }
 
@@ -1236,13 +1674,33 @@ struct hio_lte_attach_timeout hio_lte_flow_attach_policy_progressive(int attempt
 
 int hio_lte_flow_init(HIO_LTE_FSM_EVENT_delegate_cb cb)
 {
-	m_socket_fd = -1;
+	for (size_t i = 0; i < ARRAY_SIZE(m_socket_fds); i++) {
+		m_socket_fds[i] = -1;
+	}
 
 	m_event_delegate_cb = cb;
 
+	int ret = hio_lte_urc_init();
+	if (ret) {
+		LOG_ERR("Call `hio_lte_urc_init` failed: %d", ret);
+		return ret;
+	}
+
 	hio_lte_talk_init(process_urc, NULL);
 
-	int ret = nrf_modem_lib_init();
+	ret = hio_lte_cache_init();
+	if (ret) {
+		LOG_WRN("Call `hio_lte_cache_init` failed: %d", ret);
+	}
+
+	hio_lte_psm_init();
+
+	ret = hio_lte_hint_init();
+	if (ret) {
+		LOG_WRN("Call `hio_lte_hint_init` failed: %d", ret);
+	}
+
+	ret = nrf_modem_lib_init();
 	if (ret) {
 		LOG_ERR("Call `nrf_modem_lib_init` failed: %d", ret);
 		return ret;
@@ -37,6 +37,7 @@ enum hio_lte_fsm_event {
 	HIO_LTE_FSM_EVENT_NCELLMEAS,
 	HIO_LTE_FSM_EVENT_SOCKET_RECONFIG,
 	HIO_LTE_FSM_EVENT_DISABLE,
+	HIO_LTE_FSM_EVENT_RAI,
 	HIO_LTE_FSM_EVENT_COUNT /* Must be last */
 };
 
@@ -48,26 +49,61 @@ struct hio_lte_attach_timeout {
 	k_timeout_t retry_delay;    /**< Delay before the *next* attempt (after a failure). */
 };
 
-typedef void (*HIO_LTE_FSM_EVENT_delegate_cb)(enum hio_lte_fsm_event event);
+/* @p data is the event payload (see struct hio_lte_evq_item) or NULL */
+typedef void (*HIO_LTE_FSM_EVENT_delegate_cb)(enum hio_lte_fsm_event event, const void *data);
 
 int hio_lte_flow_init(HIO_LTE_FSM_EVENT_delegate_cb cb);
 int hio_lte_flow_start(void);
 int hio_lte_flow_stop(void);
 
 int hio_lte_flow_prepare(void);
+/* Undo the band lock narrowed by the attach hint */
+int hio_lte_flow_restore_bands(void);
 int hio_lte_flow_cfun(int cfun);
 int hio_lte_flow_sim_info(void);
 int hio_lte_flow_sim_fplmn(void);
-int hio_lte_flow_open_socket(const struct hio_lte_socket_config *socket_config,
-			     bool load_dtls_session);
-int hio_lte_flow_close_socket(bool save_dtls_session);
+/* How the DTLS connection of a socket came up */
+enum hio_lte_flow_handshake_type {
+	/* No DTLS, or the connect is still in progress */
+	HIO_LTE_FLOW_HANDSHAKE_NONE = 0,
+	/* Saved connection loaded, nothing sent */
+	HIO_LTE_FLOW_HANDSHAKE_RESTORED,
+	/* Abbreviated handshake on the cached session */
+	HIO_LTE_FLOW_HANDSHAKE_RESUMED,
+	HIO_LTE_FLOW_HANDSHAKE_FULL,
+};
+
+struct hio_lte_flow_handshake {
+	enum hio_lte_flow_handshake_type type;
+	/* Duration of the connect */
+	uint32_t duration_ms;
+	/* A saved connection was requested but the modem refused to load it */
+	bool load_failed;
+};
+
+/* @p socket is a handle of hio_lte_send_recv_param; only the default one
+ * refreshes the PDN context and keeps a DTLS session over sleeps. @p handshake
+ * may be NULL */
+int hio_lte_flow_open_socket(int socket, const struct hio_lte_socket_config *socket_config,
+			     bool load_dtls_session, struct hio_lte_flow_handshake *handshake);
+/* Saving leaves the DTLS connection unusable until it is loaded again. With
+ * @p settle it waits a second for the modem to store the session, which is
+ * needed only when the socket or the modem is used right after */
+int hio_lte_flow_close_socket(bool save_dtls_session, bool settle);
+/* Load the saved connection back into the default socket; -EALREADY when it
+ * is usable */
+int hio_lte_flow_load_dtls_session(void);
+int hio_lte_flow_remove_socket(int socket);
+bool hio_lte_flow_is_socket_open(int socket);
 
 int hio_lte_flow_check(void);
-int hio_lte_flow_set_sndtimeo(int timeout_sec);
+int hio_lte_flow_set_sndtimeo(int socket, int timeout_sec);
 int hio_lte_flow_send(const struct hio_lte_send_recv_param *param);
 int hio_lte_flow_recv(const struct hio_lte_send_recv_param *param);
 
 int hio_lte_flow_coneval(void);
+/* Request the PSM timers matching the learned traffic pattern */
+int hio_lte_flow_psm_update(void);
 int hio_lte_flow_cmd(const char *cmd);
 int hio_lte_flow_xmodemtrace(int lvl);
 
@@ -0,0 +1,205 @@
+#include "hio_lte_gnss.h"
+
+/* NRF includes */
+#include <nrf_modem_gnss.h>
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/timeutil.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+LOG_MODULE_REGISTER(hio_lte_gnss, CONFIG_HIO_LTE_LOG_LEVEL);
+
+static HIO_LTE_FSM_EVENT_delegate_cb m_event_delegate_cb;
+
+/* Written by the GNSS event handler (interrupt context) */
+static struct k_spinlock m_lock;
+static struct nrf_modem_gnss_pvt_data_frame m_pvt;
+static bool m_fix_valid;
+static bool m_last_fix_valid;
+static int64_t m_last_fix_ms;
+static atomic_t m_blocked;
+
+static void gnss_event_handler(int event)
+{
+	switch (event) {
+	case NRF_MODEM_GNSS_EVT_FIX: {
+		struct nrf_modem_gnss_pvt_data_frame pvt;
+
+		if (nrf_modem_gnss_read(&pvt, sizeof(pvt), NRF_MODEM_GNSS_DATA_PVT)) {
+			return;
+		}
+
+		if (!(pvt.flags & NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID)) {
+			return;
+		}
+
+		K_SPINLOCK(&m_lock) {
+			m_pvt = pvt;
+			m_fix_valid = true;
+			m_last_fix_valid = true;
+			m_last_fix_ms = k_uptime_get();
+		}
+
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_XGPS, NULL);
+		break;
+	}
+	case NRF_MODEM_GNSS_EVT_SLEEP_AFTER_TIMEOUT:
+		/* The single fix search gave up */
+		m_event_delegate_cb(HIO_LTE_FSM_EVENT_XGPS, NULL);
+		break;
+	case NRF_MODEM_GNSS_EVT_BLOCKED:
+		atomic_inc(&m_blocked);
+		break;
+	default:
+		break;
+	}
+}
+
+int hio_lte_gnss_init(HIO_LTE_FSM_EVENT_delegate_cb cb)
+{
+	if (!cb) {
+		return -EINVAL;
+	}
+
+	m_event_delegate_cb = cb;
+
+	return 0;
+}
+
+int hio_lte_gnss_start(int timeout_sec)
+{
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_HIO_LTE_GNSS)) {
+		return -ENOTSUP;
+	}
+
+	K_SPINLOCK(&m_lock) {
+		m_fix_valid = false;
+	}
+
+	/* The handler is dropped when the modem library shuts down */
+	ret = nrf_modem_gnss_event_handler_set(gnss_event_handler);
+	if (ret) {
+		LOG_ERR("Call `nrf_modem_gnss_event_handler_set` failed: %d", ret);
+		return -EIO;
+	}
+
+	/* Keep the ephemerides for the next search instead of a fresh cold start */
+	ret = nrf_modem_gnss_use_case_set(NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START);
+	if (ret) {
+		LOG_ERR("Call `nrf_modem_gnss_use_case_set` failed: %d", ret);
+		return -EIO;
+	}
+
+	ret = nrf_modem_gnss_fix_interval_set(0);
+	if (ret) {
+		LOG_ERR("Call `nrf_modem_gnss_fix_interval_set` failed: %d", ret);
+		return -EIO;
+	}
+
+	ret = nrf_modem_gnss_fix_retry_set(CLAMP(timeout_sec, 1, UINT16_MAX));
+	if (ret) {
+		LOG_ERR("Call `nrf_modem_gnss_fix_retry_set` failed: %d", ret);
+		return -EIO;
+	}
+
+	ret = nrf_modem_gnss_start();
+	if (ret) {
+		LOG_ERR("Call `nrf_modem_gnss_start` failed: %d", ret);
+		return -EIO;
+	}
+
+	LOG_INF("Search started (%d s, %s start)", timeout_sec,
+		hio_lte_gnss_is_hot() ? "hot" : "cold");
+
+	return 0;
+}
+
+int hio_lte_gnss_stop(void)
+{
+	if (!IS_ENABLED(CONFIG_HIO_LTE_GNSS)) {
+		return -ENOTSUP;
+	}
+
+	int ret = nrf_modem_gnss_stop();
+	if (ret) {
+		/* Not running after a fix or a timeout of the single fix search */
+		LOG_DBG("Call `nrf_modem_gnss_stop` failed: %d", ret);
+	}
+
+	return 0;
+}
+
+int hio_lte_gnss_read_fix(struct hio_lte_gnss_fix *fix)
+{
+	struct nrf_modem_gnss_pvt_data_frame pvt;
+	bool valid;
+
+	if (!fix) {
+		return -EINVAL;
+	}
+
+	K_SPINLOCK(&m_lock) {
+		valid = m_fix_valid;
+		pvt = m_pvt;
+	}
+
+	if (!valid) {
+		return -ENODATA;
+	}
+
+	memset(fix, 0, sizeof(*fix));
+	fix->latitude = pvt.latitude;
+	fix->longitude = pvt.longitude;
+	fix->altitude = pvt.altitude;
+	fix->accuracy = pvt.accuracy;
+	fix->speed = pvt.speed;
+	fix->heading = pvt.heading;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pvt.sv); i++) {
+		if (pvt.sv[i].sv && (pvt.sv[i].flags & NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX)) {
+			fix->satellites++;
+		}
+	}
+
+	struct tm tm = {
+		.tm_year = pvt.datetime.year - 1900,
+		.tm_mon = pvt.datetime.month - 1,
+		.tm_mday = pvt.datetime.day,
+		.tm_hour = pvt.datetime.hour,
+		.tm_min = pvt.datetime.minute,
+		.tm_sec = pvt.datetime.seconds,
+	};
+
+	fix->timestamp = timeutil_timegm64(&tm);
+
+	return 0;
+}
+
+bool hio_lte_gnss_is_hot(void)
+{
+	bool hot;
+
+	K_SPINLOCK(&m_lock) {
+		hot = m_last_fix_valid &&
+		      k_uptime_get() - m_last_fix_ms < (int64_t)CONFIG_HIO_LTE_GNSS_HOT_AGE * 1000;
+	}
+
+	return hot;
+}
+
+uint32_t hio_lte_gnss_get_blocked(void)
+{
+	return (uint32_t)atomic_get(&m_blocked);
+}
@@ -0,0 +1,40 @@
+#ifndef SUBSYS_HIO_LTE_GNSS_H_
+#define SUBSYS_HIO_LTE_GNSS_H_
+
+#include "hio_lte_flow.h"
+
+/* HIO includes */
+#include <hio/hio_lte.h>
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Single fix searches of the modem GNSS receiver. The end of a search is
+ * delegated as HIO_LTE_FSM_EVENT_XGPS; the FSM decides when a search runs. */
+
+int hio_lte_gnss_init(HIO_LTE_FSM_EVENT_delegate_cb cb);
+
+/* Search for one fix, at most @p timeout_sec seconds */
+int hio_lte_gnss_start(int timeout_sec);
+int hio_lte_gnss_stop(void);
+
+/* Fix of the search that ended last; -ENODATA when it timed out. Sets every
+ * field but ttff_ms and hot, which the FSM accounts over the searches */
+int hio_lte_gnss_read_fix(struct hio_lte_gnss_fix *fix);
+
+/* The ephemerides of the last fix still allow a hot start */
+bool hio_lte_gnss_is_hot(void);
+
+/* Times the modem blocked a search for LTE activity */
+uint32_t hio_lte_gnss_get_blocked(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_GNSS_H_ */
@@ -0,0 +1,198 @@
+#include "hio_lte_hint.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#if defined(CONFIG_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_hint, CONFIG_HIO_LTE_LOG_LEVEL);
+
+#define SETTINGS_SUBTREE "hio_lte_hint"
+#define SETTINGS_KEY     SETTINGS_SUBTREE "/data"
+
+/* Bump whenever the layout changes */
+#define HINT_VERSION 1
+
+struct hint_data {
+	uint8_t version;
+	int32_t plmn;
+	int32_t band;
+	int32_t earfcn;
+};
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct hint_data m_data;
+static bool m_rejected;
+static bool m_applied;
+
+static bool is_valid(const struct hio_lte_hint *hint)
+{
+	return hint->plmn > 0 && hint->band > 0 && hint->earfcn >= 0;
+}
+
+#if defined(CONFIG_SETTINGS)
+static int load_direct_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+			  void *param)
+{
+	struct hint_data data;
+
+	if (!settings_name_steq(key, "data", NULL)) {
+		return 0;
+	}
+
+	if (len != sizeof(data)) {
+		LOG_WRN("Size mismatch: expected %zu, got %zu", sizeof(data), len);
+		return 0;
+	}
+
+	int ret = read_cb(cb_arg, &data, len);
+	if (ret < 0) {
+		LOG_ERR("Call `read_cb` failed: %d", ret);
+		return ret;
+	}
+
+	if (data.version != HINT_VERSION) {
+		LOG_WRN("Version mismatch: expected %u, got %u", HINT_VERSION, data.version);
+		return 0;
+	}
+
+	m_data = data;
+
+	return 0;
+}
+#endif
+
+int hio_lte_hint_init(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	memset(&m_data, 0, sizeof(m_data));
+	m_data.version = HINT_VERSION;
+	m_rejected = false;
+	m_applied = false;
+
+#if defined(CONFIG_SETTINGS)
+	int ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Call `settings_subsys_init` failed: %d", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+
+	ret = settings_load_subtree_direct(SETTINGS_SUBTREE, load_direct_cb, NULL);
+	if (ret) {
+		LOG_ERR("Call `settings_load_subtree_direct` failed: %d", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+#endif
+
+	if (m_data.plmn) {
+		LOG_INF("Last cell: PLMN %d, band %d, EARFCN %d", m_data.plmn, m_data.band,
+			m_data.earfcn);
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+int hio_lte_hint_get(struct hio_lte_hint *hint)
+{
+	if (!hint) {
+		return -EINVAL;
+	}
+
+	if (!IS_ENABLED(CONFIG_HIO_LTE_ATTACH_HINT)) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	hint->plmn = m_data.plmn;
+	hint->band = m_data.band;
+	hint->earfcn = m_data.earfcn;
+
+	bool usable = !m_rejected && is_valid(hint);
+
+	k_mutex_unlock(&m_lock);
+
+	return usable ? 0 : -ENOENT;
+}
+
+int hio_lte_hint_update(const struct hio_lte_hint *hint)
+{
+	if (!hint || !is_valid(hint)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_rejected = false;
+
+	if (m_data.plmn == hint->plmn && m_data.band == hint->band &&
+	    m_data.earfcn == hint->earfcn) {
+		k_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+	LOG_INF("New cell: PLMN %d, band %d, EARFCN %d", hint->plmn, hint->band, hint->earfcn);
+
+	m_data.plmn = hint->plmn;
+	m_data.band = hint->band;
+	m_data.earfcn = hint->earfcn;
+
+#if defined(CONFIG_SETTINGS)
+	int ret = settings_save_one(SETTINGS_KEY, &m_data, sizeof(m_data));
+	if (ret) {
+		LOG_ERR("Call `settings_save_one` failed: %d", ret);
+		k_mutex_unlock(&m_lock);
+		return ret;
+	}
+#endif
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+void hio_lte_hint_reject(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (!m_rejected) {
+		LOG_WRN("Attach with the last cell failed, using full configuration");
+	}
+
+	m_rejected = true;
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_hint_set_applied(bool applied)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	m_applied = applied;
+	k_mutex_unlock(&m_lock);
+}
+
+bool hio_lte_hint_is_applied(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	bool applied = m_applied;
+	k_mutex_unlock(&m_lock);
+
+	return applied;
+}
@@ -0,0 +1,41 @@
+#ifndef SUBSYS_HIO_LTE_HINT_H_
+#define SUBSYS_HIO_LTE_HINT_H_
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cell of the last successful attach, persisted across reboots. The next
+ * prepare narrows the band lock and the network selection to it and the
+ * attach falls back to the full configuration if it does not succeed in time.
+ */
+struct hio_lte_hint {
+	int plmn;
+	int band;
+	int earfcn;
+};
+
+int hio_lte_hint_init(void);
+
+/* -ENOENT if there is no hint or it was rejected since the last update */
+int hio_lte_hint_get(struct hio_lte_hint *hint);
+
+/* Remember the serving cell; persisted only when it changed */
+int hio_lte_hint_update(const struct hio_lte_hint *hint);
+
+/* An attach with the hint failed; do not use it until the next update */
+void hio_lte_hint_reject(void);
+
+/* Whether the last prepare narrowed the configuration by the hint */
+void hio_lte_hint_set_applied(bool applied);
+bool hio_lte_hint_is_applied(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_HINT_H_ */
@@ -0,0 +1,58 @@
+#include "hio_lte_hist.h"
+
+/* Zephyr includes */
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+/* Spans an RRC setup on a good LTE-M cell up to a congested NB-IoT attach */
+static const uint32_t m_edges_ms[HIO_LTE_HIST_BUCKETS - 1] = {
+	100, 200, 500, 1000, 2000, 5000, 10000, 20000, 30000, 60000, 120000,
+};
+
+uint32_t hio_lte_hist_edge_ms(int bucket)
+{
+	if (bucket < 0 || (size_t)bucket >= ARRAY_SIZE(m_edges_ms)) {
+		return UINT32_MAX;
+	}
+
+	return m_edges_ms[bucket];
+}
+
+void hio_lte_hist_add(struct hio_lte_hist *hist, uint32_t ms)
+{
+	size_t bucket = 0;
+
+	while (bucket < ARRAY_SIZE(m_edges_ms) && ms >= m_edges_ms[bucket]) {
+		bucket++;
+	}
+
+	hist->buckets[bucket]++;
+	hist->count++;
+	hist->max_ms = MAX(hist->max_ms, ms);
+}
+
+uint32_t hio_lte_hist_percentile_ms(const struct hio_lte_hist *hist, int percent)
+{
+	if (!hist || !hist->count) {
+		return 0;
+	}
+
+	percent = CLAMP(percent, 1, 100);
+
+	/* Rank of the sample the percentile falls on, rounded up */
+	uint64_t rank = ((uint64_t)hist->count * percent + 99) / 100;
+	uint64_t seen = 0;
+
+	for (int i = 0; i < HIO_LTE_HIST_BUCKETS; i++) {
+		seen += hist->buckets[i];
+
+		if (seen >= rank) {
+			return MIN(hio_lte_hist_edge_ms(i), hist->max_ms);
+		}
+	}
+
+	return hist->max_ms;
+}
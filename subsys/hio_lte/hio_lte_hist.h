@@ -0,0 +1,21 @@
+#ifndef SUBSYS_HIO_LTE_HIST_H_
+#define SUBSYS_HIO_LTE_HIST_H_
+
+/* HIO includes */
+#include <hio/hio_lte.h>
+
+/* Standard includes */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Count @p ms in its bucket; the caller serializes access to @p hist */
+void hio_lte_hist_add(struct hio_lte_hist *hist, uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_HIST_H_ */
@@ -71,31 +71,6 @@ static int parse_hex2cellid(char *s, int *cid)
 	return 0;
 }
 
-static int parse_hex2tac(const char *s, uint16_t *tac)
-{
-	if (!s || !tac) {
-		return -EINVAL;
-	}
-
-	size_t len = strlen(s);
-	if (len != 4) {
-		return -EBADMSG;
-	}
-
-	if (!all_hex_digits_ascii(s, len)) {
-		return -EBADMSG;
-	}
-
-	char *endptr;
-	unsigned long val = strtoul(s, &endptr, 16);
-	if (*endptr != '\0' || val > 0xFFFFUL) {
-		return -ERANGE;
-	}
-
-	*tac = (uint16_t)val;
-	return 0;
-}
-
 static int parse_gprs_timer(const char *binary_string, int flag)
 {
 	if (strlen(binary_string) != 8) {
@@ -274,6 +249,7 @@ int hio_lte_parse_urc_cereg(const char *line, struct hio_lte_cereg_param *param)
 	param->cause_type = num;
 
 	if (!(p = hio_tok_sep(p))) {
+		param->valid = true;
 		return 0;
 	}
 
@@ -404,8 +380,6 @@ int hio_lte_parse_urc_rai(const char *line, struct hio_lte_rai_param *param)
 
 int hio_lte_parse_coneval(const char *str, struct hio_lte_conn_param *params)
 {
-	int ret;
-
 	if (!str || !params) {
 		return -EINVAL;
 	}
@@ -415,45 +389,92 @@ int hio_lte_parse_coneval(const char *str, struct hio_lte_conn_param *params)
 	/* 0,1,9,72,22,47,"00094F0C","26806",382,6200,20,0,0,-8,1,1,87*/
 	memset(params, 0, sizeof(*params));
 
-	int result;
-	int energy_estimate;
-	int rsrp;
-	int rsrq;
-	int snr;
-	char cid[8 + 1] = {0};
-	int plmn;
-	int earfcn;
-	int band;
-	int ce_level;
-
-	ret = sscanf(str, "%d,%*d,%d,%d,%d,%d,\"%8[0-9A-F]\",\"%d\",%*d,%d,%d,%*d,%d", &result,
-		     &energy_estimate, &rsrp, &rsrq, &snr, cid, &plmn, &earfcn, &band, &ce_level);
-	if (ret != 1 && ret != 10) {
+	const char *p = str;
+
+	bool def;
+	long result;
+	long num[4];
+	char cid[8 + 1];
+	char plmn[6 + 1];
+	long earfcn;
+	long band;
+	long ce_level;
+
+	if (!(p = hio_tok_num(p, &def, &result)) || !def) {
 		LOG_ERR("Failed to parse coneval");
 		return -EINVAL;
 	}
 
-	params->result = result;
+	params->result = (int)result;
 
+	/* Only the result is reported when the evaluation failed */
 	if (params->result != 0) {
 		return 0;
 	}
 
+	/* rrc_state (skipped), energy_estimate, rsrp, rsrq, snr */
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_num(p, NULL, NULL))) {
+		goto error;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(num); i++) {
+		if (!(p = hio_tok_sep(p)) || !(p = hio_tok_num(p, &def, &num[i])) || !def) {
+			goto error;
+		}
+	}
+
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_str(p, &def, cid, sizeof(cid))) || !def) {
+		goto error;
+	}
+
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_str(p, &def, plmn, sizeof(plmn))) || !def) {
+		goto error;
+	}
+
+	/* phys_cell_id (skipped), earfcn, band, tau_triggered (skipped), ce_level */
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_num(p, NULL, NULL))) {
+		goto error;
+	}
+
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_num(p, &def, &earfcn)) || !def) {
+		goto error;
+	}
+
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_num(p, &def, &band)) || !def) {
+		goto error;
+	}
+
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_num(p, NULL, NULL))) {
+		goto error;
+	}
+
+	if (!(p = hio_tok_sep(p)) || !(p = hio_tok_num(p, &def, &ce_level)) || !def) {
+		goto error;
+	}
+
 	if (parse_hex2cellid(cid, &params->cid) != 0) {
 		return -EINVAL;
 	}
 
-	params->eest = energy_estimate;
-	params->rsrp = rsrp - 140;
-	params->rsrq = (rsrq - 39) / 2;
-	params->snr = snr - 24;
-	params->plmn = plmn;
-	params->earfcn = earfcn;
-	params->band = band;
-	params->ecl = ce_level;
+	if (!plmn[0] || !all_digits_ascii(plmn, strlen(plmn))) {
+		goto error;
+	}
+
+	params->eest = (int)num[0];
+	params->rsrp = (int)num[1] - 140;
+	params->rsrq = ((int)num[2] - 39) / 2;
+	params->snr = (int)num[3] - 24;
+	params->plmn = atoi(plmn);
+	params->earfcn = (int)earfcn;
+	params->band = (int)band;
+	params->ecl = (int)ce_level;
 	params->valid = true;
 
 	return 0;
+
+error:
+	LOG_ERR("Failed to parse coneval");
+	return -EINVAL;
 }
 
 int hio_lte_parse_cgcont(const char *line, struct cgdcont_param *param)
@@ -511,219 +532,385 @@ int hio_lte_parse_cgcont(const char *line, struct cgdcont_param *param)
 	return 0;
 }
 
-static inline int parse_ncellmeas_ncell(const char **p_ptr,
-					struct hio_lte_ncellmeas_ncell_param *cell)
+/*
+ * %NCELLMEAS is the longest URC the modem sends (up to ~1 kB for GCI search
+ * types) and arrives while the modem is busiest, so it is scanned in a single
+ * pass: every field is converted as the cursor moves over it and stored
+ * straight into the destination, without intermediate strings.
+ *
+ * The scanners return -EBADMSG or -EPROTO for a malformed line, which ends the
+ * parsing. -ERANGE means the field is well-formed but its value is not
+ * acceptable; the cursor is past the field, so the parsing goes on and only the
+ * cell (or the neighbor cell) the field belongs to is dropped.
+ */
+
+static inline bool ncellmeas_field_end(char c)
 {
-	/* <n_earfcn>,<n_phys_cell_id>,<n_rsrp>,<n_rsrq>,<n_time_diff> */
-	bool def;
-	const char *p = *p_ptr;
+	return c == ',' || c == '\0' || c == '\r' || c == '\n';
+}
 
-	if (!(p = hio_tok_uint32(p, &def, &cell->earfcn)) || !def) {
-		return -EBADMSG;
+static inline int ncellmeas_hex_digit(char c)
+{
+	if (c >= '0' && c <= '9') {
+		return c - '0';
 	}
 
-	if (!(p = hio_tok_sep(p))) {
+	c |= 0x20;
+
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+
+	return -1;
+}
+
+static inline int ncellmeas_sep(const char **p_ptr)
+{
+	if (**p_ptr != ',') {
 		return -EPROTO;
 	}
 
-	if (!(p = hio_tok_uint16(p, &def, &cell->pci)) || !def) {
+	(*p_ptr)++;
+
+	return 0;
+}
+
+static int ncellmeas_uint(const char **p_ptr, uint32_t max, uint32_t *num)
+{
+	const char *p = *p_ptr;
+	uint32_t value = 0;
+	bool overflow = false;
+
+	if (*p < '0' || *p > '9') {
 		return -EBADMSG;
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
-	}
+	do {
+		uint32_t digit = *p++ - '0';
 
-	long num;
+		if (value > (UINT32_MAX - digit) / 10) {
+			overflow = true;
+		} else {
+			value = value * 10 + digit;
+		}
+	} while (*p >= '0' && *p <= '9');
 
-	if (!(p = hio_tok_num(p, &def, &num)) || !def) {
+	if (!ncellmeas_field_end(*p)) {
 		return -EBADMSG;
 	}
 
-	if (num < -17 || num > 255) {
-		LOG_ERR("ncells RSRP out of range: %ld", num);
+	*p_ptr = p;
+
+	if (overflow || value > max) {
 		return -ERANGE;
 	}
 
-	cell->rsrp = (int16_t)num;
+	if (num) {
+		*num = value;
+	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	return 0;
+}
+
+static int ncellmeas_int(const char **p_ptr, int32_t min, int32_t max, int32_t *num)
+{
+	const char *p = *p_ptr;
+	bool negative = *p == '-';
+	uint32_t value;
+
+	p += negative;
+
+	int ret = ncellmeas_uint(&p, INT32_MAX, &value);
+	if (ret == -EBADMSG) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_num(p, &def, &num)) || !def) {
-		return -EBADMSG;
+	*p_ptr = p;
+
+	if (ret) {
+		return ret;
 	}
 
-	if (num < -17 || num > 255) {
-		LOG_ERR("ncells RSRQ out of range: %ld", num);
+	int32_t v = negative ? -(int32_t)value : (int32_t)value;
+
+	if (v < min || v > max) {
 		return -ERANGE;
 	}
 
-	cell->rsrq = (int16_t)num;
+	*num = v;
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
-	}
+	return 0;
+}
 
-	if (!(p = hio_tok_num(p, &def, &num)) || !def) {
+/* Field of digits whose value is not needed, e.g. a 64-bit measurement time */
+static int ncellmeas_skip(const char **p_ptr)
+{
+	const char *p = *p_ptr;
+
+	if (*p < '0' || *p > '9') {
 		return -EBADMSG;
 	}
 
-	if (num < -99999 || num > 99999) {
-		LOG_ERR("ncells time_diff out of range: %ld", num);
-		return -ERANGE;
+	while (*p >= '0' && *p <= '9') {
+		p++;
 	}
 
-	cell->time_diff = (int)num;
+	if (!ncellmeas_field_end(*p)) {
+		return -EBADMSG;
+	}
 
 	*p_ptr = p;
 
 	return 0;
 }
 
-static inline int parse_ncellmeas_cell(const char **p_ptr,
-				       struct hio_lte_ncellmeas_cell_param *cell)
+/* Quoted field: @p str and @p len are set to the text between the quotes */
+static int ncellmeas_quoted(const char **p_ptr, const char **str, size_t *len)
 {
-	/* <cell_id>,<plmn>,<tac>,<timing_advance>,<timing_advance_measurement_time>,<earfcn>,
-	<phys_cell_id>,<rsrp>,<rsrq>,<measurement_time>,<serving>,<neighbor_count> */
-
-	int ret;
-	bool def;
-	char tmp_str[16] = {0};
 	const char *p = *p_ptr;
 
-	if (!(p = hio_tok_str(p, &def, tmp_str, sizeof(tmp_str))) || !def) {
+	if (*p++ != '"') {
 		return -EBADMSG;
 	}
 
-	ret = parse_hex2cellid(tmp_str, &cell->eci);
-	if (ret != 0) {
-		LOG_ERR("Failed to parse cell_id");
-		return ret;
-	}
+	*str = p;
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	while (*p != '"') {
+		if (ncellmeas_field_end(*p)) {
+			return -EBADMSG;
+		}
+		p++;
 	}
 
-	if (!(p = hio_tok_str(p, &def, tmp_str, sizeof(tmp_str))) || !def) {
+	*len = p - *str;
+
+	if (!ncellmeas_field_end(*++p)) {
 		return -EBADMSG;
 	}
 
-	ret = hio_lte_parse_plmn(tmp_str, NULL, &cell->mcc, &cell->mnc);
-	if (ret != 0) {
-		LOG_ERR("Failed to parse plmn");
+	*p_ptr = p;
+
+	return 0;
+}
+
+static int ncellmeas_hex(const char **p_ptr, size_t digits, uint32_t *num)
+{
+	const char *str;
+	size_t len;
+
+	int ret = ncellmeas_quoted(p_ptr, &str, &len);
+	if (ret) {
 		return ret;
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	if (len != digits) {
+		return -ERANGE;
 	}
 
-	if (!(p = hio_tok_str(p, &def, tmp_str, sizeof(tmp_str))) || !def) {
-		return -EBADMSG;
+	uint32_t value = 0;
+
+	for (size_t i = 0; i < len; i++) {
+		int digit = ncellmeas_hex_digit(str[i]);
+		if (digit < 0) {
+			return -ERANGE;
+		}
+
+		value = value << 4 | digit;
 	}
 
-	ret = parse_hex2tac(tmp_str, &cell->tac);
-	if (ret != 0) {
-		LOG_ERR("Failed to parse tac");
+	*num = value;
+
+	return 0;
+}
+
+static int ncellmeas_plmn(const char **p_ptr, uint16_t *mcc, uint16_t *mnc)
+{
+	const char *str;
+	size_t len;
+
+	int ret = ncellmeas_quoted(p_ptr, &str, &len);
+	if (ret) {
 		return ret;
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	if (len != 5 && len != 6) {
+		return -ERANGE;
 	}
 
-	if (!(p = hio_tok_uint16(p, &def, &cell->adv)) || !def) {
-		return -EBADMSG;
+	uint16_t digits[6];
+
+	for (size_t i = 0; i < len; i++) {
+		if (str[i] < '0' || str[i] > '9') {
+			return -ERANGE;
+		}
+
+		digits[i] = str[i] - '0';
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	/* Same rules as hio_lte_parse_plmn */
+	*mcc = digits[0] * 100 + digits[1] * 10 + digits[2];
+	if (*mcc == 0) {
+		return -ERANGE;
 	}
 
-	if (!(p = hio_tok_num(p, &def, NULL)) || !def) { /* skip: timing_advance_measurement_time */
-		return -EBADMSG;
+	if (len == 5) {
+		*mnc = digits[3] * 10 + digits[4];
+	} else {
+		*mnc = digits[3] * 100 + digits[4] * 10 + digits[5];
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	return 0;
+}
+
+/* Keep a syntax error, remember a value error in @p valid */
+static inline int ncellmeas_field(int ret, bool *valid)
+{
+	if (ret == -ERANGE) {
+		*valid = false;
+		return 0;
 	}
 
-	if (!(p = hio_tok_uint32(p, &def, &cell->earfcn)) || !def) {
-		return -EBADMSG;
+	return ret;
+}
+
+static int parse_ncellmeas_ncell(const char **p_ptr, struct hio_lte_ncellmeas_ncell_param *ncell,
+				 bool *valid)
+{
+	/* <n_earfcn>,<n_phys_cell_id>,<n_rsrp>,<n_rsrq>,<n_time_diff> */
+
+	int ret;
+	uint32_t num;
+	int32_t level;
+	const char *p = *p_ptr;
+
+	*valid = true;
+
+	if ((ret = ncellmeas_field(ncellmeas_uint(&p, UINT32_MAX, &ncell->earfcn), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (cell->earfcn > HIO_LTE_CELL_EARFCN_MAX) {
-		LOG_ERR("EARFCN out of range: %u", cell->earfcn);
-		return -ERANGE;
+	if ((ret = ncellmeas_field(ncellmeas_uint(&p, UINT16_MAX, &num), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	ncell->pci = num;
+
+	if ((ret = ncellmeas_field(ncellmeas_int(&p, -17, 255, &level), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_uint16(p, &def, &cell->pci)) || !def) {
-		return -EBADMSG;
+	ncell->rsrp = level;
+
+	if ((ret = ncellmeas_field(ncellmeas_int(&p, -17, 255, &level), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	ncell->rsrq = level;
+
+	if ((ret = ncellmeas_field(ncellmeas_int(&p, -99999, 99999, &level), valid))) {
+		return ret;
 	}
 
-	long num;
+	ncell->time_diff = level;
 
-	if (!(p = hio_tok_num(p, &def, &num)) || !def) {
-		return -EBADMSG;
+	*p_ptr = p;
+
+	return 0;
+}
+
+static int parse_ncellmeas_cell(const char **p_ptr, struct hio_lte_ncellmeas_cell_param *cell)
+{
+	/* <cell_id>,<plmn>,<tac>,<timing_advance>,<timing_advance_measurement_time>,<earfcn>,
+	<phys_cell_id>,<rsrp>,<rsrq>,<measurement_time>,<serving>,<neighbor_count> */
+
+	int ret;
+	uint32_t num;
+	int32_t level;
+	const char *p = *p_ptr;
+	bool *valid = &cell->valid;
+
+	*valid = true;
+
+	if ((ret = ncellmeas_field(ncellmeas_hex(&p, 8, &cell->eci), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (num < -17 || num > 255) {
-		LOG_ERR("RSRP out of range: %ld", num);
-		return -ERANGE;
+	if (cell->eci > HIO_LTE_CELL_ECI_MAX) {
+		*valid = false;
 	}
 
-	cell->rsrp = (int16_t)num;
+	if ((ret = ncellmeas_field(ncellmeas_plmn(&p, &cell->mcc, &cell->mnc), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
+	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	if ((ret = ncellmeas_field(ncellmeas_hex(&p, 4, &num), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_num(p, &def, &num)) || !def) {
-		return -EBADMSG;
+	cell->tac = num;
+
+	if ((ret = ncellmeas_field(ncellmeas_uint(&p, UINT16_MAX, &num), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (num < -17 || num > 255) {
-		LOG_ERR("RSRQ out of range: %ld", num);
-		return -ERANGE;
+	cell->adv = num;
+
+	if ((ret = ncellmeas_skip(&p)) || (ret = ncellmeas_sep(&p))) { /* skip: timing_advance_measurement_time */
+		return ret;
 	}
 
-	cell->rsrq = (int16_t)num;
+	if ((ret = ncellmeas_field(ncellmeas_uint(&p, HIO_LTE_CELL_EARFCN_MAX, &cell->earfcn),
+				   valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
+	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	if ((ret = ncellmeas_field(ncellmeas_uint(&p, UINT16_MAX, &num), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_num(p, &def, NULL)) || !def) { /* skip: measurement_time */
-		return -EBADMSG;
+	cell->pci = num;
+
+	if ((ret = ncellmeas_field(ncellmeas_int(&p, -17, 255, &level), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	cell->rsrp = level;
+
+	if ((ret = ncellmeas_field(ncellmeas_int(&p, -17, 255, &level), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_uint8(p, &def, NULL)) || !def) { /* skip: serving */
-		return -EBADMSG;
+	cell->rsrq = level;
+
+	if ((ret = ncellmeas_skip(&p)) || (ret = ncellmeas_sep(&p))) { /* skip: measurement_time */
+		return ret;
 	}
 
-	if (!(p = hio_tok_sep(p))) {
-		return -EPROTO;
+	/* Skip <serving> */
+	if ((ret = ncellmeas_field(ncellmeas_uint(&p, UINT8_MAX, NULL), valid)) ||
+	    (ret = ncellmeas_sep(&p))) {
+		return ret;
 	}
 
-	if (!(p = hio_tok_uint8(p, &def, &cell->neighbor_count)) || !def) {
-		return -EBADMSG;
+	/* A count that does not fit is a malformed line: the neighbors can't be skipped */
+	if ((ret = ncellmeas_uint(&p, UINT8_MAX, &num))) {
+		return ret == -ERANGE ? -EBADMSG : ret;
 	}
 
+	cell->neighbor_count = num;
+
 	*p_ptr = p;
 
 	return 0;
@@ -742,6 +929,13 @@ int hio_lte_parse_urc_ncellmeas(const char *line, uint8_t search_type,
 	<phys_cell_id>,<rsrp>,<rsrq>,<measurement_time>,<serving>,<neighbor_count>
 		[,<n_earfcn>1,<n_phys_cell_id>1,<n_rsrp>1,<n_rsrq>1,<time_diff>1]
 		[,<n_earfcn>2,<n_phys_cell_id>2,<n_rsrp>2,<n_rsrq>2,<time_diff>2]...]...
+
+	Every cell is kept with cells[i].valid telling whether all its values were in
+	range. Neighbor cells with a value out of range and the ones past
+	HIO_LTE_NCELLMEAS_NCELL_MAX are left out, and so are the cells past
+	HIO_LTE_NCELLMEAS_CELL_MAX. param->valid is set once the whole line has been
+	read; on a malformed line the error is returned and the cells before the
+	error stay as parsed.
 	*/
 
 	if (!line || !param) {
@@ -759,14 +953,17 @@ int hio_lte_parse_urc_ncellmeas(const char *line, uint8_t search_type,
 	}
 
 	int ret;
+	uint32_t num;
 	const char *p = line;
-	bool def;
 
-	if (!(p = hio_tok_uint8(p, &def, &param->status)) || !def) {
+	ret = ncellmeas_uint(&p, UINT8_MAX, &num);
+	if (ret) {
 		LOG_ERR("Failed to parse status");
 		return -EBADMSG;
 	}
 
+	param->status = num;
+
 	if (param->status == 1) {
 		param->valid = true;
 		return 0;
@@ -777,61 +974,77 @@ int hio_lte_parse_urc_ncellmeas(const char *line, uint8_t search_type,
 		return -EOPNOTSUPP;
 	}
 
-	struct hio_lte_ncellmeas_cell_param *cell;
-	struct hio_lte_ncellmeas_ncell_param *ncell;
-
-	while (!hio_tok_end(p)) {
-		if (!(p = hio_tok_sep(p))) {
-			return -EPROTO;
-		}
+	while (param->num_cells < HIO_LTE_NCELLMEAS_CELL_MAX && *p == ',') {
+		p++;
 
-		cell = &param->cells[param->num_cells];
+		struct hio_lte_ncellmeas_cell_param *cell = &param->cells[param->num_cells];
 
 		ret = parse_ncellmeas_cell(&p, cell);
-		if (ret != 0) {
-			LOG_ERR("Failed to parse cell failed: %d", ret);
+		if (ret) {
+			LOG_ERR("Failed to parse cell: %d", ret);
+			cell->valid = false;
 			return ret;
 		}
 
 		param->num_cells += 1;
 
-		if (cell->neighbor_count) {
-			cell->ncells =
-				&param->ncells[param->num_ncells]; /* point to the start of the
-								      neighboring cells */
+		uint8_t count = cell->neighbor_count;
 
-			for (int j = 0; j < cell->neighbor_count; ++j) {
-				if (!(p = hio_tok_sep(p))) {
-					return -EPROTO;
-				}
+		cell->neighbor_count = 0;
+		cell->ncells = NULL;
 
+		for (int j = 0; j < count; ++j) {
+			struct hio_lte_ncellmeas_ncell_param spare;
+			struct hio_lte_ncellmeas_ncell_param *ncell = &spare;
+			bool valid;
+
+			if (param->num_ncells < HIO_LTE_NCELLMEAS_NCELL_MAX) {
 				ncell = &param->ncells[param->num_ncells];
-				ret = parse_ncellmeas_ncell(&p, ncell);
-				if (ret != 0) {
-					LOG_ERR("Failed to parse neighboring cell: %d", ret);
-					return ret;
-				}
-
-				param->num_ncells += 1;
-
-				if (param->num_ncells == HIO_LTE_NCELLMEAS_NCELL_MAX) {
-					cell->neighbor_count = j + 1; /* adjust to the actual number
-								      of neighboring cells parsed */
-					return -EMSGSIZE;
-				}
 			}
-		}
 
-		if (hio_tok_end(p)) {
-			param->valid = true;
-			return 0;
-		}
+			if ((ret = ncellmeas_sep(&p)) ||
+			    (ret = parse_ncellmeas_ncell(&p, ncell, &valid))) {
+				LOG_ERR("Failed to parse neighboring cell: %d", ret);
+				return ret;
+			}
 
-		if (param->num_cells == HIO_LTE_NCELLMEAS_CELL_MAX) {
-			param->valid = true;
-			return 0;
+			if (!valid || ncell == &spare) {
+				continue;
+			}
+
+			if (!cell->neighbor_count) {
+				cell->ncells = ncell;
+			}
+
+			cell->neighbor_count += 1;
+			param->num_ncells += 1;
 		}
 	}
 
-	return -EPROTO;
+	/* The cells past HIO_LTE_NCELLMEAS_CELL_MAX are not read */
+	if (param->num_cells < HIO_LTE_NCELLMEAS_CELL_MAX && !hio_tok_end(p)) {
+		return -EPROTO;
+	}
+
+	param->valid = true;
+
+	return 0;
+}
+
+void hio_lte_parse_ncellmeas_link(struct hio_lte_ncellmeas_param *param)
+{
+	uint8_t first = 0;
+
+	for (int i = 0; i < param->num_cells && i < HIO_LTE_NCELLMEAS_CELL_MAX; i++) {
+		struct hio_lte_ncellmeas_cell_param *cell = &param->cells[i];
+
+		if (!cell->neighbor_count || first + cell->neighbor_count > param->num_ncells) {
+			cell->neighbor_count = 0;
+			cell->ncells = NULL;
+			continue;
+		}
+
+		cell->ncells = &param->ncells[first];
+		first += cell->neighbor_count;
+	}
 }
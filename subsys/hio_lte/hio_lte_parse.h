@@ -32,6 +32,9 @@ int hio_lte_parse_cgcont(const char *line, struct cgdcont_param *param);
 int hio_lte_parse_urc_ncellmeas(const char *line, uint8_t search_type,
 				struct hio_lte_ncellmeas_param *param);
 
+/* Point the cells at their neighbors in @p param after the struct was copied */
+void hio_lte_parse_ncellmeas_link(struct hio_lte_ncellmeas_param *param);
+
 #ifdef __cplusplus
 }
 #endif
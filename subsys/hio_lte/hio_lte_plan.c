@@ -0,0 +1,232 @@
+#include "hio_lte_cache.h"
+#include "hio_lte_plan.h"
+#include "hio_lte_talk.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_plan, CONFIG_HIO_LTE_LOG_LEVEL);
+
+/* Number of distinct plans whose last run is kept */
+#define TRACE_SLOTS 4
+
+#define CMD_BUF_SIZE  256
+#define RESP_BUF_SIZE 128
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct hio_lte_plan_trace m_traces[TRACE_SLOTS];
+
+/* Plans run one at a time from the LTE thread; the working trace is only
+ * published to m_traces under the lock once the run finishes */
+static struct hio_lte_plan_trace m_work;
+
+static void publish_trace(const struct hio_lte_plan_trace *trace)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	struct hio_lte_plan_trace *slot = NULL;
+	struct hio_lte_plan_trace *oldest = &m_traces[0];
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_traces); i++) {
+		if (!m_traces[i].plan || !strcmp(m_traces[i].plan, trace->plan)) {
+			slot = &m_traces[i];
+			break;
+		}
+		if (m_traces[i].timestamp < oldest->timestamp) {
+			oldest = &m_traces[i];
+		}
+	}
+
+	*(slot ? slot : oldest) = *trace;
+
+	k_mutex_unlock(&m_lock);
+}
+
+static void record_step(const struct hio_lte_plan_step *step,
+			enum hio_lte_plan_step_result result, int err, uint8_t attempts,
+			uint32_t duration_ms)
+{
+	if (m_work.count < ARRAY_SIZE(m_work.steps)) {
+		struct hio_lte_plan_trace_step *s = &m_work.steps[m_work.count];
+
+		s->name = step->name;
+		s->result = result;
+		s->err = err;
+		s->attempts = attempts;
+		s->duration_ms = duration_ms;
+	}
+
+	m_work.count++;
+}
+
+static int exec_step(const struct hio_lte_plan_step *step, const char *cmd)
+{
+	static char resp[RESP_BUF_SIZE];
+	int ret;
+
+	hio_lte_talk_set_quiet(step->flags & HIO_LTE_PLAN_FLAG_QUIET);
+
+	if (step->expect) {
+		ret = hio_lte_talk_at_cmd_with_resp_prefix(cmd, resp, sizeof(resp), step->expect);
+	} else {
+		resp[0] = '\0';
+		ret = hio_lte_talk_at_cmd(cmd);
+	}
+
+	hio_lte_talk_set_quiet(false);
+
+	if (ret) {
+		return ret;
+	}
+
+	return step->handle ? step->handle(resp) : 0;
+}
+
+static int run_step(const struct hio_lte_plan_step *step)
+{
+	static char cmd[CMD_BUF_SIZE];
+	const char *s = step->cmd;
+	int ret;
+
+	if (step->skip && step->skip()) {
+		record_step(step, HIO_LTE_PLAN_STEP_RESULT_SKIPPED, 0, 0, 0);
+		return 0;
+	}
+
+	if (step->build) {
+		ret = step->build(cmd, sizeof(cmd));
+		if (ret) {
+			LOG_ERR("Building step `%s` failed: %d", step->name, ret);
+			record_step(step, HIO_LTE_PLAN_STEP_RESULT_FAILED, ret, 0, 0);
+			return ret;
+		}
+		s = cmd;
+	}
+
+	if (!s) {
+		record_step(step, HIO_LTE_PLAN_STEP_RESULT_FAILED, -EINVAL, 0, 0);
+		return -EINVAL;
+	}
+
+	if (hio_lte_cache_check(step->cache, s)) {
+		LOG_DBG("Step `%s` cached", step->name);
+		record_step(step, HIO_LTE_PLAN_STEP_RESULT_CACHED, 0, 0, 0);
+		return 0;
+	}
+
+	int64_t start = k_uptime_get();
+	uint8_t attempts = 0;
+
+	for (;;) {
+		attempts++;
+
+		ret = exec_step(step, s);
+		if (!ret || attempts > step->retries) {
+			break;
+		}
+
+		LOG_WRN("Step `%s` failed: %d (attempt %u)", step->name, ret, attempts);
+
+		if (step->retry_delay_ms) {
+			k_sleep(K_MSEC(step->retry_delay_ms));
+		}
+	}
+
+	uint32_t duration_ms = (uint32_t)(k_uptime_get() - start);
+
+	if (ret) {
+		record_step(step, HIO_LTE_PLAN_STEP_RESULT_FAILED, ret, attempts, duration_ms);
+		return ret;
+	}
+
+	hio_lte_cache_update(step->cache, s);
+
+	record_step(step, HIO_LTE_PLAN_STEP_RESULT_OK, 0, attempts, duration_ms);
+
+	return 0;
+}
+
+int hio_lte_plan_run(const char *plan, const struct hio_lte_plan_step *steps, size_t count)
+{
+	int ret = 0;
+
+	if (!plan || (!steps && count)) {
+		return -EINVAL;
+	}
+
+	memset(&m_work, 0, sizeof(m_work));
+	m_work.plan = plan;
+	m_work.timestamp = k_uptime_get();
+
+	size_t cached = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		const struct hio_lte_plan_step *step = &steps[i];
+
+		ret = run_step(step);
+		if (ret) {
+			if (step->flags & HIO_LTE_PLAN_FLAG_OPTIONAL) {
+				LOG_WRN("Optional step `%s` of plan `%s` failed: %d", step->name,
+					plan, ret);
+				ret = 0;
+				continue;
+			}
+
+			LOG_ERR("Step `%s` of plan `%s` failed: %d", step->name, plan, ret);
+			break;
+		}
+
+		if (m_work.count <= ARRAY_SIZE(m_work.steps) &&
+		    m_work.steps[m_work.count - 1].result == HIO_LTE_PLAN_STEP_RESULT_CACHED) {
+			cached++;
+		}
+	}
+
+	m_work.err = ret;
+	m_work.duration_ms = (uint32_t)(k_uptime_get() - m_work.timestamp);
+
+	if (m_work.count > ARRAY_SIZE(m_work.steps)) {
+		LOG_WRN("Plan `%s` trace truncated (%zu steps)", plan, m_work.count);
+	}
+
+	LOG_INF("Plan `%s` %s in %u ms (%zu step(s), %zu cached)", plan,
+		ret ? "failed" : "done", m_work.duration_ms, m_work.count, cached);
+
+	publish_trace(&m_work);
+
+	return ret;
+}
+
+int hio_lte_plan_get_trace(int index, struct hio_lte_plan_trace *trace)
+{
+	if (!trace || index < 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_traces); i++) {
+		if (!m_traces[i].plan) {
+			continue;
+		}
+
+		if (index-- == 0) {
+			*trace = m_traces[i];
+			k_mutex_unlock(&m_lock);
+			return 0;
+		}
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return -ENOENT;
+}
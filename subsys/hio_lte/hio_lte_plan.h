@@ -0,0 +1,80 @@
+#ifndef SUBSYS_HIO_LTE_PLAN_H_
+#define SUBSYS_HIO_LTE_PLAN_H_
+
+#include "hio_lte_cache.h"
+
+/* Zephyr includes */
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Failure is logged and the plan continues */
+#define HIO_LTE_PLAN_FLAG_OPTIONAL BIT(0)
+/* Command and response are logged at debug level only */
+#define HIO_LTE_PLAN_FLAG_QUIET    BIT(1)
+
+/**
+ * @brief One AT command of a plan.
+ *
+ * The command is either the fixed @p cmd or formatted by @p build. With
+ * @p expect set, the first response line starting with it is required and its
+ * value (the rest of the line) is passed to @p handle; without it @p handle
+ * gets an empty string. A non-zero @p handle return fails the step.
+ */
+struct hio_lte_plan_step {
+	const char *name;
+	const char *cmd;
+	int (*build)(char *buf, size_t size);
+	const char *expect;
+	int (*handle)(const char *value);
+	/* Step is not run (and reported as skipped) when this returns true */
+	bool (*skip)(void);
+	/* Skip when the formatted command was already applied (see hio_lte_cache) */
+	enum hio_lte_cache_item cache;
+	uint8_t retries;
+	uint16_t retry_delay_ms;
+	uint8_t flags;
+};
+
+enum hio_lte_plan_step_result {
+	HIO_LTE_PLAN_STEP_RESULT_OK = 0,
+	HIO_LTE_PLAN_STEP_RESULT_SKIPPED,
+	HIO_LTE_PLAN_STEP_RESULT_CACHED,
+	HIO_LTE_PLAN_STEP_RESULT_FAILED,
+};
+
+struct hio_lte_plan_trace_step {
+	const char *name;
+	enum hio_lte_plan_step_result result;
+	int err;
+	uint8_t attempts;
+	uint32_t duration_ms;
+};
+
+struct hio_lte_plan_trace {
+	const char *plan;
+	int64_t timestamp;
+	uint32_t duration_ms;
+	int err;
+	/* Steps run; only the first CONFIG_HIO_LTE_PLAN_TRACE_SIZE are recorded */
+	size_t count;
+	struct hio_lte_plan_trace_step steps[CONFIG_HIO_LTE_PLAN_TRACE_SIZE];
+};
+
+int hio_lte_plan_run(const char *plan, const struct hio_lte_plan_step *steps, size_t count);
+
+/* Trace of the last run of each plan; -ENOENT past the last one */
+int hio_lte_plan_get_trace(int index, struct hio_lte_plan_trace *trace);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_PLAN_H_ */
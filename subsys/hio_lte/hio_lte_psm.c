@@ -0,0 +1,270 @@
+#include "hio_lte_psm.h"
+#include "hio_lte_parse.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/time_units.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_psm, CONFIG_HIO_LTE_LOG_LEVEL);
+
+/* Defaults applied until the pattern is learned: TAU 24 h, active time 0 s */
+#define DEFAULT_TAU    "00111000"
+#define DEFAULT_ACTIVE "00000000"
+
+#define TIMER_VALUE_MAX 31
+
+struct timer_unit {
+	uint8_t bits;
+	int seconds;
+};
+
+/* Units ordered from the finest, so the first one that fits is the closest */
+static const struct timer_unit m_tau_units[] = {
+	{0b011, 2}, {0b100, 30}, {0b101, 60}, {0b000, 600}, {0b001, 3600}, {0b010, 36000},
+	{0b110, 1152000},
+};
+
+static const struct timer_unit m_active_units[] = {
+	{0b000, 2},
+	{0b001, 60},
+	{0b010, 360},
+};
+
+static K_MUTEX_DEFINE(m_lock);
+
+static int64_t m_last_ts;
+static uint32_t m_samples;
+static uint32_t m_samples_since_apply;
+/* Moving averages: interval in ms, share of polls in permille */
+static uint32_t m_interval_ms;
+static uint32_t m_poll_permille;
+
+static struct hio_lte_psm_request m_applied;
+static int m_granted_active = GRPS_TIMER_INVALID;
+static int m_granted_tau = GRPS_TIMER_INVALID;
+
+static int encode(const struct timer_unit *units, size_t count, int seconds, char *bits)
+{
+	uint8_t value = 0;
+	int encoded = 0;
+
+	seconds = MAX(seconds, 0);
+
+	for (size_t i = 0; i < count; i++) {
+		int64_t n = DIV_ROUND_UP((int64_t)seconds, units[i].seconds);
+
+		/* The coarsest unit saturates */
+		if (n <= TIMER_VALUE_MAX || i == count - 1) {
+			n = MIN(n, TIMER_VALUE_MAX);
+			value = (units[i].bits << 5) | (uint8_t)n;
+			encoded = (int)n * units[i].seconds;
+			break;
+		}
+	}
+
+	for (int i = 0; i < 8; i++) {
+		bits[i] = (value & BIT(7 - i)) ? '1' : '0';
+	}
+
+	bits[8] = '\0';
+
+	return encoded;
+}
+
+int hio_lte_psm_encode_tau(int seconds, char *bits)
+{
+	return encode(m_tau_units, ARRAY_SIZE(m_tau_units), seconds, bits);
+}
+
+int hio_lte_psm_encode_active(int seconds, char *bits)
+{
+	return encode(m_active_units, ARRAY_SIZE(m_active_units), seconds, bits);
+}
+
+static void default_request(struct hio_lte_psm_request *req)
+{
+	strcpy(req->tau, DEFAULT_TAU);
+	strcpy(req->active, DEFAULT_ACTIVE);
+	req->tau_s = 24 * 3600;
+	req->active_s = 0;
+}
+
+static void get_request(struct hio_lte_psm_request *req)
+{
+	if (!IS_ENABLED(CONFIG_HIO_LTE_PSM_AUTO) || m_samples < CONFIG_HIO_LTE_PSM_MIN_SAMPLES) {
+		default_request(req);
+		return;
+	}
+
+	/* Stay reachable for a late reply only if the device polls */
+	int active_s = m_poll_permille > 500 ? CONFIG_HIO_LTE_PSM_POLL_ACTIVE_TIME : 0;
+	req->active_s = hio_lte_psm_encode_active(active_s, req->active);
+
+	/* Twice the interval: a late transaction must not find the device
+	 * waking up just for a TAU. Frequent senders would otherwise ask for
+	 * a TAU of seconds, which networks reject or answer with signalling
+	 * storms, and the TAU has to outlast the active time. */
+	int tau_s = (int)MIN(2ULL * m_interval_ms / MSEC_PER_SEC, (uint64_t)INT32_MAX);
+	tau_s = MAX(tau_s, CONFIG_HIO_LTE_PSM_MIN_TAU);
+	tau_s = MAX(tau_s, 2 * req->active_s);
+	req->tau_s = hio_lte_psm_encode_tau(tau_s, req->tau);
+}
+
+void hio_lte_psm_init(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_last_ts = 0;
+	m_samples = 0;
+	m_samples_since_apply = 0;
+	m_interval_ms = 0;
+	m_poll_permille = 0;
+	default_request(&m_applied);
+	m_granted_active = GRPS_TIMER_INVALID;
+	m_granted_tau = GRPS_TIMER_INVALID;
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_psm_record(int64_t now, bool poll)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (m_last_ts && now > m_last_ts) {
+		uint32_t sample = (uint32_t)MIN(now - m_last_ts, (int64_t)UINT32_MAX);
+
+		if (!m_samples) {
+			m_interval_ms = sample;
+			m_poll_permille = poll ? 1000 : 0;
+		} else {
+			/* Weight 1/4 for the newest sample */
+			m_interval_ms = m_interval_ms - m_interval_ms / 4 + sample / 4;
+			m_poll_permille = m_poll_permille - m_poll_permille / 4 + (poll ? 250 : 0);
+		}
+
+		m_samples++;
+		m_samples_since_apply++;
+	}
+
+	m_last_ts = now;
+
+	k_mutex_unlock(&m_lock);
+}
+
+int hio_lte_psm_get_interval(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	int interval = m_samples ? (int)(m_interval_ms / MSEC_PER_SEC) : 0;
+	k_mutex_unlock(&m_lock);
+
+	return interval;
+}
+
+void hio_lte_psm_get_request(struct hio_lte_psm_request *req)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	get_request(req);
+	k_mutex_unlock(&m_lock);
+}
+
+bool hio_lte_psm_is_update_pending(void)
+{
+	struct hio_lte_psm_request req;
+
+	if (!IS_ENABLED(CONFIG_HIO_LTE_PSM_AUTO)) {
+		return false;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	/* Let the pattern settle after every change */
+	bool pending = false;
+	if (m_samples_since_apply >= CONFIG_HIO_LTE_PSM_MIN_SAMPLES) {
+		get_request(&req);
+		pending = strcmp(req.tau, m_applied.tau) || strcmp(req.active, m_applied.active);
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return pending;
+}
+
+void hio_lte_psm_set_applied(const struct hio_lte_psm_request *req)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_applied = *req;
+	m_samples_since_apply = 0;
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_psm_get_applied(struct hio_lte_psm_request *req)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	*req = m_applied;
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_psm_set_granted(int active_s, int tau_s)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (active_s != m_granted_active || tau_s != m_granted_tau) {
+		LOG_INF("Granted active time %d s, TAU %d s (requested %d s, %d s)", active_s,
+			tau_s, m_applied.active_s, m_applied.tau_s);
+	}
+
+	m_granted_active = active_s;
+	m_granted_tau = tau_s;
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_psm_get_granted(int *active_s, int *tau_s)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (active_s) {
+		*active_s = m_granted_active;
+	}
+
+	if (tau_s) {
+		*tau_s = m_granted_tau;
+	}
+
+	k_mutex_unlock(&m_lock);
+}
+
+int hio_lte_psm_predict_sleep(uint32_t connected_ms)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (!m_samples || !m_interval_ms) {
+		k_mutex_unlock(&m_lock);
+		return -1;
+	}
+
+	uint64_t interval_ms = m_interval_ms;
+	uint64_t active_ms = m_granted_active > 0 ? (uint64_t)m_granted_active * MSEC_PER_SEC : 0;
+
+	/* Every transaction and every TAU in between wakes the modem up */
+	uint64_t wakeups = 1;
+	if (m_granted_tau > 0 && (uint64_t)m_granted_tau * MSEC_PER_SEC < interval_ms) {
+		wakeups += interval_ms / ((uint64_t)m_granted_tau * MSEC_PER_SEC);
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	uint64_t awake_ms = wakeups * (connected_ms + active_ms);
+
+	return awake_ms >= interval_ms ? 0 : (int)(1000 - awake_ms * 1000 / interval_ms);
+}
@@ -0,0 +1,59 @@
+#ifndef SUBSYS_HIO_LTE_PSM_H_
+#define SUBSYS_HIO_LTE_PSM_H_
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* PSM timers as requested by AT+CPSMS; the bit strings are the 8-bit GPRS
+ * timer encodings of 3GPP TS 24.008 */
+struct hio_lte_psm_request {
+	/* Periodic TAU (T3412 extended, GPRS Timer 3) */
+	char tau[9];
+	/* Active time (T3324, GPRS Timer 2) */
+	char active[9];
+	int tau_s;
+	int active_s;
+};
+
+void hio_lte_psm_init(void);
+
+/* Encode @p seconds rounded up to the next representable value into @p bits
+ * (9 bytes); returns the encoded value in seconds */
+int hio_lte_psm_encode_tau(int seconds, char *bits);
+int hio_lte_psm_encode_active(int seconds, char *bits);
+
+/* A transaction started at @p now (ms); @p poll if it waited for a reply */
+void hio_lte_psm_record(int64_t now, bool poll);
+
+/* Learned interval between transactions in seconds, 0 until learned */
+int hio_lte_psm_get_interval(void);
+
+/* Timers matching the learned pattern; the configured defaults until learned
+ * or with CONFIG_HIO_LTE_PSM_AUTO disabled */
+void hio_lte_psm_get_request(struct hio_lte_psm_request *req);
+
+/* The learned request differs from the one applied to the modem */
+bool hio_lte_psm_is_update_pending(void);
+
+void hio_lte_psm_set_applied(const struct hio_lte_psm_request *req);
+void hio_lte_psm_get_applied(struct hio_lte_psm_request *req);
+
+/* Timers granted by the network (+CEREG), in seconds or GRPS_TIMER_* */
+void hio_lte_psm_set_granted(int active_s, int tau_s);
+void hio_lte_psm_get_granted(int *active_s, int *tau_s);
+
+/* Expected share of time asleep (permille) with the granted timers, the
+ * learned interval and @p connected_ms spent connected per transaction;
+ * -1 until the interval is learned */
+int hio_lte_psm_predict_sleep(uint32_t connected_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_PSM_H_ */
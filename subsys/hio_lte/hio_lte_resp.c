@@ -0,0 +1,68 @@
+#include "hio_lte_resp.h"
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+void hio_lte_resp_init(struct hio_lte_resp *resp, const char *buf)
+{
+	resp->pos = buf ? buf : "";
+}
+
+const char *hio_lte_resp_line(struct hio_lte_resp *resp, size_t *len)
+{
+	const char *p = resp->pos;
+
+	p += strspn(p, "\r\n");
+
+	if (*p == '\0') {
+		resp->pos = p;
+		return NULL;
+	}
+
+	size_t n = strcspn(p, "\r\n");
+
+	resp->pos = p + n;
+
+	if (len) {
+		*len = n;
+	}
+
+	return p;
+}
+
+const char *hio_lte_resp_value(struct hio_lte_resp *resp, const char *pfx, size_t *len)
+{
+	size_t pfx_len = pfx ? strlen(pfx) : 0;
+	const char *line;
+	size_t n;
+
+	while ((line = hio_lte_resp_line(resp, &n))) {
+		if (n >= pfx_len && !strncmp(line, pfx, pfx_len)) {
+			if (len) {
+				*len = n - pfx_len;
+			}
+			return line + pfx_len;
+		}
+	}
+
+	return NULL;
+}
+
+int hio_lte_resp_copy(const char *span, size_t len, char *buf, size_t size)
+{
+	if (!span || !buf || !size) {
+		return -EINVAL;
+	}
+
+	if (len >= size) {
+		return -ENOSPC;
+	}
+
+	memcpy(buf, span, len);
+	buf[len] = '\0';
+
+	return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef SUBSYS_HIO_LTE_RESP_H_
+#define SUBSYS_HIO_LTE_RESP_H_
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Non-destructive iterator over the lines of an AT response. Lines are
+ * returned as spans into the response buffer; a span is not NUL-terminated, so
+ * it is copied out with hio_lte_resp_copy before it is tokenized. */
+struct hio_lte_resp {
+	const char *pos;
+};
+
+void hio_lte_resp_init(struct hio_lte_resp *resp, const char *buf);
+
+/* Next non-empty line, or NULL at the end of the response */
+const char *hio_lte_resp_line(struct hio_lte_resp *resp, size_t *len);
+
+/* Value (the rest of the line) of the next line starting with @p pfx, or NULL */
+const char *hio_lte_resp_value(struct hio_lte_resp *resp, const char *pfx, size_t *len);
+
+/* Copy a span as a NUL-terminated string; -ENOSPC if it does not fit */
+int hio_lte_resp_copy(const char *span, size_t len, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_RESP_H_ */
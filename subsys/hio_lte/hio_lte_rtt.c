@@ -0,0 +1,269 @@
+#include "hio_lte_rtt.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_rtt, CONFIG_HIO_LTE_LOG_LEVEL);
+
+struct tracker {
+	/* Response times (ms), a ring of the latest ones */
+	uint16_t samples[HIO_LTE_RTT_SAMPLES];
+	uint8_t head;
+	uint8_t count;
+	uint8_t backoff;
+	uint16_t timeouts;
+};
+
+struct cell {
+	int act;
+	uint32_t eci;
+	/* Sequence of the last update, the least recent cell is replaced */
+	uint32_t used;
+	struct tracker tracker;
+};
+
+static K_MUTEX_DEFINE(m_lock);
+
+/* LTE-M and NB-IoT */
+static struct tracker m_rats[2];
+static const int m_rat_acts[2] = {HIO_LTE_CEREG_PARAM_ACT_LTE, HIO_LTE_CEREG_PARAM_ACT_NBIOT};
+static struct cell m_cells[CONFIG_HIO_LTE_RTT_CELLS];
+static uint32_t m_seq;
+
+static void tracker_add(struct tracker *tracker, uint32_t ms)
+{
+	tracker->samples[tracker->head] = MIN(ms, UINT16_MAX);
+	tracker->head = (tracker->head + 1) % HIO_LTE_RTT_SAMPLES;
+	tracker->count = MIN(tracker->count + 1, HIO_LTE_RTT_SAMPLES);
+}
+
+static uint32_t tracker_percentile_ms(const struct tracker *tracker)
+{
+	uint16_t sorted[HIO_LTE_RTT_SAMPLES];
+	int n = tracker->count;
+
+	if (!n) {
+		return 0;
+	}
+
+	/* The ring starts at 0 until it wraps, then all of it is used */
+	memcpy(sorted, tracker->samples, n * sizeof(sorted[0]));
+
+	for (int i = 1; i < n; i++) {
+		uint16_t v = sorted[i];
+		int j = i - 1;
+
+		while (j >= 0 && sorted[j] > v) {
+			sorted[j + 1] = sorted[j];
+			j--;
+		}
+
+		sorted[j + 1] = v;
+	}
+
+	/* Rank of the sample the percentile falls on, rounded up */
+	int rank = (n * HIO_LTE_RTT_PERCENTILE + 99) / 100;
+
+	return sorted[rank - 1];
+}
+
+static uint32_t tracker_timeout_ms(const struct tracker *tracker)
+{
+	if (tracker->count < HIO_LTE_RTT_SAMPLES_MIN) {
+		return 0;
+	}
+
+	uint64_t timeout_ms = (uint64_t)tracker_percentile_ms(tracker) * HIO_LTE_RTT_TIMEOUT_MULT
+			      << tracker->backoff;
+
+	return CLAMP(timeout_ms, HIO_LTE_RTT_TIMEOUT_MIN_MS, HIO_LTE_RTT_TIMEOUT_MAX_MS);
+}
+
+static struct tracker *get_rat(int act)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(m_rat_acts); i++) {
+		if (m_rat_acts[i] == act) {
+			return &m_rats[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct cell *find_cell(int act, uint32_t eci)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(m_cells); i++) {
+		if (m_cells[i].used && m_cells[i].act == act && m_cells[i].eci == eci) {
+			return &m_cells[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct cell *get_cell(int act, uint32_t eci)
+{
+	struct cell *cell = find_cell(act, eci);
+
+	if (!cell) {
+		cell = &m_cells[0];
+
+		for (size_t i = 1; i < ARRAY_SIZE(m_cells); i++) {
+			if (m_cells[i].used < cell->used) {
+				cell = &m_cells[i];
+			}
+		}
+
+		memset(cell, 0, sizeof(*cell));
+		cell->act = act;
+		cell->eci = eci;
+	}
+
+	cell->used = ++m_seq;
+
+	return cell;
+}
+
+static void update(const struct hio_lte_cereg_param *cereg, uint32_t ms, bool timeout)
+{
+	if (!cereg || !cereg->valid) {
+		return;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	struct tracker *rat = get_rat(cereg->act);
+
+	if (!rat) {
+		k_mutex_unlock(&m_lock);
+		return;
+	}
+
+	struct tracker *cell = &get_cell(cereg->act, (uint32_t)cereg->cid)->tracker;
+
+	struct tracker *trackers[] = {rat, cell};
+
+	for (size_t i = 0; i < ARRAY_SIZE(trackers); i++) {
+		struct tracker *tracker = trackers[i];
+
+		/* A timeout only says the reply took longer, if it came at
+		 * all; as a sample it would drag the percentile to the
+		 * timeout itself */
+		if (timeout) {
+			tracker->timeouts = MIN(tracker->timeouts + 1, UINT16_MAX);
+			tracker->backoff = MIN(tracker->backoff + 1, HIO_LTE_RTT_BACKOFF_MAX);
+		} else {
+			tracker_add(tracker, ms);
+			if (tracker->backoff) {
+				tracker->backoff--;
+			}
+		}
+	}
+
+	LOG_DBG("act: %d eci: %08x ms: %u timeout: %d -> %u ms", cereg->act, cereg->cid, ms,
+		timeout, tracker_timeout_ms(cell));
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_rtt_init(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	memset(m_rats, 0, sizeof(m_rats));
+	memset(m_cells, 0, sizeof(m_cells));
+	m_seq = 0;
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_rtt_add(const struct hio_lte_cereg_param *cereg, uint32_t ms)
+{
+	update(cereg, ms, false);
+}
+
+void hio_lte_rtt_timeout(const struct hio_lte_cereg_param *cereg, uint32_t timeout_ms)
+{
+	update(cereg, timeout_ms, true);
+}
+
+int hio_lte_rtt_get_timeout_ms(const struct hio_lte_cereg_param *cereg)
+{
+	if (!cereg || !cereg->valid) {
+		return -ENODATA;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	uint32_t timeout_ms = 0;
+	struct cell *cell = find_cell(cereg->act, (uint32_t)cereg->cid);
+
+	if (cell) {
+		timeout_ms = tracker_timeout_ms(&cell->tracker);
+	}
+
+	if (!timeout_ms) {
+		struct tracker *rat = get_rat(cereg->act);
+
+		if (rat) {
+			timeout_ms = tracker_timeout_ms(rat);
+		}
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return timeout_ms ? (int)timeout_ms : -ENODATA;
+}
+
+int hio_lte_rtt_get(int index, struct hio_lte_rtt_entry *entry)
+{
+	if (!entry || index < 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	const struct tracker *tracker = NULL;
+
+	if ((size_t)index < ARRAY_SIZE(m_rats)) {
+		tracker = &m_rats[index];
+		entry->act = m_rat_acts[index];
+		entry->eci = HIO_LTE_CELL_ECI_INVALID;
+	} else {
+		/* Skip the unused slots */
+		int n = index - ARRAY_SIZE(m_rats);
+
+		for (size_t i = 0; i < ARRAY_SIZE(m_cells); i++) {
+			if (m_cells[i].used && !n--) {
+				tracker = &m_cells[i].tracker;
+				entry->act = m_cells[i].act;
+				entry->eci = m_cells[i].eci;
+				break;
+			}
+		}
+	}
+
+	if (!tracker) {
+		k_mutex_unlock(&m_lock);
+		return -ENOENT;
+	}
+
+	entry->samples = tracker->count;
+	entry->timeouts = tracker->timeouts;
+	entry->backoff = tracker->backoff;
+	entry->percentile_ms = tracker_percentile_ms(tracker);
+	entry->timeout_ms = tracker_timeout_ms(tracker);
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
@@ -0,0 +1,75 @@
+#ifndef SUBSYS_HIO_LTE_RTT_H_
+#define SUBSYS_HIO_LTE_RTT_H_
+
+#include "hio_lte_util.h"
+
+/* HIO includes */
+#include <hio/hio_lte.h>
+
+/* Standard includes */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Downlink response time learned per access technology and per serving cell.
+ * The receive timeout follows a high percentile of the recent replies instead
+ * of the static rules of hio_lte_util_recv_timeout_sec. The tables live in RAM,
+ * which PSM retains, so what was learned carries over the sleeps. */
+
+/* Replies kept per cell and per access technology */
+#define HIO_LTE_RTT_SAMPLES 16
+/* Replies needed before a table sets the timeout */
+#define HIO_LTE_RTT_SAMPLES_MIN 4
+/* Percentile of the response time the timeout is derived from */
+#define HIO_LTE_RTT_PERCENTILE 90
+/* The timeout covers twice the percentile for the replies beyond it */
+#define HIO_LTE_RTT_TIMEOUT_MULT 2
+/* A good LTE-M cell still needs time for the server and the paging cycle */
+#define HIO_LTE_RTT_TIMEOUT_MIN_MS 2000
+/* Consecutive timeouts double the timeout up to this many times; every reply
+ * takes one doubling back */
+#define HIO_LTE_RTT_BACKOFF_MAX 3
+/* Never wait longer than the static rules would */
+#define HIO_LTE_RTT_TIMEOUT_MAX_MS (HIO_LTE_UTIL_RECV_TIMEOUT_MAX_SEC * 1000)
+
+struct hio_lte_rtt_entry {
+	/* Access technology, see enum hio_lte_cereg_param_act */
+	int act;
+	/* E-UTRAN cell identity, HIO_LTE_CELL_ECI_INVALID for the whole technology */
+	uint32_t eci;
+	/* Replies in the table */
+	uint16_t samples;
+	/* Receives that timed out since the table was created; censored, they
+	 * are not part of the replies */
+	uint16_t timeouts;
+	/* Doublings of the timeout currently applied after timeouts */
+	uint8_t backoff;
+	/* Learned percentile of the response time (ms), 0 without replies */
+	uint32_t percentile_ms;
+	/* Receive timeout the table sets (ms), 0 with too few replies */
+	uint32_t timeout_ms;
+};
+
+void hio_lte_rtt_init(void);
+
+/* A reply arrived @p ms after the receive started */
+void hio_lte_rtt_add(const struct hio_lte_cereg_param *cereg, uint32_t ms);
+
+/* No reply arrived within @p timeout_ms; backs the timeout off without
+ * touching the learned percentile */
+void hio_lte_rtt_timeout(const struct hio_lte_cereg_param *cereg, uint32_t timeout_ms);
+
+/* Learned receive timeout for the serving cell, else for its technology;
+ * -ENODATA while neither has enough replies */
+int hio_lte_rtt_get_timeout_ms(const struct hio_lte_cereg_param *cereg);
+
+/* Technologies first, then cells; -ENOENT past the last one */
+int hio_lte_rtt_get(int index, struct hio_lte_rtt_entry *entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_RTT_H_ */
@@ -1,7 +1,11 @@
+#include "hio_lte_cache.h"
 #include "hio_lte_config.h"
 #include "hio_lte_flow.h"
+#include "hio_lte_plan.h"
+#include "hio_lte_rtt.h"
 #include "hio_lte_state.h"
 #include "hio_lte_talk.h"
+#include "hio_lte_trace.h"
 
 /* HIO includes */
 #include <hio/hio_lte.h>
@@ -219,6 +223,38 @@ static int cmd_state(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+static void print_hist(const struct shell *shell, const char *name,
+		       const struct hio_lte_hist *hist)
+{
+	char buf[HIO_LTE_HIST_BUCKETS * 20];
+	size_t len = 0;
+
+	shell_print(shell, "%s: %u (p50 %u ms, p90 %u ms, p99 %u ms, max %u ms)", name,
+		    hist->count, hio_lte_hist_percentile_ms(hist, 50),
+		    hio_lte_hist_percentile_ms(hist, 90), hio_lte_hist_percentile_ms(hist, 99),
+		    hist->max_ms);
+
+	if (!hist->count) {
+		return;
+	}
+
+	buf[0] = '\0';
+
+	for (int i = 0; i < HIO_LTE_HIST_BUCKETS && len < sizeof(buf); i++) {
+		uint32_t edge = hio_lte_hist_edge_ms(i);
+
+		if (edge == UINT32_MAX) {
+			len += snprintf(&buf[len], sizeof(buf) - len, " >=%u:%u",
+					hio_lte_hist_edge_ms(i - 1), hist->buckets[i]);
+		} else {
+			len += snprintf(&buf[len], sizeof(buf) - len, " <%u:%u", edge,
+					hist->buckets[i]);
+		}
+	}
+
+	shell_print(shell, "%s buckets (ms):%s", name, buf);
+}
+
 static int cmd_metrics(const struct shell *shell, size_t argc, char **argv)
 {
 	int ret;
@@ -229,21 +265,262 @@ static int cmd_metrics(const struct shell *shell, size_t argc, char **argv)
 		return -EINVAL;
 	}
 
-	struct hio_lte_metrics metrics;
+	/* Too large for the shell stack */
+	static struct hio_lte_metrics metrics;
 	ret = hio_lte_get_metrics(&metrics);
 	if (ret) {
 		shell_error(shell, "hio_lte_get_metrics failed: %d", ret);
 		return ret;
 	}
 
+	shell_print(shell, "attach hint: %u (%u ms avg)", metrics.attach_hint_count,
+		    metrics.attach_hint_count
+			    ? metrics.attach_hint_duration_ms / metrics.attach_hint_count
+			    : 0);
+	shell_print(shell, "attach hint fallbacks: %u", metrics.attach_hint_fallback_count);
+	shell_print(shell, "attach full: %u (%u ms avg)", metrics.attach_full_count,
+		    metrics.attach_full_count
+			    ? metrics.attach_full_duration_ms / metrics.attach_full_count
+			    : 0);
 	shell_print(shell, "uplink messages: %u", metrics.uplink_count);
 	shell_print(shell, "uplink bytes: %u", metrics.uplink_bytes);
 	shell_print(shell, "uplink errors: %u", metrics.uplink_errors);
 	shell_print(shell, "uplink last ts: %lld", metrics.uplink_last_ts);
+	shell_print(shell, "uplink batched: %u", metrics.uplink_batched);
 	shell_print(shell, "downlink messages: %u", metrics.downlink_count);
 	shell_print(shell, "downlink bytes: %u", metrics.downlink_bytes);
 	shell_print(shell, "downlink errors: %u", metrics.downlink_errors);
 	shell_print(shell, "downlink last ts: %lld", metrics.downlink_last_ts);
+	shell_print(shell, "events: %u", metrics.event_count);
+	shell_print(shell, "events dropped: %u", metrics.event_dropped);
+	shell_print(shell, "events coalesced: %u", metrics.event_coalesced);
+	shell_print(shell, "events max depth: %u", metrics.event_max_depth);
+	shell_print(shell, "deferred evaluations: %u", metrics.defer_evaluations);
+	shell_print(shell, "deferred sent good: %u", metrics.defer_sent_good);
+	shell_print(shell, "deferred sent deadline: %u", metrics.defer_sent_deadline);
+	print_hist(shell, "attach", &metrics.attach_hist);
+	print_hist(shell, "on-air", &metrics.on_air_hist);
+	print_hist(shell, "receive", &metrics.recv_hist);
+	print_hist(shell, "connected", &metrics.connected_hist);
+	shell_print(shell, "transactions: %u", metrics.txn_count);
+	shell_print(shell, "receive timeout lte-m: %u ms", metrics.recv_timeout_ltem_ms);
+	shell_print(shell, "receive timeout nb-iot: %u ms", metrics.recv_timeout_nbiot_ms);
+	shell_print(shell, "gnss requests: %u", metrics.gnss_requests);
+	shell_print(shell, "gnss fixes: %u", metrics.gnss_fixes);
+	shell_print(shell, "gnss timeouts: %u", metrics.gnss_timeouts);
+	shell_print(shell, "gnss errors: %u", metrics.gnss_errors);
+	shell_print(shell, "gnss preempted: %u", metrics.gnss_preempted);
+	shell_print(shell, "gnss blocked: %u", metrics.gnss_blocked);
+	print_hist(shell, "gnss ttff hot", &metrics.gnss_ttff_hot_hist);
+	print_hist(shell, "gnss ttff cold", &metrics.gnss_ttff_cold_hist);
+	shell_print(shell, "dtls full handshakes: %u", metrics.dtls_full_handshakes);
+	shell_print(shell, "dtls resumed handshakes: %u", metrics.dtls_resumed_handshakes);
+	shell_print(shell, "dtls restored: %u", metrics.dtls_restored);
+	shell_print(shell, "dtls handshake bytes: %u", metrics.dtls_handshake_bytes);
+	shell_print(shell, "dtls saves: %u", metrics.dtls_saves);
+	shell_print(shell, "dtls save failures: %u", metrics.dtls_save_failures);
+	shell_print(shell, "dtls load failures: %u", metrics.dtls_load_failures);
+	print_hist(shell, "dtls handshake", &metrics.dtls_handshake_hist);
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
+static void print_permille(const struct shell *shell, const char *name, int permille)
+{
+	if (permille < 0) {
+		shell_print(shell, "%s: unknown", name);
+	} else {
+		shell_print(shell, "%s: %d.%d %%", name, permille / 10, permille % 10);
+	}
+}
+
+static int cmd_psm(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	struct hio_lte_psm_info info;
+	ret = hio_lte_get_psm_info(&info);
+	if (ret) {
+		shell_error(shell, "hio_lte_get_psm_info failed: %d", ret);
+		return ret;
+	}
+
+	shell_print(shell, "interval: %u s", info.interval_s);
+	shell_print(shell, "tau requested: %d s", info.tau_requested_s);
+	shell_print(shell, "tau granted: %d s", info.tau_granted_s);
+	shell_print(shell, "active time requested: %d s", info.active_requested_s);
+	shell_print(shell, "active time granted: %d s", info.active_granted_s);
+	print_permille(shell, "sleep predicted", info.sleep_predicted_permille);
+	print_permille(shell, "sleep observed", info.sleep_observed_permille);
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
+static const char *plan_step_result_str(enum hio_lte_plan_step_result result)
+{
+	switch (result) {
+	case HIO_LTE_PLAN_STEP_RESULT_OK:
+		return "ok";
+	case HIO_LTE_PLAN_STEP_RESULT_SKIPPED:
+		return "skipped";
+	case HIO_LTE_PLAN_STEP_RESULT_CACHED:
+		return "cached";
+	case HIO_LTE_PLAN_STEP_RESULT_FAILED:
+		return "failed";
+	}
+
+	return "unknown";
+}
+
+static int cmd_plan(const struct shell *shell, size_t argc, char **argv)
+{
+	/* Too large for the shell stack */
+	static struct hio_lte_plan_trace trace;
+
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	for (int i = 0; !hio_lte_plan_get_trace(i, &trace); i++) {
+		shell_print(shell, "plan %s: %u ms (err %d, ts %lld)", trace.plan,
+			    trace.duration_ms, trace.err, trace.timestamp);
+
+		for (size_t j = 0; j < MIN(trace.count, ARRAY_SIZE(trace.steps)); j++) {
+			const struct hio_lte_plan_trace_step *step = &trace.steps[j];
+
+			shell_print(shell, "  %-14s %-7s %5u ms (attempts %u, err %d)", step->name,
+				    plan_step_result_str(step->result), step->duration_ms,
+				    step->attempts, step->err);
+		}
+	}
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
+static int cmd_rtt(const struct shell *shell, size_t argc, char **argv)
+{
+	struct hio_lte_rtt_entry entry;
+
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	for (int i = 0; !hio_lte_rtt_get(i, &entry); i++) {
+		const char *act = entry.act == HIO_LTE_CEREG_PARAM_ACT_NBIOT ? "nb-iot" : "lte-m";
+		char eci[12] = "all";
+
+		if (entry.eci != HIO_LTE_CELL_ECI_INVALID) {
+			snprintf(eci, sizeof(eci), "%08X", entry.eci);
+		}
+
+		shell_print(shell,
+			    "%s eci %s: p%d %u ms, timeout %u ms, replies %u, timeouts %u, "
+			    "backoff x%u",
+			    act, eci, HIO_LTE_RTT_PERCENTILE, entry.percentile_ms,
+			    entry.timeout_ms, entry.samples, entry.timeouts, 1U << entry.backoff);
+	}
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
+static int cmd_transactions(const struct shell *shell, size_t argc, char **argv)
+{
+	struct hio_lte_metrics_txn txn;
+
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	for (int i = 0; !hio_lte_get_metrics_txn(i, &txn); i++) {
+		char rsrp[8] = "-";
+
+		if (txn.rsrp != INT16_MIN) {
+			snprintf(rsrp, sizeof(rsrp), "%d", txn.rsrp);
+		}
+
+		shell_print(shell,
+			    "%10u ms err %d: %u x %u B / %u B, on-air %u ms, receive %u ms, "
+			    "connected %u ms, attempts %u, eci %08X, rsrp %s dBm",
+			    txn.timestamp, txn.result, txn.datagrams, txn.send_len, txn.recv_len,
+			    txn.on_air_ms, txn.recv_ms, txn.connected_ms, txn.attempts, txn.eci,
+			    rsrp);
+	}
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
+static int cmd_trace(const struct shell *shell, size_t argc, char **argv)
+{
+	struct hio_lte_trace_entry entry;
+
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	for (int i = 0; !hio_lte_trace_get(i, &entry); i++) {
+		if (entry.flags & HIO_LTE_TRACE_FLAG_TRANSITION) {
+			shell_print(shell, "%10u ms %-12s -> %-12s (event %s, err %d)",
+				    entry.timestamp, hio_lte_trace_state_str(entry.from),
+				    hio_lte_trace_state_str(entry.to),
+				    hio_lte_trace_event_str(entry.event), entry.result);
+		} else {
+			shell_print(shell, "%10u ms %-12s event %s -> %s (ret %d)", entry.timestamp,
+				    hio_lte_trace_state_str(entry.from),
+				    hio_lte_trace_event_str(entry.event),
+				    hio_lte_trace_state_str(entry.to), entry.result);
+		}
+	}
+
+	shell_print(shell, "records: %u", hio_lte_trace_get_total());
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
+static int cmd_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	struct hio_lte_trace_dwell dwell;
+
+	if (argc > 1) {
+		shell_error(shell, "command not found: %s", argv[1]);
+		shell_help(shell);
+		return -EINVAL;
+	}
+
+	for (uint8_t state = 0; state < HIO_LTE_TRACE_STATES_MAX; state++) {
+		if (hio_lte_trace_get_dwell(state, &dwell) || !dwell.entries) {
+			continue;
+		}
+
+		shell_print(shell, "%-12s %10llu ms (entered %u times)",
+			    hio_lte_trace_state_str(state), (unsigned long long)dwell.total_ms,
+			    dwell.entries);
+	}
 
 	shell_print(shell, "command succeeded");
 
@@ -310,6 +587,12 @@ static int cmd_test_cmd(const struct shell *shell, size_t argc, char **argv)
 		return -ENOEXEC;
 	}
 
+	/* Raw AT commands may change settings covered by the modem cache */
+	ret = hio_lte_cache_invalidate();
+	if (ret) {
+		LOG_WRN("Call `hio_lte_cache_invalidate` failed: %d", ret);
+	}
+
 	ret = hio_lte_flow_cmd(argv[1]);
 	if (ret) {
 		if (ret == -ENOTCONN) {
@@ -416,6 +699,11 @@ static int cmd_test_bypass(const struct shell *shell, size_t argc, char **argv)
 		return -ENOEXEC;
 	}
 
+	int ret = hio_lte_cache_invalidate();
+	if (ret) {
+		LOG_WRN("Call `hio_lte_cache_invalidate` failed: %d", ret);
+	}
+
 	hio_lte_talk_bypass_set_cb(flow_bypass_cb, (void *)shell->fprintf_ctx);
 #if NCS_VERSION_NUMBER >= 0x30400
 	shell_set_bypass(shell, shell_bypass_cb, NULL);
@@ -496,6 +784,45 @@ static int cmd_ncellmeas_schedule(const struct shell *shell, size_t argc, char *
 	return 0;
 }
 
+static int cmd_gnss_fix(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	if (g_hio_lte_config.test) {
+		shell_error(shell, "not supported in test mode");
+		return -ENOEXEC;
+	}
+
+	int timeout = CONFIG_HIO_LTE_GNSS_FIX_TIMEOUT;
+	if (argc > 1) {
+		timeout = atoi(argv[1]);
+		if (timeout <= 0) {
+			shell_error(shell, "invalid timeout");
+			return -EINVAL;
+		}
+	}
+
+	struct hio_lte_gnss_fix fix;
+	ret = hio_lte_gnss_get_fix(&fix, K_SECONDS(timeout));
+	if (ret) {
+		LOG_ERR("Call `hio_lte_gnss_get_fix` failed: %d", ret);
+		shell_error(shell, "command failed");
+		return ret;
+	}
+
+	shell_print(shell, "latitude: %.6f", fix.latitude);
+	shell_print(shell, "longitude: %.6f", fix.longitude);
+	shell_print(shell, "altitude: %.1f m", (double)fix.altitude);
+	shell_print(shell, "accuracy: %.1f m", (double)fix.accuracy);
+	shell_print(shell, "satellites: %u", fix.satellites);
+	shell_print(shell, "timestamp: %lld", (long long)fix.timestamp);
+	shell_print(shell, "time to fix: %u ms (%s start)", fix.ttff_ms, fix.hot ? "hot" : "cold");
+
+	shell_print(shell, "command succeeded");
+
+	return 0;
+}
+
 static int print_help(const struct shell *shell, size_t argc, char **argv)
 {
 	if (argc > 1) {
@@ -564,6 +891,30 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		     "Get LTE metrics.",
 	              cmd_metrics, 1, 0),
 
+	SHELL_CMD_ARG(psm, NULL,
+	              "Get PSM timers and sleep ratio.",
+	              cmd_psm, 1, 0),
+
+	SHELL_CMD_ARG(plan, NULL,
+	              "Get AT plan step timing of the last runs.",
+	              cmd_plan, 1, 0),
+
+	SHELL_CMD_ARG(rtt, NULL,
+	              "Get the learned downlink response times and receive timeouts.",
+	              cmd_rtt, 1, 0),
+
+	SHELL_CMD_ARG(transactions, NULL,
+	              "Get timing, cell and RSRP of the last transactions.",
+	              cmd_transactions, 1, 0),
+
+	SHELL_CMD_ARG(trace, NULL,
+	              "Get FSM state transitions and events.",
+	              cmd_trace, 1, 0),
+
+	SHELL_CMD_ARG(stats, NULL,
+	              "Get time spent in each FSM state.",
+	              cmd_stats, 1, 0),
+
 	SHELL_CMD_ARG(test, &sub_lte_test,
 	              "Test commands.",
 	              print_help, 1, 0),
@@ -576,6 +927,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 	              "Schedule NCELLMEAS measurement.",
 	              cmd_ncellmeas_schedule, 1, 0),
 
+	SHELL_CMD_ARG(gnss-fix, NULL,
+	              "Get a GNSS fix in the LTE idle windows (format: [timeout_s]).",
+	              cmd_gnss_fix, 1, 1),
+
 
 	SHELL_SUBCMD_SET_END
 );
@@ -1,8 +1,11 @@
 #include "hio_lte_state.h"
+#include "hio_lte_parse.h"
 
 /* Zephyr includes */
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
 
 /* Standard includes */
 #include <errno.h>
@@ -11,18 +14,113 @@
 #include <stdint.h>
 #include <string.h>
 
-static K_MUTEX_DEFINE(m_lock);
-
+/*
+ * Readers (shell, ATCI, application threads) never block the writers (URC
+ * handlers and the LTE thread) and the other way round:
+ *
+ * - Values that do not fit a word are seqlocked: the writer makes the sequence
+ *   odd, copies and makes it even again; a reader copies and retries when the
+ *   sequence was odd or changed meanwhile. Writers are serialized by a spinlock
+ *   around the short copy, so on a single core a reader never sees a write in
+ *   progress and never spins.
+ * - The strings are returned by pointer, so they are double-buffered: a write
+ *   fills the spare buffer and publishes it. A returned pointer stays intact
+ *   until the second write after the call.
+ */
+
+static struct k_spinlock m_write_lock;
+
+struct seq_value {
+	atomic_t seq;
+};
+
+static struct seq_value m_imei_seq;
 static uint64_t m_imei = 0;
+static struct seq_value m_imsi_seq;
 static uint64_t m_imsi = 0;
-static char m_iccid[22 + 1] = {0};
-static char m_fw_version[64] = {0};
-static char m_ceer[64 + 1] = {0};
+static struct seq_value m_conn_param_seq;
 static struct hio_lte_conn_param m_conn_param = {0};
+static struct seq_value m_cereg_param_seq;
 static struct hio_lte_cereg_param m_cereg_param = {0};
+static struct seq_value m_rai_param_seq;
 static struct hio_lte_rai_param m_rai_param = {0};
+static struct seq_value m_ncellmeas_param_seq;
 static struct hio_lte_ncellmeas_param m_ncellmeas_param = {0};
-static int m_dtls_ciphersuite_used = 0;
+
+static char m_iccid[2][22 + 1] = {0};
+static atomic_t m_iccid_active;
+static char m_fw_version[2][64] = {0};
+static atomic_t m_fw_version_active;
+static char m_ceer[2][64 + 1] = {0};
+static atomic_t m_ceer_active;
+
+static atomic_t m_dtls_ciphersuite_used = ATOMIC_INIT(0);
+
+static k_spinlock_key_t seq_write_begin(struct seq_value *value)
+{
+	k_spinlock_key_t key = k_spin_lock(&m_write_lock);
+
+	atomic_inc(&value->seq);
+	barrier_dmem_fence_full();
+
+	return key;
+}
+
+static void seq_write_end(struct seq_value *value, k_spinlock_key_t key)
+{
+	barrier_dmem_fence_full();
+	atomic_inc(&value->seq);
+
+	k_spin_unlock(&m_write_lock, key);
+}
+
+static void seq_write(struct seq_value *value, void *dst, const void *src, size_t len)
+{
+	k_spinlock_key_t key = seq_write_begin(value);
+
+	memcpy(dst, src, len);
+
+	seq_write_end(value, key);
+}
+
+static void seq_read(const struct seq_value *value, void *dst, const void *src, size_t len)
+{
+	for (;;) {
+		atomic_val_t seq = atomic_get(&value->seq);
+
+		/* Only another core can be in the middle of a write */
+		if (seq & 1) {
+			continue;
+		}
+
+		barrier_dmem_fence_full();
+		memcpy(dst, src, len);
+		barrier_dmem_fence_full();
+
+		if (atomic_get(&value->seq) == seq) {
+			return;
+		}
+	}
+}
+
+/* @p bufs holds the two buffers of @p size bytes each */
+static void text_write(char *bufs, size_t size, atomic_t *active, const char *text)
+{
+	K_SPINLOCK(&m_write_lock) {
+		char *spare = bufs + (1 - atomic_get(active)) * size;
+
+		strncpy(spare, text, size - 1);
+		spare[size - 1] = '\0';
+
+		barrier_dmem_fence_full();
+		atomic_set(active, spare == bufs ? 0 : 1);
+	}
+}
+
+static char *text_get(char *bufs, size_t size, const atomic_t *active)
+{
+	return bufs + atomic_get(active) * size;
+}
 
 int hio_lte_state_get_imei(uint64_t *imei)
 {
@@ -30,22 +128,14 @@ int hio_lte_state_get_imei(uint64_t *imei)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	*imei = m_imei;
-
-	k_mutex_unlock(&m_lock);
+	seq_read(&m_imei_seq, imei, &m_imei, sizeof(m_imei));
 
 	return *imei ? 0 : -ENODATA;
 }
 
 void hio_lte_state_set_imei(uint64_t imei)
 {
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	m_imei = imei;
-
-	k_mutex_unlock(&m_lock);
+	seq_write(&m_imei_seq, &m_imei, &imei, sizeof(m_imei));
 }
 
 int hio_lte_state_get_imsi(uint64_t *imsi)
@@ -54,22 +144,14 @@ int hio_lte_state_get_imsi(uint64_t *imsi)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	*imsi = m_imsi;
-
-	k_mutex_unlock(&m_lock);
+	seq_read(&m_imsi_seq, imsi, &m_imsi, sizeof(m_imsi));
 
 	return *imsi ? 0 : -ENODATA;
 }
 
 void hio_lte_state_set_imsi(uint64_t imsi)
 {
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	m_imsi = imsi;
-
-	k_mutex_unlock(&m_lock);
+	seq_write(&m_imsi_seq, &m_imsi, &imsi, sizeof(m_imsi));
 }
 
 int hio_lte_state_get_iccid(char **iccid)
@@ -78,11 +160,7 @@ int hio_lte_state_get_iccid(char **iccid)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	*iccid = m_iccid;
-
-	k_mutex_unlock(&m_lock);
+	*iccid = text_get(m_iccid[0], sizeof(m_iccid[0]), &m_iccid_active);
 
 	return *iccid[0] != 0 ? 0 : -ENODATA;
 }
@@ -93,11 +171,7 @@ void hio_lte_state_set_iccid(const char *iccid)
 		return;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	strncpy(m_iccid, iccid, sizeof(m_iccid));
-
-	k_mutex_unlock(&m_lock);
+	text_write(m_iccid[0], sizeof(m_iccid[0]), &m_iccid_active, iccid);
 }
 
 int hio_lte_state_get_modem_fw_version(char **version)
@@ -106,13 +180,9 @@ int hio_lte_state_get_modem_fw_version(char **version)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	*version = m_fw_version;
+	*version = text_get(m_fw_version[0], sizeof(m_fw_version[0]), &m_fw_version_active);
 
-	k_mutex_unlock(&m_lock);
-
-	return m_fw_version[0] != 0 ? 0 : -ENODATA;
+	return *version[0] != 0 ? 0 : -ENODATA;
 }
 
 void hio_lte_state_set_modem_fw_version(const char *version)
@@ -121,11 +191,7 @@ void hio_lte_state_set_modem_fw_version(const char *version)
 		return;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	strncpy(m_fw_version, version, sizeof(m_fw_version));
-
-	k_mutex_unlock(&m_lock);
+	text_write(m_fw_version[0], sizeof(m_fw_version[0]), &m_fw_version_active, version);
 }
 
 int hio_lte_state_get_ceer(char **ceer)
@@ -134,13 +200,9 @@ int hio_lte_state_get_ceer(char **ceer)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	*ceer = m_ceer;
+	*ceer = text_get(m_ceer[0], sizeof(m_ceer[0]), &m_ceer_active);
 
-	k_mutex_unlock(&m_lock);
-
-	return m_ceer[0] != 0 ? 0 : -ENODATA;
+	return *ceer[0] != 0 ? 0 : -ENODATA;
 }
 
 void hio_lte_state_set_ceer(const char *ceer)
@@ -149,12 +211,7 @@ void hio_lte_state_set_ceer(const char *ceer)
 		return;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	strncpy(m_ceer, ceer, sizeof(m_ceer) - 1);
-	m_ceer[sizeof(m_ceer) - 1] = '\0';
-
-	k_mutex_unlock(&m_lock);
+	text_write(m_ceer[0], sizeof(m_ceer[0]), &m_ceer_active, ceer);
 }
 
 int hio_lte_state_get_conn_param(struct hio_lte_conn_param *param)
@@ -163,11 +220,7 @@ int hio_lte_state_get_conn_param(struct hio_lte_conn_param *param)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	memcpy(param, &m_conn_param, sizeof(m_conn_param));
-
-	k_mutex_unlock(&m_lock);
+	seq_read(&m_conn_param_seq, param, &m_conn_param, sizeof(m_conn_param));
 
 	return 0;
 }
@@ -178,11 +231,7 @@ void hio_lte_state_set_conn_param(const struct hio_lte_conn_param *param)
 		return;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	memcpy(&m_conn_param, param, sizeof(m_conn_param));
-
-	k_mutex_unlock(&m_lock);
+	seq_write(&m_conn_param_seq, &m_conn_param, param, sizeof(m_conn_param));
 }
 
 int hio_lte_state_get_cereg_param(struct hio_lte_cereg_param *param)
@@ -191,11 +240,7 @@ int hio_lte_state_get_cereg_param(struct hio_lte_cereg_param *param)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	memcpy(param, &m_cereg_param, sizeof(m_cereg_param));
-
-	k_mutex_unlock(&m_lock);
+	seq_read(&m_cereg_param_seq, param, &m_cereg_param, sizeof(m_cereg_param));
 
 	return 0;
 }
@@ -206,11 +251,7 @@ void hio_lte_state_set_cereg_param(const struct hio_lte_cereg_param *param)
 		return;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	memcpy(&m_cereg_param, param, sizeof(m_cereg_param));
-
-	k_mutex_unlock(&m_lock);
+	seq_write(&m_cereg_param_seq, &m_cereg_param, param, sizeof(m_cereg_param));
 }
 
 int hio_lte_state_get_rai_param(struct hio_lte_rai_param *param)
@@ -219,11 +260,7 @@ int hio_lte_state_get_rai_param(struct hio_lte_rai_param *param)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	memcpy(param, &m_rai_param, sizeof(m_rai_param));
-
-	k_mutex_unlock(&m_lock);
+	seq_read(&m_rai_param_seq, param, &m_rai_param, sizeof(m_rai_param));
 
 	return 0;
 }
@@ -234,11 +271,7 @@ void hio_lte_state_set_rai_param(const struct hio_lte_rai_param *param)
 		return;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	memcpy(&m_rai_param, param, sizeof(m_rai_param));
-
-	k_mutex_unlock(&m_lock);
+	seq_write(&m_rai_param_seq, &m_rai_param, param, sizeof(m_rai_param));
 }
 
 int hio_lte_state_get_ncellmeas_param(struct hio_lte_ncellmeas_param *param)
@@ -247,11 +280,11 @@ int hio_lte_state_get_ncellmeas_param(struct hio_lte_ncellmeas_param *param)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
+	seq_read(&m_ncellmeas_param_seq, param, &m_ncellmeas_param, sizeof(m_ncellmeas_param));
 
-	memcpy(param, &m_ncellmeas_param, sizeof(m_ncellmeas_param));
+	/* The copy still points at the neighbors of the stored one */
+	hio_lte_parse_ncellmeas_link(param);
 
-	k_mutex_unlock(&m_lock);
 	return 0;
 }
 
@@ -261,22 +294,19 @@ void hio_lte_state_set_ncellmeas_param(const struct hio_lte_ncellmeas_param *par
 		return;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
+	k_spinlock_key_t key = seq_write_begin(&m_ncellmeas_param_seq);
 
 	memcpy(&m_ncellmeas_param, param, sizeof(m_ncellmeas_param));
 
+	/* Writers are serialized, so the CEREG one is stable here */
 	m_ncellmeas_param.act = m_cereg_param.act;
 
-	k_mutex_unlock(&m_lock);
+	seq_write_end(&m_ncellmeas_param_seq, key);
 }
 
 void hio_lte_state_set_dtls_ciphersuite_used(const int cipher)
 {
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	m_dtls_ciphersuite_used = cipher;
-
-	k_mutex_unlock(&m_lock);
+	atomic_set(&m_dtls_ciphersuite_used, cipher);
 }
 
 int hio_lte_get_dtls_ciphersuite_used(int *cipher)
@@ -285,11 +315,7 @@ int hio_lte_get_dtls_ciphersuite_used(int *cipher)
 		return -EINVAL;
 	}
 
-	k_mutex_lock(&m_lock, K_FOREVER);
-
-	*cipher = m_dtls_ciphersuite_used;
-
-	k_mutex_unlock(&m_lock);
+	*cipher = atomic_get(&m_dtls_ciphersuite_used);
 
 	return 0;
 }
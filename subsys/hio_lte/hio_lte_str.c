@@ -136,6 +136,8 @@ const char *hio_lte_str_fsm_event(enum hio_lte_fsm_event event)
 		return "SOCKET_RECONFIG";
 	case HIO_LTE_FSM_EVENT_DISABLE:
 		return "DISABLE";
+	case HIO_LTE_FSM_EVENT_RAI:
+		return "RAI";
 	case HIO_LTE_FSM_EVENT_COUNT:
 		return "for internal use only";
 	}
@@ -1,3 +1,4 @@
+#include "hio_lte_resp.h"
 #include "hio_lte_talk.h"
 
 /* NRF includes */
@@ -11,19 +12,34 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
+/* Standard includes */
 #include <ctype.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(hio_lte_talk, CONFIG_HIO_LTE_LOG_LEVEL);
 
 AT_MONITOR(hio_lte_flow, ANY, urc);
 
+static K_MUTEX_DEFINE(m_talk_lock);
 static char m_talk_buffer[512];
 static hio_lte_talk_cb m_cb = NULL;
 static void *m_cb_user_data = NULL;
 static hio_lte_talk_bypass_cb m_bypass_cb = NULL;
 static void *m_bypass_cb_user_data = NULL;
+/* Thread running a quiet AT plan; the others keep their echo */
+static k_tid_t m_quiet_thread = NULL;
+
+/* Command/response echo; demoted to debug while quiet */
+#define LOG_TALK(...)                                                                              \
+	do {                                                                                       \
+		if (m_quiet_thread == k_current_get()) {                                           \
+			LOG_DBG(__VA_ARGS__);                                                      \
+		} else {                                                                           \
+			LOG_INF(__VA_ARGS__);                                                      \
+		}                                                                                  \
+	} while (0)
 
 static void urc(const char *line)
 {
@@ -31,11 +47,8 @@ static void urc(const char *line)
 		m_bypass_cb(m_bypass_cb_user_data, (const uint8_t *)line, strlen(line));
 	}
 
-	for (size_t i = 0; i < strlen(line); i++) {
-		if (line[i] == '\r' || line[i] == '\n') {
-			((char *)line)[i] = '\0';
-		}
-	}
+	/* The notification is a single line; cut it at the first CR/LF */
+	((char *)line)[strcspn(line, "\r\n")] = '\0';
 
 	LOG_INF("%s", line);
 
@@ -44,40 +57,6 @@ static void urc(const char *line)
 	}
 }
 
-static int gather_prefix_values(const char *prefix, char *out_buf, size_t out_buf_size,
-				int max_lines)
-{
-	size_t prefix_len = strlen(prefix);
-	size_t used = 0;
-	int found = 0;
-
-	out_buf[0] = '\0';
-
-	char *line = strtok(m_talk_buffer, "\r\n");
-	while (line != NULL) {
-		if (!strncmp(line, prefix, prefix_len)) {
-			char *value = line + prefix_len;
-			size_t val_len = strlen(value);
-
-			if (used + val_len + 1 > out_buf_size) {
-				return -ENOSPC;
-			}
-
-			memcpy(out_buf + used, value, val_len);
-			used += val_len;
-			out_buf[used++] = '\0';
-
-			found++;
-			if (max_lines > 0 && found >= max_lines) {
-				break;
-			}
-		}
-		line = strtok(NULL, "\r\n");
-	}
-
-	return found;
-}
-
 /* Split to tx and rx function is for nice logging */
 static void rx(const char *ptr)
 {
@@ -86,7 +65,7 @@ static void rx(const char *ptr)
 	while (*ptr != '\0') {
 		if (*ptr == '\r' || *ptr == '\n') {
 			if (line_start < ptr) {
-				LOG_INF("%.*s", (int)(ptr - line_start), line_start);
+				LOG_TALK("%.*s", (int)(ptr - line_start), line_start);
 			}
 			while (*ptr == '\r' || *ptr == '\n') {
 				ptr++;
@@ -97,24 +76,24 @@ static void rx(const char *ptr)
 		}
 	}
 	if (line_start < ptr) {
-		LOG_INF("%.*s", (int)(ptr - line_start), line_start);
+		LOG_TALK("%.*s", (int)(ptr - line_start), line_start);
 	}
 }
 
-static int tx(bool async, const char *fmt, va_list args)
+static int tx(bool async, char *resp, size_t size, const char *fmt, va_list args)
 {
 	int ret;
-	static char cmd_buf[256];
+	char cmd_buf[256];
 
 	vsnprintf(cmd_buf, sizeof(cmd_buf), fmt, args);
-	LOG_INF("%s", cmd_buf);
+	LOG_TALK("%s", cmd_buf);
 
 	if (async) {
-		m_talk_buffer[0] = '\0';
 		ret = nrf_modem_at_cmd_async(rx, "%s", cmd_buf);
 	} else {
-		ret = nrf_modem_at_cmd(m_talk_buffer, sizeof(m_talk_buffer), "%s", cmd_buf);
-		m_talk_buffer[sizeof(m_talk_buffer) - 1] = '\0';
+		resp[0] = '\0';
+		ret = nrf_modem_at_cmd(resp, size, "%s", cmd_buf);
+		resp[size - 1] = '\0';
 	}
 
 	if (ret < 0) {
@@ -130,22 +109,78 @@ static int tx(bool async, const char *fmt, va_list args)
 	return ret;
 }
 
-static int cmd(const char *fmt, ...)
+static int vcmd_resp(char *resp, size_t size, const char *fmt, va_list args)
+{
+	int ret = tx(false, resp, size, fmt, args);
+
+	if (!ret) {
+		rx(resp);
+		if (m_bypass_cb) {
+			m_bypass_cb(m_bypass_cb_user_data, (const uint8_t *)resp, strlen(resp));
+		}
+	}
+
+	return ret;
+}
+
+/* Response goes to the caller's buffer, which has to hold all of it */
+static int cmd_resp(char *resp, size_t size, const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	int ret = vcmd_resp(resp, size, fmt, args);
+	va_end(args);
+
+	return ret;
+}
+
+/* The value of the first response line starting with @p pfx is copied to
+ * @p buf; the response itself is received into the shared buffer */
+static int cmd_value(char *buf, size_t size, const char *pfx, const char *fmt, ...)
 {
+	struct hio_lte_resp resp;
+	const char *value;
+	size_t len;
 	va_list args;
 
+	buf[0] = '\0';
+
+	k_mutex_lock(&m_talk_lock, K_FOREVER);
+
 	va_start(args, fmt);
-	int ret = tx(false, fmt, args);
+	int ret = vcmd_resp(m_talk_buffer, sizeof(m_talk_buffer), fmt, args);
 	va_end(args);
 
 	if (!ret) {
-		rx(m_talk_buffer);
-		if (m_bypass_cb) {
-			m_bypass_cb(m_bypass_cb_user_data, (const uint8_t *)m_talk_buffer,
-				    strlen(m_talk_buffer));
+		hio_lte_resp_init(&resp, m_talk_buffer);
+
+		value = hio_lte_resp_value(&resp, pfx, &len);
+		if (!value) {
+			ret = -EILSEQ;
+		} else {
+			ret = hio_lte_resp_copy(value, len, buf, size);
 		}
 	}
 
+	k_mutex_unlock(&m_talk_lock);
+
+	return ret;
+}
+
+/* Commands whose response is only logged */
+static int cmd(const char *fmt, ...)
+{
+	va_list args;
+
+	k_mutex_lock(&m_talk_lock, K_FOREVER);
+
+	va_start(args, fmt);
+	int ret = vcmd_resp(m_talk_buffer, sizeof(m_talk_buffer), fmt, args);
+	va_end(args);
+
+	k_mutex_unlock(&m_talk_lock);
+
 	return ret;
 }
 
@@ -155,7 +190,7 @@ static int cmd_async(const char *fmt, ...)
 	int ret;
 
 	va_start(args, fmt);
-	ret = tx(true, fmt, args);
+	ret = tx(true, NULL, 0, fmt, args);
 	va_end(args);
 
 	return ret;
@@ -172,13 +207,13 @@ int hio_lte_talk_at_cclk_q(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT+CCLK?");
+	ret = cmd_value(buf, size, "+CCLK: ", "AT+CCLK?");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("+CCLK: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_ceppi(int p1)
@@ -270,13 +305,13 @@ int hio_lte_talk_at_cgdcont_q(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT+CGDCONT?");
+	ret = cmd_resp(buf, size, "AT+CGDCONT?");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_resp` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("+CGDCONT: ", buf, size, 0);
+	return 0;
 }
 
 int hio_lte_talk_at_cgerep(int p1)
@@ -296,26 +331,26 @@ int hio_lte_talk_at_cgsn(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT+CGSN=1");
+	ret = cmd_value(buf, size, "+CGSN: ", "AT+CGSN=1");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("+CGSN: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_cimi(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT+CIMI");
+	ret = cmd_value(buf, size, "", "AT+CIMI");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_iccid(char *buf, size_t size)
@@ -353,26 +388,26 @@ int hio_lte_talk_at_coneval(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT%%CONEVAL");
+	ret = cmd_resp(buf, size, "AT%%CONEVAL");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_resp` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("%CONEVAL: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_cops_q(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT+COPS?");
+	ret = cmd_value(buf, size, "+COPS: ", "AT+COPS?");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("+COPS: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_cops(int p1, int *p2, const char *p3)
@@ -438,13 +473,13 @@ int hio_lte_talk_at_hwversion(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT%%HWVERSION");
+	ret = cmd_value(buf, size, "%HWVERSION: ", "AT%%HWVERSION");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("%HWVERSION: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_mdmev(int p1)
@@ -490,13 +525,13 @@ int hio_lte_talk_at_shortswver(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT%%SHORTSWVER");
+	ret = cmd_value(buf, size, "%SHORTSWVER: ", "AT%%SHORTSWVER");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("%SHORTSWVER: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_xbandlock(int p1, const char *p2)
@@ -598,14 +633,14 @@ int hio_lte_talk_at_xsocket(int p1, int *p2, int *p3, char *buf, size_t size)
 	int ret;
 
 	if (!p2 && !p3) {
-		ret = cmd("AT#XSOCKET=%d", p1);
+		ret = cmd_value(buf, size, "#XSOCKET: ", "AT#XSOCKET=%d", p1);
 	} else if (p2 && p3) {
-		ret = cmd("AT#XSOCKET=%d,%d,%d", p1, *p2, *p3);
+		ret = cmd_value(buf, size, "#XSOCKET: ", "AT#XSOCKET=%d,%d,%d", p1, *p2, *p3);
 	} else {
 		return -EINVAL;
 	}
 
-	return gather_prefix_values("#XSOCKET: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return ret;
 }
 
 int hio_lte_talk_at_xsocketopt(int p1, int p2, int *p3)
@@ -682,13 +717,13 @@ int hio_lte_talk_at_xversion(char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("AT#XVERSION");
+	ret = cmd_value(buf, size, "#XVERSION: ", "AT#XVERSION");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("#XVERSION: ", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_xmodemtrace(int lvl)
@@ -732,31 +767,28 @@ int hio_lte_talk_crsm_176(char *buf, size_t size)
 		return -ENOBUFS;
 	}
 
-	ret = cmd("AT+CRSM=176,28539,0,0,12");
+	ret = cmd_value(buf, size, "+CRSM: 144,0,", "AT+CRSM=176,28539,0,0,12");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("+CRSM: 144,0,", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_crsm_214()
 {
 	int ret;
 
-	char buf[4] = {0};
+	char buf[64];
 
-	ret = cmd("AT+CRSM=214,28539,0,0,12\"FFFFFFFFFFFFFFFFFFFFFFFF\"");
+	ret = cmd_value(buf, sizeof(buf), "+CRSM: 144,0,",
+			"AT+CRSM=214,28539,0,0,12\"FFFFFFFFFFFFFFFFFFFFFFFF\"");
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	if (gather_prefix_values("+CRSM: 144,0,", buf, sizeof(buf), 1) < 0) {
-		return -EILSEQ;
-	}
-
 	if (strcmp(buf, "\"\"")) {
 		return -EILSEQ;
 	}
@@ -802,26 +834,26 @@ int hio_lte_talk_at_cmd_with_resp(const char *s, char *buf, size_t size)
 {
 	int ret;
 
-	ret = cmd("%s", s);
+	ret = cmd_value(buf, size, "", "%s", s);
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values("", buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_at_cmd_with_resp_prefix(const char *s, char *buf, size_t size, const char *pfx)
 {
 	int ret;
 
-	ret = cmd("%s", s);
+	ret = cmd_value(buf, size, pfx, "%s", s);
 	if (ret < 0) {
-		LOG_ERR("Call `cmd` failed: %d", ret);
+		LOG_ERR("Call `cmd_value` failed: %d", ret);
 		return ret;
 	}
 
-	return gather_prefix_values(pfx, buf, size, 1) == 1 ? 0 : -EILSEQ;
+	return 0;
 }
 
 int hio_lte_talk_ncellmeas(int p1, int p2)
@@ -855,6 +887,11 @@ int hio_lte_talk_at_cmng(int opcode, int sec_tag, int type, const char *content)
 	return 0;
 }
 
+void hio_lte_talk_set_quiet(bool quiet)
+{
+	m_quiet_thread = quiet ? k_current_get() : NULL;
+}
+
 int hio_lte_talk_bypass_set_cb(hio_lte_talk_bypass_cb cb, void *user_data)
 {
 	m_bypass_cb = cb;
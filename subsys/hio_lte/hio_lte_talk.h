@@ -1,9 +1,6 @@
 #ifndef SUBSYS_HIO_LTE_MODEM_TALK_H_
 #define SUBSYS_HIO_LTE_MODEM_TALK_H_
 
-/* NRF includes */
-#include <nrf_modem_at.h>
-
 /* Standard includes */
 #include <stddef.h>
 #include <stdint.h>
@@ -15,6 +12,8 @@ extern "C" {
 
 typedef void (*hio_lte_talk_cb)(const char *line, void *user_data);
 
+/* Queries taking @p buf return the value there, -ENOSPC if it does not fit */
+
 int hio_lte_talk_init(hio_lte_talk_cb cb, void *user_data);
 int hio_lte_talk_at_cclk_q(char *buf, size_t size);
 int hio_lte_talk_at_ceppi(int p1);
@@ -22,6 +21,7 @@ int hio_lte_talk_at_cereg(int p1);
 int hio_lte_talk_at_cfun(int p1);
 int hio_lte_talk_at_cgauth(int p1, int *p2, const char *p3, const char *p4);
 int hio_lte_talk_at_cgdcont(int p1, const char *p2, const char *p3);
+/* Whole response in @p buf; iterate the lines with hio_lte_resp */
 int hio_lte_talk_at_cgdcont_q(char *buf, size_t size);
 int hio_lte_talk_at_cgerep(int p1);
 int hio_lte_talk_at_cgsn(char *buf, size_t size);
@@ -29,6 +29,7 @@ int hio_lte_talk_at_cimi(char *buf, size_t size);
 int hio_lte_talk_at_iccid(char *buf, size_t size);
 int hio_lte_talk_at_cmee(int p1);
 int hio_lte_talk_at_cnec(int p1);
+/* Whole response in @p buf; iterate the lines with hio_lte_resp */
 int hio_lte_talk_at_coneval(char *buf, size_t size);
 int hio_lte_talk_at_cops_q(char *buf, size_t size);
 int hio_lte_talk_at_cops(int p1, int *p2, const char *p3);
@@ -63,6 +64,10 @@ int hio_lte_talk_at_cmd_with_resp_prefix(const char *s, char *buf, size_t size,
 int hio_lte_talk_ncellmeas(int p1, int p2);
 int hio_lte_talk_at_cmng(int opcode, int sec_tag, int type, const char *content);
 
+/* Log commands and responses of the calling thread at debug level only (used
+ * by AT plans) */
+void hio_lte_talk_set_quiet(bool quiet);
+
 typedef void (*hio_lte_talk_bypass_cb)(void *user_data, const uint8_t *data, size_t len);
 int hio_lte_talk_bypass_set_cb(hio_lte_talk_bypass_cb cb, void *user_data);
 
@@ -0,0 +1,164 @@
+#include "hio_lte_trace.h"
+#include "hio_lte_flow.h"
+#include "hio_lte_str.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_trace, CONFIG_HIO_LTE_LOG_LEVEL);
+
+BUILD_ASSERT(HIO_LTE_FSM_EVENT_COUNT < HIO_LTE_TRACE_EVENT_NONE, "Event does not fit the trace");
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct hio_lte_trace_entry m_entries[CONFIG_HIO_LTE_TRACE_SIZE];
+static uint32_t m_total;
+
+static struct hio_lte_trace_dwell m_dwell[HIO_LTE_TRACE_STATES_MAX];
+static uint8_t m_state;
+static int64_t m_entered;
+
+static hio_lte_trace_state_str_cb m_state_str;
+
+static void record(uint8_t from, uint8_t to, uint8_t event, uint8_t flags, int result)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_entries[m_total % ARRAY_SIZE(m_entries)] = (struct hio_lte_trace_entry){
+		.timestamp = k_uptime_get_32(),
+		.from = from,
+		.to = to,
+		.event = event,
+		.flags = flags,
+		.result = result,
+	};
+
+	m_total++;
+
+	k_mutex_unlock(&m_lock);
+}
+
+int hio_lte_trace_init(uint8_t state, hio_lte_trace_state_str_cb state_str)
+{
+	if (state >= HIO_LTE_TRACE_STATES_MAX) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	memset(m_entries, 0, sizeof(m_entries));
+	memset(m_dwell, 0, sizeof(m_dwell));
+	m_total = 0;
+	m_state = state;
+	m_entered = k_uptime_get();
+	m_dwell[state].entries = 1;
+	m_state_str = state_str;
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+void hio_lte_trace_event(uint8_t from, uint8_t to, enum hio_lte_fsm_event event, int result)
+{
+	record(from, to, (uint8_t)event, 0, result);
+}
+
+void hio_lte_trace_enter(uint8_t from, uint8_t to)
+{
+	if (from >= HIO_LTE_TRACE_STATES_MAX || to >= HIO_LTE_TRACE_STATES_MAX) {
+		LOG_WRN("State out of range: %u -> %u", from, to);
+		return;
+	}
+
+	int64_t now = k_uptime_get();
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_dwell[from].total_ms += now - m_entered;
+	m_dwell[to].entries++;
+	m_state = to;
+	m_entered = now;
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_trace_transition(uint8_t from, uint8_t to, uint8_t event, int result)
+{
+	record(from, to, event, HIO_LTE_TRACE_FLAG_TRANSITION, result);
+}
+
+int hio_lte_trace_get(int index, struct hio_lte_trace_entry *entry)
+{
+	if (!entry || index < 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	uint32_t count = MIN(m_total, ARRAY_SIZE(m_entries));
+
+	if ((uint32_t)index >= count) {
+		k_mutex_unlock(&m_lock);
+		return -ENOENT;
+	}
+
+	*entry = m_entries[(m_total - count + index) % ARRAY_SIZE(m_entries)];
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+uint32_t hio_lte_trace_get_total(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	uint32_t total = m_total;
+	k_mutex_unlock(&m_lock);
+
+	return total;
+}
+
+int hio_lte_trace_get_dwell(uint8_t state, struct hio_lte_trace_dwell *dwell)
+{
+	if (!dwell || state >= HIO_LTE_TRACE_STATES_MAX) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	*dwell = m_dwell[state];
+
+	if (state == m_state) {
+		dwell->total_ms += k_uptime_get() - m_entered;
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+const char *hio_lte_trace_state_str(uint8_t state)
+{
+	const char *str = m_state_str ? m_state_str(state) : NULL;
+
+	return str ? str : "unknown";
+}
+
+const char *hio_lte_trace_event_str(uint8_t event)
+{
+	if (event == HIO_LTE_TRACE_EVENT_NONE) {
+		return "-";
+	}
+
+	return hio_lte_str_fsm_event((enum hio_lte_fsm_event)event);
+}
@@ -0,0 +1,80 @@
+#ifndef SUBSYS_HIO_LTE_TRACE_H_
+#define SUBSYS_HIO_LTE_TRACE_H_
+
+#include "hio_lte_flow.h"
+
+/* Zephyr includes */
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Upper bound of the FSM state values the dwell time is kept for */
+#define HIO_LTE_TRACE_STATES_MAX 16
+
+/* Transition not caused by an FSM event (API call, reconnect) */
+#define HIO_LTE_TRACE_EVENT_NONE UINT8_MAX
+
+/* The record is a state change; otherwise an event handled in state @p from */
+#define HIO_LTE_TRACE_FLAG_TRANSITION BIT(0)
+
+/**
+ * @brief One record of the FSM trace.
+ *
+ * For a transition @p result is the return value of the on_enter handler of
+ * @p to, for an event the return value of the event handler of @p from and
+ * @p to is the state the FSM ended up in.
+ */
+struct hio_lte_trace_entry {
+	/* Uptime in milliseconds */
+	uint32_t timestamp;
+	uint8_t from;
+	uint8_t to;
+	/* enum hio_lte_fsm_event or HIO_LTE_TRACE_EVENT_NONE */
+	uint8_t event;
+	uint8_t flags;
+	int32_t result;
+};
+
+struct hio_lte_trace_dwell {
+	/* Includes the time spent so far in the current state */
+	uint64_t total_ms;
+	uint32_t entries;
+};
+
+typedef const char *(*hio_lte_trace_state_str_cb)(uint8_t state);
+
+/* Start accounting with the FSM in @p state; @p state_str names states for the
+ * shell and ATCI output */
+int hio_lte_trace_init(uint8_t state, hio_lte_trace_state_str_cb state_str);
+
+/* Record an event handled in @p from with the FSM left in @p to */
+void hio_lte_trace_event(uint8_t from, uint8_t to, enum hio_lte_fsm_event event, int result);
+
+/* Close the dwell time of @p from; call when the FSM switches state */
+void hio_lte_trace_enter(uint8_t from, uint8_t to);
+
+/* Record a finished transition; @p event is HIO_LTE_TRACE_EVENT_NONE if none */
+void hio_lte_trace_transition(uint8_t from, uint8_t to, uint8_t event, int result);
+
+/* Records oldest first; -ENOENT past the last one */
+int hio_lte_trace_get(int index, struct hio_lte_trace_entry *entry);
+
+/* Number of records made since init, including the overwritten ones */
+uint32_t hio_lte_trace_get_total(void);
+
+int hio_lte_trace_get_dwell(uint8_t state, struct hio_lte_trace_dwell *dwell);
+
+const char *hio_lte_trace_state_str(uint8_t state);
+const char *hio_lte_trace_event_str(uint8_t event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_TRACE_H_ */
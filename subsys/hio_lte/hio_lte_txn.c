@@ -0,0 +1,172 @@
+#include "hio_lte_txn.h"
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+struct record {
+	struct hio_lte_metrics_txn txn;
+	uint32_t id;
+	/* Uptime when the transaction ended (ms) */
+	uint32_t end;
+};
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct record m_records[CONFIG_HIO_LTE_METRICS_TXN_SIZE];
+static uint32_t m_total;
+static uint32_t m_last_id;
+/* Evaluation that finished before its transaction was recorded */
+static uint32_t m_early_id;
+static int16_t m_early_rsrp;
+
+static inline struct record *get_record(uint32_t seq)
+{
+	return &m_records[seq % ARRAY_SIZE(m_records)];
+}
+
+void hio_lte_txn_clear(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	memset(m_records, 0, sizeof(m_records));
+	m_total = 0;
+	m_early_id = HIO_LTE_TXN_ID_NONE;
+
+	k_mutex_unlock(&m_lock);
+}
+
+uint32_t hio_lte_txn_begin(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (++m_last_id == HIO_LTE_TXN_ID_NONE) {
+		m_last_id++;
+	}
+
+	uint32_t id = m_last_id;
+
+	k_mutex_unlock(&m_lock);
+
+	return id;
+}
+
+void hio_lte_txn_record(uint32_t id, const struct hio_lte_metrics_txn *txn)
+{
+	if (!txn) {
+		return;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	struct record *record = get_record(m_total);
+
+	record->txn = *txn;
+	record->txn.connected_ms = 0;
+	record->txn.rsrp = INT16_MIN;
+	record->id = id;
+	record->end = k_uptime_get_32();
+
+	if (id != HIO_LTE_TXN_ID_NONE && id == m_early_id) {
+		record->txn.rsrp = m_early_rsrp;
+		m_early_id = HIO_LTE_TXN_ID_NONE;
+	}
+
+	m_total++;
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_txn_set_connected(uint32_t start, uint32_t duration_ms)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	uint32_t count = MIN(m_total, ARRAY_SIZE(m_records));
+
+	/* Newest first; the records before the connection are done */
+	for (uint32_t i = 0; i < count; i++) {
+		struct record *record = get_record(m_total - 1 - i);
+
+		if ((int32_t)(record->end - start) < 0) {
+			break;
+		}
+
+		if (!record->txn.connected_ms) {
+			record->txn.connected_ms = MAX(duration_ms, 1);
+		}
+	}
+
+	k_mutex_unlock(&m_lock);
+}
+
+void hio_lte_txn_set_rsrp(uint32_t id, int rsrp)
+{
+	if (id == HIO_LTE_TXN_ID_NONE) {
+		return;
+	}
+
+	int16_t value = CLAMP(rsrp, INT16_MIN + 1, INT16_MAX);
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	uint32_t count = MIN(m_total, ARRAY_SIZE(m_records));
+	bool found = false;
+
+	for (uint32_t i = 0; i < count; i++) {
+		struct record *record = get_record(m_total - 1 - i);
+
+		if (record->id == id) {
+			if (record->txn.rsrp == INT16_MIN) {
+				record->txn.rsrp = value;
+			}
+			found = true;
+			break;
+		}
+	}
+
+	/* The caller of the transaction has not recorded it yet */
+	if (!found && m_early_id != id) {
+		m_early_id = id;
+		m_early_rsrp = value;
+	}
+
+	k_mutex_unlock(&m_lock);
+}
+
+int hio_lte_txn_get(int index, struct hio_lte_metrics_txn *txn)
+{
+	if (!txn || index < 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	uint32_t count = MIN(m_total, ARRAY_SIZE(m_records));
+
+	if ((uint32_t)index >= count) {
+		k_mutex_unlock(&m_lock);
+		return -ENOENT;
+	}
+
+	*txn = get_record(m_total - count + index)->txn;
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+uint32_t hio_lte_txn_get_total(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	uint32_t total = m_total;
+	k_mutex_unlock(&m_lock);
+
+	return total;
+}
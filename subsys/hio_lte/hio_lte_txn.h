@@ -0,0 +1,50 @@
+#ifndef SUBSYS_HIO_LTE_TXN_H_
+#define SUBSYS_HIO_LTE_TXN_H_
+
+/* HIO includes */
+#include <hio/hio_lte.h>
+
+/* Standard includes */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Ring of the last CONFIG_HIO_LTE_METRICS_TXN_SIZE transactions. A record is
+ * made when the transaction ends; the RRC connection it was part of and the
+ * connection evaluation that follows it are only known later and are filled
+ * in then.
+ */
+
+#define HIO_LTE_TXN_ID_NONE 0
+
+void hio_lte_txn_clear(void);
+
+/* Id of a transaction that starts now, never HIO_LTE_TXN_ID_NONE */
+uint32_t hio_lte_txn_begin(void);
+
+/* Record the finished transaction @p id; connected_ms and rsrp are filled in
+ * later */
+void hio_lte_txn_record(uint32_t id, const struct hio_lte_metrics_txn *txn);
+
+/* An RRC connection that started at @p start (uptime in ms) was released after
+ * @p duration_ms; completes the records of the transactions that ended in it */
+void hio_lte_txn_set_connected(uint32_t start, uint32_t duration_ms);
+
+/* The connection evaluation following transaction @p id finished; only the
+ * first one counts. May come before the transaction is recorded. */
+void hio_lte_txn_set_rsrp(uint32_t id, int rsrp);
+
+/* Records oldest first; -ENOENT past the last one */
+int hio_lte_txn_get(int index, struct hio_lte_metrics_txn *txn);
+
+/* Number of records made since the last clear, including the overwritten ones */
+uint32_t hio_lte_txn_get_total(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_TXN_H_ */
@@ -0,0 +1,126 @@
+#include "hio_lte_urc.h"
+
+/* HIO includes */
+#include <hio/hio_lte.h>
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/iterable_sections.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_urc, CONFIG_HIO_LTE_LOG_LEVEL);
+
+/* Must be a power of two */
+#define BUCKET_COUNT 32
+
+#define INDEX_NONE UINT8_MAX
+
+BUILD_ASSERT(CONFIG_HIO_LTE_URC_HANDLERS_MAX < INDEX_NONE);
+
+/* Chained hash index over the handler section: m_bucket holds the first
+ * handler of each bucket, m_next links handlers within a bucket. Handlers
+ * beyond CONFIG_HIO_LTE_URC_HANDLERS_MAX are not indexed and scanned. */
+static uint8_t m_bucket[BUCKET_COUNT] = {[0 ... BUCKET_COUNT - 1] = INDEX_NONE};
+static uint8_t m_next[CONFIG_HIO_LTE_URC_HANDLERS_MAX];
+static size_t m_count;
+static size_t m_indexed;
+
+static uint32_t hash(const char *s, size_t len)
+{
+	/* FNV-1a */
+	uint32_t h = 2166136261u;
+
+	for (size_t i = 0; i < len; i++) {
+		h ^= (uint8_t)s[i];
+		h *= 16777619u;
+	}
+
+	return h & (BUCKET_COUNT - 1);
+}
+
+static bool prefix_equal(const struct hio_lte_urc_handler *handler, const char *name, size_t len)
+{
+	return !strncmp(handler->prefix, name, len) && handler->prefix[len] == '\0';
+}
+
+int hio_lte_urc_init(void)
+{
+	memset(m_bucket, INDEX_NONE, sizeof(m_bucket));
+	memset(m_next, INDEX_NONE, sizeof(m_next));
+
+	STRUCT_SECTION_COUNT(hio_lte_urc_handler, &m_count);
+
+	m_indexed = MIN(m_count, CONFIG_HIO_LTE_URC_HANDLERS_MAX);
+
+	if (m_count > m_indexed) {
+		LOG_WRN("Only %zu of %zu URC handlers indexed (HIO_LTE_URC_HANDLERS_MAX)",
+			m_indexed, m_count);
+	}
+
+	/* Insert backwards so each chain keeps the section order */
+	for (size_t i = m_indexed; i-- > 0;) {
+		const struct hio_lte_urc_handler *handler;
+
+		STRUCT_SECTION_GET(hio_lte_urc_handler, i, &handler);
+
+		if (!handler->prefix || !handler->handler) {
+			LOG_ERR("Invalid URC handler at index %zu", i);
+			return -EINVAL;
+		}
+
+		uint32_t b = hash(handler->prefix, strlen(handler->prefix));
+
+		m_next[i] = m_bucket[b];
+		m_bucket[b] = i;
+	}
+
+	return 0;
+}
+
+int hio_lte_urc_dispatch(const char *line)
+{
+	if (!line) {
+		return -EINVAL;
+	}
+
+	/* "+CEREG: 5,..." -> name "+CEREG", params "5,..."; "Ready" -> name
+	 * "Ready", params "" */
+	size_t len = strcspn(line, ":");
+	const char *params = &line[len];
+
+	if (*params == ':') {
+		params++;
+		if (*params == ' ') {
+			params++;
+		}
+	}
+
+	int called = 0;
+	const struct hio_lte_urc_handler *handler;
+
+	for (uint8_t i = m_bucket[hash(line, len)]; i != INDEX_NONE; i = m_next[i]) {
+		STRUCT_SECTION_GET(hio_lte_urc_handler, i, &handler);
+
+		if (prefix_equal(handler, line, len)) {
+			handler->handler(params, handler->user_data);
+			called++;
+		}
+	}
+
+	for (size_t i = m_indexed; i < m_count; i++) {
+		STRUCT_SECTION_GET(hio_lte_urc_handler, i, &handler);
+
+		if (prefix_equal(handler, line, len)) {
+			handler->handler(params, handler->user_data);
+			called++;
+		}
+	}
+
+	return called;
+}
@@ -0,0 +1,19 @@
+#ifndef SUBSYS_HIO_LTE_URC_H_
+#define SUBSYS_HIO_LTE_URC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Build the prefix index over the registered handlers */
+int hio_lte_urc_init(void);
+
+/* Call every handler registered for the URC in @p line (already stripped of
+ * CR/LF); returns the number of handlers called */
+int hio_lte_urc_dispatch(const char *line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUBSYS_HIO_LTE_URC_H_ */
@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2026 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: LicenseRef-HARDWARIO-5-Clause
+ */
+
+/* Throughput benchmark for the hio_cloud_msg pack/unpack hot paths. Only
+ * built by the hio_cloud_msg.bench scenario (HIO_CLOUD_MSG_BENCH=y).
+ *
+ * Every case prints ns/op (host wall clock) and bytes/op (wire size) and
+ * fails when ns/op exceeds its ceiling. The ceilings are deliberately loose
+ * (roughly 10x a typical x86-64 CI host) so that only real regressions of
+ * the CBOR paths trip them; tighten them per host via the CMake cache
+ * variables HIO_CLOUD_MSG_BENCH_MAX_NS_<CASE>. */
+
+#include "hio_cloud_msg.h"
+#include "hio_cloud_packet.h"
+#include "hio_cloud_util.h"
+#include "test_module.h"
+
+#include <hio/hio_buf.h>
+#include <hio/hio_cloud.h>
+#include <hio/hio_config.h>
+#include <hio/hio_lte.h>
+
+#include <zephyr/ztest.h>
+
+#include <zcbor_common.h>
+#include <zcbor_encode.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef HIO_CLOUD_MSG_BENCH_ITERATIONS
+#define HIO_CLOUD_MSG_BENCH_ITERATIONS 1000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_CONFIG
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_CONFIG 2000000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_UNPACK_DLSHELL
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_UNPACK_DLSHELL 200000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_UPSHELL
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_UPSHELL 500000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_FIRMWARE
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_FIRMWARE 50000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_UNPACK_DLFIRMWARE
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_UNPACK_DLFIRMWARE 100000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_PACKET_SIGNED_PACK
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_PACKET_SIGNED_PACK 100000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_PACKET_SIGNED_UNPACK
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_PACKET_SIGNED_UNPACK 100000
+#endif
+
+#ifndef HIO_CLOUD_MSG_BENCH_MAX_NS_HASH_UPDATE
+#define HIO_CLOUD_MSG_BENCH_MAX_NS_HASH_UPDATE 500000
+#endif
+
+#define BENCH_CONFIG_ITEMS   50
+#define BENCH_SHELL_COMMANDS 20
+
+/* Same chunk size hio_cloud_process_dlfirmware() requests from the cloud. */
+#define BENCH_FIRMWARE_CHUNK (((HIO_CLOUD_TRANSFER_BUF_SIZE - 50) / 256) * 256)
+
+typedef int (*bench_fn_t)(size_t *bytes);
+
+/* native_posix simulated time does not advance while code runs, so measure
+ * with the host monotonic clock instead of k_cycle_get_64(). */
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void bench_run(const char *name, bench_fn_t fn, uint64_t max_ns)
+{
+	size_t bytes = 0;
+
+	/* Warm-up pass also validates the case before timing it. */
+	zassert_ok(fn(&bytes), "%s: warm-up failed", name);
+
+	uint64_t start = now_ns();
+
+	for (int i = 0; i < HIO_CLOUD_MSG_BENCH_ITERATIONS; i++) {
+		if (fn(&bytes)) {
+			zassert_unreachable("%s: iteration %d failed", name, i);
+		}
+	}
+
+	uint64_t ns = (now_ns() - start) / HIO_CLOUD_MSG_BENCH_ITERATIONS;
+
+	TC_PRINT("bench %-18s %10llu ns/op %8zu B/op (limit %llu ns/op)\n", name,
+		 (unsigned long long)ns, bytes, (unsigned long long)max_ns);
+
+	zassert_true(ns <= max_ns, "%s regressed: %llu ns/op > %llu ns/op", name,
+		     (unsigned long long)ns, (unsigned long long)max_ns);
+}
+
+static int m_bench_values[BENCH_CONFIG_ITEMS];
+static char m_bench_names[BENCH_CONFIG_ITEMS][8];
+static struct hio_config_item m_bench_items[BENCH_CONFIG_ITEMS];
+static struct hio_config m_bench_module = {
+	.name = "bench",
+	.items = m_bench_items,
+	.nitems = ARRAY_SIZE(m_bench_items),
+	.interim = m_bench_values,
+	.final = m_bench_values,
+	.size = sizeof(m_bench_values),
+};
+
+HIO_BUF_DEFINE_STATIC(m_msg_buf, HIO_CLOUD_TRANSFER_BUF_SIZE);
+HIO_BUF_DEFINE_STATIC(m_dlshell_buf, 2048);
+HIO_BUF_DEFINE_STATIC(m_dlfirmware_buf, HIO_CLOUD_TRANSFER_BUF_SIZE + 128);
+
+HIO_BUF_DEFINE_STATIC(m_packet_buf, HIO_LTE_UDP_MAX_MTU);
+
+static uint8_t m_packet_data[HIO_LTE_UDP_MAX_MTU - HIO_CLOUD_PACKET_SIGNED_MIN_SIZE];
+static uint8_t m_packet_token[16] = {0xa5, 0x5a, 0xa5, 0x5a, 0xa5, 0x5a, 0xa5, 0x5a,
+				     0x5a, 0xa5, 0x5a, 0xa5, 0x5a, 0xa5, 0x5a, 0xa5};
+
+static char m_shell_commands[BENCH_SHELL_COMMANDS][32];
+static const hio_cloud_uuid_t m_uuid = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+					0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+/* Typical dummy-shell capture: leading CRLF, several CRLF-terminated lines. */
+static const char m_shell_output[] = "\r\n"
+				     "state: ready\r\n"
+				     "imei: 351358815178345\r\n"
+				     "imsi: 901288003957939\r\n"
+				     "rsrp: -92\r\n"
+				     "rsrq: -11\r\n"
+				     "snr: 7\r\n"
+				     "command succeeded\r\n";
+
+static void build_dlshell(void)
+{
+	struct hio_buf *buf = &m_dlshell_buf;
+
+	hio_buf_reset(buf);
+	zassert_ok(hio_buf_append_u8(buf, DL_DOWNLOAD_SHELL));
+
+	uint8_t *p = hio_buf_get_mem(buf) + 1;
+
+	ZCBOR_STATE_E(zs, 0, p, hio_buf_get_free(buf), 1);
+	zassert_true(zcbor_map_start_encode(zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH));
+	zassert_true(zcbor_uint32_put(zs, 0x01)); /* DL_SHELL_KEY_MESSAGE_ID */
+	zassert_true(zcbor_bstr_encode_ptr(zs, m_uuid, sizeof(m_uuid)));
+	zassert_true(zcbor_uint32_put(zs, 0x00)); /* DL_SHELL_KEY_COMMANDS */
+	zassert_true(zcbor_list_start_encode(zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH));
+	for (int i = 0; i < BENCH_SHELL_COMMANDS; i++) {
+		snprintf(m_shell_commands[i], sizeof(m_shell_commands[i]), "lte state %02d", i);
+		zassert_true(zcbor_tstr_put_term(zs, m_shell_commands[i],
+						 sizeof(m_shell_commands[i])));
+	}
+	zassert_true(zcbor_list_end_encode(zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH));
+	zassert_true(zcbor_map_end_encode(zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH));
+
+	zassert_ok(hio_buf_seek(buf, 1 + (zs->payload - p)));
+}
+
+static void build_dlfirmware(void)
+{
+	static uint8_t data[BENCH_FIRMWARE_CHUNK];
+	struct hio_buf *buf = &m_dlfirmware_buf;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)i;
+	}
+
+	hio_buf_reset(buf);
+	zassert_ok(hio_buf_append_u8(buf, DL_DOWNLOAD_FIRMWARE));
+
+	uint8_t *p = hio_buf_get_mem(buf) + 1;
+
+	ZCBOR_STATE_E(zs, 0, p, hio_buf_get_free(buf), 1);
+	zassert_true(zcbor_map_start_encode(zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH));
+	zassert_true(zcbor_uint32_put(zs, 0x00)); /* DL_FIRMWARE_KEY_TARGET */
+	zassert_true(zcbor_tstr_put_lit(zs, "app"));
+	zassert_true(zcbor_uint32_put(zs, 0x01)); /* DL_FIRMWARE_KEY_TYPE */
+	zassert_true(zcbor_tstr_put_lit(zs, "chunk"));
+	zassert_true(zcbor_uint32_put(zs, 0x02)); /* DL_FIRMWARE_KEY_ID */
+	zassert_true(zcbor_bstr_encode_ptr(zs, m_uuid, sizeof(m_uuid)));
+	zassert_true(zcbor_uint32_put(zs, 0x03)); /* DL_FIRMWARE_KEY_OFFSET */
+	zassert_true(zcbor_uint32_put(zs, BENCH_FIRMWARE_CHUNK));
+	zassert_true(zcbor_uint32_put(zs, 0x04)); /* DL_FIRMWARE_KEY_LENGTH */
+	zassert_true(zcbor_uint32_put(zs, sizeof(data)));
+	zassert_true(zcbor_uint32_put(zs, 0x05)); /* DL_FIRMWARE_KEY_DATA */
+	zassert_true(zcbor_bstr_encode_ptr(zs, data, sizeof(data)));
+	zassert_true(zcbor_uint32_put(zs, 0x06)); /* DL_FIRMWARE_KEY_FIRMWARE_SIZE */
+	zassert_true(zcbor_uint32_put(zs, 512 * 1024));
+	zassert_true(zcbor_map_end_encode(zs, ZCBOR_VALUE_IS_INDEFINITE_LENGTH));
+
+	zassert_ok(hio_buf_seek(buf, 1 + (zs->payload - p)));
+}
+
+static void *suite_setup(void)
+{
+	zassert_ok(test_module_register(), "test module registration failed");
+
+	for (int i = 0; i < BENCH_CONFIG_ITEMS; i++) {
+		snprintf(m_bench_names[i], sizeof(m_bench_names[i]), "i%02d", i);
+
+		m_bench_items[i] = (struct hio_config_item)HIO_CONFIG_ITEM_INT(
+			m_bench_names[i], m_bench_values[i], 0, 1000000, "bench", i * 1000);
+	}
+
+	zassert_ok(hio_config_register(&m_bench_module));
+
+	build_dlshell();
+	build_dlfirmware();
+
+	return NULL;
+}
+
+ZTEST_SUITE(hio_cloud_bench, NULL, suite_setup, NULL, NULL, NULL);
+
+static int bench_pack_config(size_t *bytes)
+{
+	hio_buf_reset(&m_msg_buf);
+
+	int ret = hio_cloud_msg_pack_config(&m_msg_buf);
+	if (ret) {
+		return ret;
+	}
+
+	*bytes = hio_buf_get_used(&m_msg_buf);
+
+	return 0;
+}
+
+ZTEST(hio_cloud_bench, test_pack_config)
+{
+	bench_run("pack_config", bench_pack_config, HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_CONFIG);
+}
+
+static int bench_unpack_dlshell(size_t *bytes)
+{
+	int ret;
+	struct hio_cloud_msg_dlshell dlshell;
+
+	HIO_BUF_DEFINE(command, CONFIG_SHELL_CMD_BUFF_SIZE);
+
+	ret = hio_cloud_msg_unpack_dlshell(&m_dlshell_buf, &dlshell);
+	if (ret) {
+		return ret;
+	}
+
+	if (dlshell.commands != BENCH_SHELL_COMMANDS) {
+		return -EBADMSG;
+	}
+
+	for (int i = 0; i < dlshell.commands; i++) {
+		hio_buf_reset(&command);
+
+		ret = hio_cloud_msg_dlshell_get_next_command(&dlshell, &command);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	*bytes = hio_buf_get_used(&m_dlshell_buf);
+
+	return 0;
+}
+
+ZTEST(hio_cloud_bench, test_unpack_dlshell)
+{
+	bench_run("unpack_dlshell", bench_unpack_dlshell,
+		  HIO_CLOUD_MSG_BENCH_MAX_NS_UNPACK_DLSHELL);
+}
+
+static int bench_pack_upshell(size_t *bytes)
+{
+	int ret;
+	struct hio_cloud_msg_upshell upshell;
+
+	hio_buf_reset(&m_msg_buf);
+
+	ret = hio_cloud_msg_pack_upshell_start(&upshell, &m_msg_buf, m_uuid);
+	if (ret) {
+		return ret;
+	}
+
+	for (int i = 0; i < BENCH_SHELL_COMMANDS; i++) {
+		ret = hio_cloud_msg_pack_upshell_add_response(&upshell, m_shell_commands[i], 0,
+							      m_shell_output);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	ret = hio_cloud_msg_pack_upshell_end(&upshell);
+	if (ret) {
+		return ret;
+	}
+
+	*bytes = hio_buf_get_used(&m_msg_buf);
+
+	return 0;
+}
+
+ZTEST(hio_cloud_bench, test_pack_upshell)
+{
+	bench_run("pack_upshell", bench_pack_upshell, HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_UPSHELL);
+}
+
+static int bench_pack_firmware(size_t *bytes)
+{
+	hio_cloud_uuid_t id;
+
+	memcpy(id, m_uuid, sizeof(id));
+
+	struct hio_cloud_upfirmware upfirmware = {
+		.target = "app",
+		.type = "next",
+		.id = id,
+		.offset = BENCH_FIRMWARE_CHUNK,
+		.max_length = BENCH_FIRMWARE_CHUNK,
+	};
+
+	hio_buf_reset(&m_msg_buf);
+
+	int ret = hio_cloud_msg_pack_firmware(&m_msg_buf, &upfirmware);
+	if (ret) {
+		return ret;
+	}
+
+	*bytes = hio_buf_get_used(&m_msg_buf);
+
+	return 0;
+}
+
+ZTEST(hio_cloud_bench, test_pack_firmware)
+{
+	bench_run("pack_firmware", bench_pack_firmware, HIO_CLOUD_MSG_BENCH_MAX_NS_PACK_FIRMWARE);
+}
+
+static int bench_unpack_dlfirmware(size_t *bytes)
+{
+	struct hio_cloud_msg_dlfirmware dlfirmware;
+
+	int ret = hio_cloud_msg_unpack_dlfirmware(&m_dlfirmware_buf, &dlfirmware);
+	if (ret) {
+		return ret;
+	}
+
+	if (dlfirmware.length != BENCH_FIRMWARE_CHUNK) {
+		return -EBADMSG;
+	}
+
+	*bytes = hio_buf_get_used(&m_dlfirmware_buf);
+
+	return 0;
+}
+
+ZTEST(hio_cloud_bench, test_unpack_dlfirmware)
+{
+	bench_run("unpack_dlfirmware", bench_unpack_dlfirmware,
+		  HIO_CLOUD_MSG_BENCH_MAX_NS_UNPACK_DLFIRMWARE);
+}
+
+static int bench_packet_signed_pack(size_t *bytes)
+{
+	struct hio_cloud_packet pck = {
+		.sequence = 0x0abc,
+		.flags = HIO_CLOUD_PACKET_FLAG_FIRST,
+		.data = m_packet_data,
+		.data_len = sizeof(m_packet_data),
+	};
+
+	int ret = hio_cloud_packet_signed_pack(&pck, 0x12345678, m_packet_token, &m_packet_buf);
+	if (ret) {
+		return ret;
+	}
+
+	*bytes = hio_buf_get_used(&m_packet_buf);
+
+	return 0;
+}
+
+/* Max-MTU signed FLAP packet; rerun per backend via hio_cloud_msg.bench.*. */
+ZTEST(hio_cloud_bench, test_packet_signed_pack)
+{
+	bench_run("packet_signed_pack", bench_packet_signed_pack,
+		  HIO_CLOUD_MSG_BENCH_MAX_NS_PACKET_SIGNED_PACK);
+}
+
+static int bench_packet_signed_unpack(size_t *bytes)
+{
+	struct hio_cloud_packet pck;
+
+	int ret = hio_cloud_packet_signed_unpack(&pck, NULL, m_packet_token, &m_packet_buf);
+	if (ret) {
+		return ret;
+	}
+
+	*bytes = hio_buf_get_used(&m_packet_buf);
+
+	return 0;
+}
+
+ZTEST(hio_cloud_bench, test_packet_signed_unpack)
+{
+	size_t bytes;
+
+	/* Sign a fresh packet so the case does not depend on test order. */
+	zassert_ok(bench_packet_signed_pack(&bytes));
+
+	bench_run("packet_signed_unpack", bench_packet_signed_unpack,
+		  HIO_CLOUD_MSG_BENCH_MAX_NS_PACKET_SIGNED_UNPACK);
+}
+
+/* Same input size and chunk sizes as the on-target `cloud hash bench`. */
+#define BENCH_HASH_SIZE 4096
+
+static size_t m_hash_chunk_size;
+
+static int bench_hash_update(size_t *bytes)
+{
+	static uint8_t data[BENCH_HASH_SIZE];
+
+	int ret;
+	struct hio_cloud_hash hash;
+	uint8_t digest[8];
+
+	ret = hio_cloud_hash_begin(&hash);
+	if (ret) {
+		return ret;
+	}
+
+	for (size_t offset = 0; offset < sizeof(data); offset += m_hash_chunk_size) {
+		ret = hio_cloud_hash_update(&hash, &data[offset], m_hash_chunk_size);
+		if (ret) {
+			return ret;
+		}
+	}
+
+	ret = hio_cloud_hash_finish(&hash, digest);
+	if (ret) {
+		return ret;
+	}
+
+	*bytes = sizeof(data);
+
+	return 0;
+}
+
+ZTEST(hio_cloud_bench, test_hash_update)
+{
+	static const size_t chunk_sizes[] = {16, 64, 256, 1024};
+
+	TC_PRINT("bench hash backend %s, context size %zu B\n", hio_cloud_hash_backend_name(),
+		 sizeof(struct hio_cloud_hash));
+
+	for (size_t i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		char name[24];
+
+		m_hash_chunk_size = chunk_sizes[i];
+		snprintf(name, sizeof(name), "hash_update_%zu", chunk_sizes[i]);
+
+		bench_run(name, bench_hash_update, HIO_CLOUD_MSG_BENCH_MAX_NS_HASH_UPDATE);
+	}
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: LicenseRef-HARDWARIO-5-Clause
+ */
+
+#include "hio_cloud_packet.h"
+#include "hio_cloud_util.h"
+
+#include <hio/hio_buf.h>
+#include <hio/hio_lte.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/ztest.h>
+
+#include <string.h>
+
+static uint8_t m_token[16] = {0x10, 0x32, 0x54, 0x76, 0x98, 0xba, 0xdc, 0xfe,
+			      0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+
+ZTEST_SUITE(hio_cloud_packet, NULL, NULL, NULL, NULL, NULL);
+
+/* The streamed signature must equal the legacy two-pass one: XOR-folded
+ * SHA-256 over token + everything after the hash field. */
+ZTEST(hio_cloud_packet, test_signed_pack_matches_oneshot_hash)
+{
+	static uint8_t data[HIO_LTE_UDP_MAX_MTU - HIO_CLOUD_PACKET_SIGNED_MIN_SIZE];
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 7);
+	}
+
+	struct hio_cloud_packet pck = {
+		.sequence = 0x123,
+		.flags = HIO_CLOUD_PACKET_FLAG_FIRST | HIO_CLOUD_PACKET_FLAG_POLL,
+		.data = data,
+		.data_len = sizeof(data),
+	};
+
+	HIO_BUF_DEFINE(buf, HIO_LTE_UDP_MAX_MTU);
+	zassert_ok(hio_cloud_packet_signed_pack(&pck, 0xdeadbeef, m_token, &buf));
+
+	uint8_t *p = hio_buf_get_mem(&buf);
+
+	zassert_equal(hio_buf_get_used(&buf), HIO_LTE_UDP_MAX_MTU);
+	zassert_equal(sys_get_be32(p + 8), 0xdeadbeef);
+	zassert_equal(sys_get_be16(p + 12), 0x9123);
+	zassert_mem_equal(p + HIO_CLOUD_PACKET_SIGNED_MIN_SIZE, data, sizeof(data));
+
+	uint8_t expected[8];
+	zassert_ok(hio_cloud_calculate_hash(expected, m_token, sizeof(m_token), p + 8,
+					    hio_buf_get_used(&buf) - 8));
+	zassert_mem_equal(p, expected, sizeof(expected));
+}
+
+ZTEST(hio_cloud_packet, test_signed_roundtrip)
+{
+	static const char data[] = "hello";
+
+	struct hio_cloud_packet pck = {
+		.sequence = 42,
+		.flags = HIO_CLOUD_PACKET_FLAG_ACK,
+		.data = (uint8_t *)data,
+		.data_len = sizeof(data),
+	};
+
+	HIO_BUF_DEFINE(buf, 64);
+	zassert_ok(hio_cloud_packet_signed_pack(&pck, 1234, m_token, &buf));
+
+	struct hio_cloud_packet out;
+	uint32_t sn;
+
+	zassert_ok(hio_cloud_packet_signed_unpack(&out, &sn, m_token, &buf));
+	zassert_equal(sn, 1234);
+	zassert_equal(out.sequence, 42);
+	zassert_equal(out.flags, HIO_CLOUD_PACKET_FLAG_ACK);
+	zassert_equal(out.data_len, sizeof(data));
+	zassert_mem_equal(out.data, data, sizeof(data));
+}
+
+ZTEST(hio_cloud_packet, test_signed_empty_payload)
+{
+	struct hio_cloud_packet pck = {
+		.sequence = 1,
+		.flags = HIO_CLOUD_PACKET_FLAG_POLL,
+	};
+
+	HIO_BUF_DEFINE(buf, 64);
+	zassert_ok(hio_cloud_packet_signed_pack(&pck, 7, m_token, &buf));
+	zassert_equal(hio_buf_get_used(&buf), HIO_CLOUD_PACKET_SIGNED_MIN_SIZE);
+
+	struct hio_cloud_packet out;
+
+	zassert_ok(hio_cloud_packet_signed_unpack(&out, NULL, m_token, &buf));
+	zassert_equal(out.data_len, 0);
+}
+
+ZTEST(hio_cloud_packet, test_signed_unpack_rejects_tampering)
+{
+	static const char data[] = "payload";
+
+	struct hio_cloud_packet pck = {
+		.sequence = 5,
+		.data = (uint8_t *)data,
+		.data_len = sizeof(data),
+	};
+
+	HIO_BUF_DEFINE(buf, 64);
+	zassert_ok(hio_cloud_packet_signed_pack(&pck, 99, m_token, &buf));
+
+	struct hio_cloud_packet out = {0};
+
+	hio_buf_get_mem(&buf)[HIO_CLOUD_PACKET_SIGNED_MIN_SIZE] ^= 0x01;
+	zassert_equal(hio_cloud_packet_signed_unpack(&out, NULL, m_token, &buf), -EBADMSG);
+	zassert_is_null(out.data, "output must stay untouched on mismatch");
+
+	hio_buf_get_mem(&buf)[HIO_CLOUD_PACKET_SIGNED_MIN_SIZE] ^= 0x01;
+	zassert_ok(hio_cloud_packet_signed_unpack(&out, NULL, m_token, &buf));
+
+	uint8_t other_token[16] = {0};
+	zassert_equal(hio_cloud_packet_signed_unpack(&out, NULL, other_token, &buf), -EBADMSG);
+}
+
+ZTEST(hio_cloud_packet, test_signed_pack_overflow)
+{
+	static uint8_t data[64];
+
+	struct hio_cloud_packet pck = {
+		.data = data,
+		.data_len = sizeof(data),
+	};
+
+	HIO_BUF_DEFINE(buf, 32);
+	zassert_equal(hio_cloud_packet_signed_pack(&pck, 0, m_token, &buf), -ENOSPC);
+}
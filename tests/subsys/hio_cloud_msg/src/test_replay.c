@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: LicenseRef-HARDWARIO-5-Clause
+ */
+
+#include "hio_cloud_replay.h"
+
+#include <hio/hio_buf.h>
+
+#include <zephyr/ztest.h>
+
+#include <string.h>
+
+static void before_each(void *fixture)
+{
+	ARG_UNUSED(fixture);
+	hio_cloud_replay_clear();
+}
+
+ZTEST_SUITE(hio_cloud_replay, NULL, NULL, before_each, NULL, NULL);
+
+static void make_id(hio_cloud_uuid_t id, uint8_t seed)
+{
+	memset(id, 0, sizeof(hio_cloud_uuid_t));
+	id[15] = seed;
+}
+
+ZTEST(hio_cloud_replay, test_hit_and_miss)
+{
+	hio_cloud_uuid_t id;
+	static const uint8_t data[] = {UL_UPLOAD_SHELL, 0xbf, 0xff};
+
+	HIO_BUF_DEFINE(buf, 64);
+
+	make_id(id, 1);
+	zassert_equal(hio_cloud_replay_get(id, &buf), -ENOENT);
+	zassert_ok(hio_cloud_replay_put(id, data, sizeof(data)));
+	zassert_ok(hio_cloud_replay_get(id, &buf));
+	zassert_equal(hio_buf_get_used(&buf), sizeof(data));
+	zassert_mem_equal(hio_buf_get_mem(&buf), data, sizeof(data));
+
+	make_id(id, 2);
+	zassert_equal(hio_cloud_replay_get(id, &buf), -ENOENT);
+}
+
+ZTEST(hio_cloud_replay, test_no_id_not_cached)
+{
+	hio_cloud_uuid_t id = {0};
+	static const uint8_t data[] = {UL_UPLOAD_SHELL};
+
+	HIO_BUF_DEFINE(buf, 64);
+
+	zassert_equal(hio_cloud_replay_put(id, data, sizeof(data)), -EINVAL);
+	zassert_equal(hio_cloud_replay_get(id, &buf), -ENOENT);
+}
+
+ZTEST(hio_cloud_replay, test_too_large)
+{
+	hio_cloud_uuid_t id;
+	static uint8_t data[CONFIG_HIO_CLOUD_SHELL_REPLAY_MSG_SIZE + 1];
+
+	HIO_BUF_DEFINE(buf, 64);
+
+	make_id(id, 1);
+	zassert_equal(hio_cloud_replay_put(id, data, sizeof(data)), -EMSGSIZE);
+	zassert_equal(hio_cloud_replay_get(id, &buf), -ENOENT);
+}
+
+ZTEST(hio_cloud_replay, test_lru_eviction)
+{
+	hio_cloud_uuid_t id;
+	uint8_t data = 0;
+
+	HIO_BUF_DEFINE(buf, 64);
+
+	/* Fill the cache, then touch the oldest entry so the second is evicted */
+	for (int i = 1; i <= CONFIG_HIO_CLOUD_SHELL_REPLAY_CACHE_SIZE; i++) {
+		make_id(id, i);
+		data = i;
+		zassert_ok(hio_cloud_replay_put(id, &data, 1));
+	}
+
+	make_id(id, 1);
+	zassert_ok(hio_cloud_replay_get(id, &buf));
+
+	make_id(id, 100);
+	zassert_ok(hio_cloud_replay_put(id, &data, 1));
+
+	make_id(id, 1);
+	zassert_ok(hio_cloud_replay_get(id, &buf));
+	make_id(id, 2);
+	zassert_equal(hio_cloud_replay_get(id, &buf), -ENOENT);
+	make_id(id, 100);
+	zassert_ok(hio_cloud_replay_get(id, &buf));
+}
+
+ZTEST(hio_cloud_replay, test_put_same_id_overwrites)
+{
+	hio_cloud_uuid_t id;
+	uint8_t data;
+
+	HIO_BUF_DEFINE(buf, 64);
+
+	make_id(id, 7);
+	data = 1;
+	zassert_ok(hio_cloud_replay_put(id, &data, 1));
+	data = 2;
+	zassert_ok(hio_cloud_replay_put(id, &data, 1));
+
+	zassert_ok(hio_cloud_replay_get(id, &buf));
+	zassert_equal(hio_buf_get_used(&buf), 1);
+	zassert_equal(hio_buf_get_mem(&buf)[0], 2);
+}
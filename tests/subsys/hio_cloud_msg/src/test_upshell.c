@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 HARDWARIO a.s.
+ *
+ * SPDX-License-Identifier: LicenseRef-HARDWARIO-5-Clause
+ */
+
+#include "hio_cloud_msg.h"
+
+#include <hio/hio_buf.h>
+
+#include <zephyr/ztest.h>
+
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+
+#include <string.h>
+
+ZTEST_SUITE(hio_cloud_upshell, NULL, NULL, NULL, NULL, NULL);
+
+static const hio_cloud_uuid_t m_uuid = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+/* Decode [0x07]{1: uuid, 0: [{0: cmd, 2: [lines...], ?1: result}]} of a single
+ * response; returns the number of output lines and fills the last one. */
+static int decode_single_response(struct hio_buf *buf, const char *cmd, int32_t *result,
+				  struct zcbor_string *last)
+{
+	uint8_t *p = hio_buf_get_mem(buf);
+	uint32_t key;
+	struct zcbor_string tstr;
+
+	zassert_equal(p[0], UL_UPLOAD_SHELL);
+
+	ZCBOR_STATE_D(zs, 4, p + 1, hio_buf_get_used(buf) - 1, 1, 0);
+	zassert_true(zcbor_map_start_decode(zs));
+	zassert_true(zcbor_uint32_decode(zs, &key));
+	zassert_equal(key, 0x01);
+	zassert_true(zcbor_bstr_decode(zs, &tstr));
+	zassert_mem_equal(tstr.value, m_uuid, sizeof(m_uuid));
+	zassert_true(zcbor_uint32_decode(zs, &key));
+	zassert_equal(key, 0x00);
+	zassert_true(zcbor_list_start_decode(zs));
+	zassert_true(zcbor_map_start_decode(zs));
+
+	zassert_true(zcbor_uint32_decode(zs, &key));
+	zassert_equal(key, 0x00);
+	zassert_true(zcbor_tstr_decode(zs, &tstr));
+	zassert_equal(tstr.len, strlen(cmd));
+	zassert_mem_equal(tstr.value, cmd, tstr.len);
+
+	zassert_true(zcbor_uint32_decode(zs, &key));
+	zassert_equal(key, 0x02);
+	zassert_true(zcbor_list_start_decode(zs));
+
+	int lines = 0;
+
+	while (zcbor_tstr_decode(zs, &tstr)) {
+		*last = tstr;
+		lines++;
+	}
+	zassert_true(zcbor_list_end_decode(zs));
+
+	*result = 0;
+	if (zcbor_uint32_decode(zs, &key)) {
+		zassert_equal(key, 0x01);
+		zassert_true(zcbor_int32_decode(zs, result));
+	}
+
+	zassert_true(zcbor_map_end_decode(zs));
+	zassert_true(zcbor_list_end_decode(zs));
+	zassert_true(zcbor_map_end_decode(zs));
+
+	return lines;
+}
+
+ZTEST(hio_cloud_upshell, test_streamed_response)
+{
+	struct hio_cloud_msg_upshell upshell;
+
+	HIO_BUF_DEFINE(buf, 256);
+
+	zassert_ok(hio_cloud_msg_pack_upshell_start(&upshell, &buf, m_uuid));
+	zassert_ok(hio_cloud_msg_pack_upshell_response_start(&upshell, "lte state"));
+	zassert_ok(hio_cloud_msg_pack_upshell_response_line(&upshell, "state: ready", 12));
+	zassert_ok(hio_cloud_msg_pack_upshell_response_line(&upshell, "command succeeded", 17));
+	zassert_ok(hio_cloud_msg_pack_upshell_response_end(&upshell, -8));
+	zassert_ok(hio_cloud_msg_pack_upshell_end(&upshell));
+
+	int32_t result;
+	struct zcbor_string last;
+
+	zassert_equal(decode_single_response(&buf, "lte state", &result, &last), 2);
+	zassert_equal(result, -8);
+	zassert_equal(last.len, 17);
+	zassert_mem_equal(last.value, "command succeeded", 17);
+}
+
+ZTEST(hio_cloud_upshell, test_streamed_response_truncated)
+{
+	static char line[100];
+	struct hio_cloud_msg_upshell upshell;
+
+	memset(line, 'x', sizeof(line));
+
+	HIO_BUF_DEFINE(buf, 512);
+
+	zassert_ok(hio_cloud_msg_pack_upshell_start(&upshell, &buf, m_uuid));
+	zassert_ok(hio_cloud_msg_pack_upshell_response_start(&upshell, "big"));
+	for (int i = 0; i < 20; i++) {
+		zassert_ok(hio_cloud_msg_pack_upshell_response_line(&upshell, line, sizeof(line)));
+	}
+	zassert_ok(hio_cloud_msg_pack_upshell_response_end(&upshell, 0));
+	zassert_ok(hio_cloud_msg_pack_upshell_end(&upshell));
+
+	int32_t result;
+	struct zcbor_string last;
+	int lines = decode_single_response(&buf, "big", &result, &last);
+
+	/* Some lines fit, then exactly one marker line */
+	zassert_true(lines > 1 && lines < 20, "unexpected line count %d", lines);
+	zassert_equal(result, 0);
+	zassert_true(last.len > 4 && memcmp(last.value, "... ", 4) == 0, "missing marker");
+}
+
+ZTEST(hio_cloud_upshell, test_response_start_no_space)
+{
+	struct hio_cloud_msg_upshell upshell;
+
+	HIO_BUF_DEFINE(buf, 80);
+
+	zassert_ok(hio_cloud_msg_pack_upshell_start(&upshell, &buf, m_uuid));
+	zassert_equal(hio_cloud_msg_pack_upshell_response_start(&upshell, "lte state"), -ENOSPC);
+
+	/* The message can still be closed */
+	zassert_ok(hio_cloud_msg_pack_upshell_end(&upshell));
+}
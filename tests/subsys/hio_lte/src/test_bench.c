@@ -0,0 +1,354 @@
+/* Throughput benchmark for the hio_lte_parse URC parsers. Only built by the
+ * hio_lte.bench scenario (HIO_LTE_BENCH=y).
+ *
+ * Replays the captured URCs of corpus/urc.txt and prints ns/line per parser
+ * (host wall clock) and for the whole corpus with the prefix dispatch. A
+ * parser fails when its ns/line exceeds the ceiling; the ceilings are loose
+ * (roughly 10x a typical x86-64 CI host) and can be tightened per host via
+ * the CMake cache variables HIO_LTE_BENCH_MAX_NS_<PARSER>.
+ *
+ * Lines a parser rejects are reported and left out of the timing, so an
+ * error path with logging does not skew the numbers. */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio/hio_lte.h>
+#include <hio_lte_parse.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef HIO_LTE_BENCH_ITERATIONS
+#define HIO_LTE_BENCH_ITERATIONS 1000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_CEREG
+#define HIO_LTE_BENCH_MAX_NS_CEREG 10000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_NCELLMEAS
+#define HIO_LTE_BENCH_MAX_NS_NCELLMEAS 50000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_NCELLMEAS_MAX
+#define HIO_LTE_BENCH_MAX_NS_NCELLMEAS_MAX 100000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_CONEVAL
+#define HIO_LTE_BENCH_MAX_NS_CONEVAL 20000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_CGDCONT
+#define HIO_LTE_BENCH_MAX_NS_CGDCONT 10000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_XMODEMSLEEP
+#define HIO_LTE_BENCH_MAX_NS_XMODEMSLEEP 5000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_RAI
+#define HIO_LTE_BENCH_MAX_NS_RAI 10000
+#endif
+
+#ifndef HIO_LTE_BENCH_MAX_NS_REPLAY
+#define HIO_LTE_BENCH_MAX_NS_REPLAY 50000
+#endif
+
+#define CORPUS_LINES_MAX 1024
+
+/* Same search type the flow requests */
+#define NCELLMEAS_SEARCH_TYPE 5
+
+/* Neighbors the serving cell reports in the worst-case line, more than
+ * HIO_LTE_NCELLMEAS_NCELL_MAX */
+#define NCELLMEAS_MAX_NEIGHBORS 17
+
+static const char m_corpus[] = {
+#include "urc_corpus.inc"
+	0x00,
+};
+
+static struct hio_lte_cereg_param m_cereg;
+static struct hio_lte_ncellmeas_param m_ncellmeas;
+static struct hio_lte_conn_param m_coneval;
+static struct cgdcont_param m_cgdcont;
+static struct hio_lte_rai_param m_rai;
+
+static int parse_cereg(const char *params)
+{
+	return hio_lte_parse_urc_cereg(params, &m_cereg);
+}
+
+static int parse_ncellmeas(const char *params)
+{
+	return hio_lte_parse_urc_ncellmeas(params, NCELLMEAS_SEARCH_TYPE, &m_ncellmeas);
+}
+
+static int parse_coneval(const char *params)
+{
+	return hio_lte_parse_coneval(params, &m_coneval);
+}
+
+static int parse_cgdcont(const char *params)
+{
+	return hio_lte_parse_cgcont(params, &m_cgdcont);
+}
+
+static int parse_xmodemsleep(const char *params)
+{
+	int p1, p2;
+
+	return hio_lte_parse_urc_xmodemsleep(params, &p1, &p2);
+}
+
+static int parse_rai(const char *params)
+{
+	return hio_lte_parse_urc_rai(params, &m_rai);
+}
+
+struct parser {
+	const char *name;
+	const char *prefix;
+	int (*parse)(const char *params);
+	uint64_t max_ns;
+	/* Corpus lines handled by the parser, without the prefix */
+	const char *lines[CORPUS_LINES_MAX];
+	size_t count;
+	size_t rejected;
+};
+
+static struct parser m_parsers[] = {
+	{"cereg", "+CEREG: ", parse_cereg, HIO_LTE_BENCH_MAX_NS_CEREG},
+	{"ncellmeas", "%NCELLMEAS: ", parse_ncellmeas, HIO_LTE_BENCH_MAX_NS_NCELLMEAS},
+	{"coneval", "%CONEVAL: ", parse_coneval, HIO_LTE_BENCH_MAX_NS_CONEVAL},
+	{"cgdcont", "+CGDCONT: ", parse_cgdcont, HIO_LTE_BENCH_MAX_NS_CGDCONT},
+	{"xmodemsleep", "%XMODEMSLEEP: ", parse_xmodemsleep, HIO_LTE_BENCH_MAX_NS_XMODEMSLEEP},
+	{"rai", "%RAI: ", parse_rai, HIO_LTE_BENCH_MAX_NS_RAI},
+};
+
+static char m_buf[sizeof(m_corpus)];
+static char m_ncellmeas_max[2048];
+static const char *m_lines[CORPUS_LINES_MAX];
+static bool m_rejected[CORPUS_LINES_MAX];
+static size_t m_line_count;
+
+/* Simulated time does not advance while code runs, so measure with the host
+ * monotonic clock (the scenario builds against the host C library) */
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Longest GCI line the modem sends: HIO_LTE_NCELLMEAS_CELL_MAX cells with the
+ * widest value of every field and more neighbors than the table holds */
+static void build_ncellmeas_max(void)
+{
+	char *p = m_ncellmeas_max;
+	char *end = m_ncellmeas_max + sizeof(m_ncellmeas_max);
+
+	p += snprintf(p, end - p, "0");
+
+	for (int i = 0; i < HIO_LTE_NCELLMEAS_CELL_MAX; i++) {
+		int neighbors = i ? 0 : NCELLMEAS_MAX_NEIGHBORS;
+
+		p += snprintf(p, end - p,
+			      ",\"%08X\",\"999999\",\"FFFE\",20512,18446744073709551615,262143,503,"
+			      "-17,-17,18446744073709551615,%d,%d",
+			      HIO_LTE_CELL_ECI_MAX - i, !i, neighbors);
+
+		for (int j = 0; j < neighbors; j++) {
+			p += snprintf(p, end - p, ",262143,%d,-17,-17,-99999", 503 - j);
+		}
+	}
+
+	zassert_true(p < end, "worst-case line truncated");
+}
+
+static struct parser *find_parser(const char *line)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(m_parsers); i++) {
+		if (!strncmp(line, m_parsers[i].prefix, strlen(m_parsers[i].prefix))) {
+			return &m_parsers[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void *suite_setup(void)
+{
+	memcpy(m_buf, m_corpus, sizeof(m_buf));
+
+	for (char *p = m_buf; *p;) {
+		char *end = strchr(p, '\n');
+
+		if (end) {
+			*end = '\0';
+		}
+
+		if (*p) {
+			zassert_true(m_line_count < ARRAY_SIZE(m_lines), "corpus too large");
+			m_lines[m_line_count++] = p;
+		}
+
+		if (!end) {
+			break;
+		}
+
+		p = end + 1;
+	}
+
+	/* Warm-up pass: sort the lines by parser and keep the ones it takes */
+	for (size_t i = 0; i < m_line_count; i++) {
+		struct parser *parser = find_parser(m_lines[i]);
+
+		if (!parser) {
+			continue;
+		}
+
+		const char *params = m_lines[i] + strlen(parser->prefix);
+
+		if (parser->parse(params)) {
+			m_rejected[i] = true;
+			parser->rejected++;
+			continue;
+		}
+
+		parser->lines[parser->count++] = params;
+	}
+
+	build_ncellmeas_max();
+
+	TC_PRINT("corpus: %zu lines, worst-case %%NCELLMEAS: %zu bytes\n", m_line_count,
+		 strlen(m_ncellmeas_max));
+
+	return NULL;
+}
+
+static void bench_parser(const char *name)
+{
+	struct parser *parser = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_parsers); i++) {
+		if (!strcmp(m_parsers[i].name, name)) {
+			parser = &m_parsers[i];
+		}
+	}
+
+	zassert_not_null(parser);
+	zassert_true(parser->count > 0, "%s: no lines in the corpus", name);
+
+	uint64_t start = now_ns();
+
+	for (int i = 0; i < HIO_LTE_BENCH_ITERATIONS; i++) {
+		for (size_t j = 0; j < parser->count; j++) {
+			if (parser->parse(parser->lines[j])) {
+				zassert_unreachable("%s: line %zu failed", name, j);
+			}
+		}
+	}
+
+	uint64_t ns = (now_ns() - start) / ((uint64_t)HIO_LTE_BENCH_ITERATIONS * parser->count);
+
+	TC_PRINT("bench %-12s %8llu ns/line %4zu lines %3zu rejected (limit %llu ns/line)\n",
+		 name, (unsigned long long)ns, parser->count, parser->rejected,
+		 (unsigned long long)parser->max_ns);
+
+	zassert_true(ns <= parser->max_ns, "%s regressed: %llu ns/line > %llu ns/line", name,
+		     (unsigned long long)ns, (unsigned long long)parser->max_ns);
+}
+
+ZTEST(hio_lte_bench, test_cereg)
+{
+	bench_parser("cereg");
+}
+
+ZTEST(hio_lte_bench, test_ncellmeas)
+{
+	bench_parser("ncellmeas");
+}
+
+ZTEST(hio_lte_bench, test_ncellmeas_max)
+{
+	int ret = parse_ncellmeas(m_ncellmeas_max);
+
+	zassert_ok(ret, "worst-case line failed: %d", ret);
+	zassert_equal(m_ncellmeas.num_cells, HIO_LTE_NCELLMEAS_CELL_MAX);
+	zassert_equal(m_ncellmeas.num_ncells, HIO_LTE_NCELLMEAS_NCELL_MAX);
+
+	uint64_t start = now_ns();
+
+	for (int i = 0; i < HIO_LTE_BENCH_ITERATIONS; i++) {
+		parse_ncellmeas(m_ncellmeas_max);
+	}
+
+	uint64_t ns = (now_ns() - start) / HIO_LTE_BENCH_ITERATIONS;
+
+	TC_PRINT("bench %-12s %8llu ns/line (limit %llu ns/line)\n", "ncellmeas_max",
+		 (unsigned long long)ns, (unsigned long long)HIO_LTE_BENCH_MAX_NS_NCELLMEAS_MAX);
+
+	zassert_true(ns <= HIO_LTE_BENCH_MAX_NS_NCELLMEAS_MAX,
+		     "ncellmeas_max regressed: %llu ns/line > %llu ns/line",
+		     (unsigned long long)ns, (unsigned long long)HIO_LTE_BENCH_MAX_NS_NCELLMEAS_MAX);
+}
+
+ZTEST(hio_lte_bench, test_coneval)
+{
+	bench_parser("coneval");
+}
+
+ZTEST(hio_lte_bench, test_cgdcont)
+{
+	bench_parser("cgdcont");
+}
+
+ZTEST(hio_lte_bench, test_xmodemsleep)
+{
+	bench_parser("xmodemsleep");
+}
+
+ZTEST(hio_lte_bench, test_rai)
+{
+	bench_parser("rai");
+}
+
+ZTEST(hio_lte_bench, test_replay)
+{
+	/* The whole capture in order, prefix lookup included; lines without a
+	 * parser (+CSCON) only cost the lookup, rejected ones are skipped */
+	uint64_t start = now_ns();
+
+	for (int i = 0; i < HIO_LTE_BENCH_ITERATIONS; i++) {
+		for (size_t j = 0; j < m_line_count; j++) {
+			if (m_rejected[j]) {
+				continue;
+			}
+
+			struct parser *parser = find_parser(m_lines[j]);
+
+			if (parser) {
+				parser->parse(m_lines[j] + strlen(parser->prefix));
+			}
+		}
+	}
+
+	uint64_t ns = (now_ns() - start) / ((uint64_t)HIO_LTE_BENCH_ITERATIONS * m_line_count);
+
+	TC_PRINT("bench %-12s %8llu ns/line %4zu lines (limit %llu ns/line)\n", "replay",
+		 (unsigned long long)ns, m_line_count,
+		 (unsigned long long)HIO_LTE_BENCH_MAX_NS_REPLAY);
+
+	zassert_true(ns <= HIO_LTE_BENCH_MAX_NS_REPLAY,
+		     "replay regressed: %llu ns/line > %llu ns/line", (unsigned long long)ns,
+		     (unsigned long long)HIO_LTE_BENCH_MAX_NS_REPLAY);
+}
+
+ZTEST_SUITE(hio_lte_bench, NULL, suite_setup, NULL, NULL, NULL);
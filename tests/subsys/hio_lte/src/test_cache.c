@@ -0,0 +1,125 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_cache.h>
+
+#include <errno.h>
+#include <string.h>
+
+static void before(void *fixture)
+{
+	zassert_ok(hio_lte_cache_init());
+}
+
+ZTEST(cache, test_empty_cache_misses)
+{
+	uint64_t imei;
+	char hw_version[32];
+
+	zassert_equal(hio_lte_cache_begin("mfw_nrf91x1_2.0.2"), -ESTALE);
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "hardwario"));
+	zassert_equal(hio_lte_cache_get_identity(&imei, hw_version, sizeof(hw_version)),
+		      -ENOENT);
+}
+
+ZTEST(cache, test_update_then_hit)
+{
+	zassert_equal(hio_lte_cache_begin("mfw_nrf91x1_2.0.2"), -ESTALE);
+
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_CGDCONT, "hardwario");
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_XBANDLOCK, "");
+
+	/* Not stored by the modem before CFUN=0 */
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "hardwario"));
+
+	zassert_ok(hio_lte_cache_save());
+
+	zassert_true(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "hardwario"));
+	zassert_true(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_XBANDLOCK, ""));
+
+	/* Changed config must be written again */
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "iot.example"));
+
+	/* Items are independent */
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGAUTH, "hardwario"));
+
+	/* Same FW keeps the entries */
+	zassert_ok(hio_lte_cache_begin("mfw_nrf91x1_2.0.2"));
+	zassert_true(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "hardwario"));
+}
+
+ZTEST(cache, test_rewrite_keeps_stored_value)
+{
+	zassert_equal(hio_lte_cache_begin("mfw_nrf91x1_2.0.2"), -ESTALE);
+
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_CGDCONT, "hardwario");
+	zassert_ok(hio_lte_cache_save());
+
+	/* Modem reset before CFUN=0 keeps the old value in its NVM */
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_CGDCONT, "iot.example");
+	zassert_true(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "hardwario"));
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "iot.example"));
+
+	zassert_ok(hio_lte_cache_save());
+	zassert_true(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, "iot.example"));
+}
+
+ZTEST(cache, test_fw_change_drops_entries)
+{
+	uint64_t imei;
+	char hw_version[32];
+
+	zassert_equal(hio_lte_cache_begin("mfw_nrf91x1_2.0.1"), -ESTALE);
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_CPSMS, "1,00111000,00000000");
+	hio_lte_cache_set_identity(351358815178345ULL, "nRF9151 LACA A0A");
+	zassert_ok(hio_lte_cache_save());
+
+	zassert_equal(hio_lte_cache_begin("mfw_nrf91x1_2.0.2"), -ESTALE);
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CPSMS, "1,00111000,00000000"));
+	zassert_equal(hio_lte_cache_get_identity(&imei, hw_version, sizeof(hw_version)),
+		      -ENOENT);
+}
+
+ZTEST(cache, test_identity_round_trip)
+{
+	uint64_t imei = 0;
+	char hw_version[32];
+
+	zassert_equal(hio_lte_cache_begin("mfw_nrf91x1_2.0.2"), -ESTALE);
+	hio_lte_cache_set_identity(351358815178345ULL, "nRF9151 LACA A0A");
+
+	zassert_ok(hio_lte_cache_get_identity(&imei, hw_version, sizeof(hw_version)));
+	zassert_equal(imei, 351358815178345ULL);
+	zassert_str_equal(hw_version, "nRF9151 LACA A0A");
+
+	/* Short buffer is terminated */
+	char short_buf[8];
+	zassert_ok(hio_lte_cache_get_identity(&imei, short_buf, sizeof(short_buf)));
+	zassert_str_equal(short_buf, "nRF9151");
+}
+
+ZTEST(cache, test_invalidate_keeps_identity)
+{
+	uint64_t imei;
+	char hw_version[32];
+
+	zassert_equal(hio_lte_cache_begin("mfw_nrf91x1_2.0.2"), -ESTALE);
+	hio_lte_cache_update(HIO_LTE_CACHE_ITEM_XSYSTEMMODE, "1,1,0,1");
+	hio_lte_cache_set_identity(351358815178345ULL, "nRF9151 LACA A0A");
+	zassert_ok(hio_lte_cache_save());
+
+	zassert_ok(hio_lte_cache_invalidate());
+
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_XSYSTEMMODE, "1,1,0,1"));
+	zassert_ok(hio_lte_cache_get_identity(&imei, hw_version, sizeof(hw_version)));
+}
+
+ZTEST(cache, test_invalid_args)
+{
+	zassert_equal(hio_lte_cache_begin(NULL), -EINVAL);
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_COUNT, ""));
+	zassert_false(hio_lte_cache_check(HIO_LTE_CACHE_ITEM_CGDCONT, NULL));
+	zassert_equal(hio_lte_cache_get_identity(NULL, NULL, 0), -EINVAL);
+}
+
+ZTEST_SUITE(cache, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,91 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio/hio_lte.h>
+#include <hio_lte_defer.h>
+
+/* CONFIG_HIO_LTE_DEFER_EVAL_INTERVAL is 60 s and CONFIG_HIO_LTE_DEFER_MIN_EEST 7 */
+#define T0 1000
+
+static void before(void *fixture)
+{
+	hio_lte_defer_init();
+}
+
+static struct hio_lte_conn_param conn(int eest)
+{
+	return (struct hio_lte_conn_param){.valid = true, .result = 0, .eest = eest};
+}
+
+ZTEST(defer, test_evaluate_then_send)
+{
+	struct hio_lte_conn_param param = conn(8);
+	struct hio_lte_defer_stats stats;
+
+	zassert_equal(hio_lte_defer_decide(T0), HIO_LTE_DEFER_ACTION_EVALUATE);
+	/* Requested already; do not pile up evaluations */
+	zassert_equal(hio_lte_defer_decide(T0 + 100), HIO_LTE_DEFER_ACTION_WAIT);
+
+	hio_lte_defer_update(&param, T0 + 500);
+	zassert_equal(hio_lte_defer_decide(T0 + 600), HIO_LTE_DEFER_ACTION_SEND);
+
+	hio_lte_defer_get_stats(&stats);
+	zassert_equal(stats.evaluations, 1);
+}
+
+ZTEST(defer, test_poor_conditions_throttled)
+{
+	struct hio_lte_conn_param param = conn(5);
+
+	zassert_equal(hio_lte_defer_decide(T0), HIO_LTE_DEFER_ACTION_EVALUATE);
+	hio_lte_defer_update(&param, T0 + 500);
+
+	/* The poor result is cached for the whole interval */
+	zassert_equal(hio_lte_defer_decide(T0 + 1000), HIO_LTE_DEFER_ACTION_WAIT);
+	zassert_equal(hio_lte_defer_decide(T0 + 60000), HIO_LTE_DEFER_ACTION_WAIT);
+
+	zassert_equal(hio_lte_defer_decide(T0 + 60500), HIO_LTE_DEFER_ACTION_EVALUATE);
+
+	param = conn(7);
+	hio_lte_defer_update(&param, T0 + 61000);
+	zassert_equal(hio_lte_defer_decide(T0 + 61000), HIO_LTE_DEFER_ACTION_SEND);
+}
+
+ZTEST(defer, test_failed_evaluation)
+{
+	struct hio_lte_conn_param param = conn(9);
+
+	param.result = 1;
+
+	zassert_equal(hio_lte_defer_decide(T0), HIO_LTE_DEFER_ACTION_EVALUATE);
+	hio_lte_defer_update(&param, T0 + 500);
+	zassert_equal(hio_lte_defer_decide(T0 + 600), HIO_LTE_DEFER_ACTION_WAIT);
+
+	hio_lte_defer_update(NULL, T0 + 700);
+	zassert_equal(hio_lte_defer_decide(T0 + 800), HIO_LTE_DEFER_ACTION_WAIT);
+}
+
+ZTEST(defer, test_stale_good_result)
+{
+	struct hio_lte_conn_param param = conn(9);
+
+	hio_lte_defer_update(&param, T0);
+
+	zassert_equal(hio_lte_defer_decide(T0 + 59999), HIO_LTE_DEFER_ACTION_SEND);
+	zassert_equal(hio_lte_defer_decide(T0 + 60000), HIO_LTE_DEFER_ACTION_EVALUATE);
+}
+
+ZTEST(defer, test_release_stats)
+{
+	struct hio_lte_defer_stats stats;
+
+	hio_lte_defer_release(false);
+	hio_lte_defer_release(true);
+	hio_lte_defer_release(true);
+
+	hio_lte_defer_get_stats(&stats);
+	zassert_equal(stats.sent_good, 1);
+	zassert_equal(stats.sent_deadline, 2);
+}
+
+ZTEST_SUITE(defer, NULL, NULL, before, NULL, NULL);
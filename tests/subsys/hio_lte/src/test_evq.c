@@ -0,0 +1,144 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio/hio_lte.h>
+#include <hio_lte_evq.h>
+
+#include <errno.h>
+#include <string.h>
+
+static void before(void *fixture)
+{
+	hio_lte_evq_init();
+}
+
+ZTEST(evq, test_fifo_with_payload)
+{
+	struct hio_lte_cereg_param cereg = {.valid = true, .cid = 0x000AE520, .active_time = 60};
+	struct hio_lte_rai_param rai = {.valid = true, .as_rai = true, .plmn = 23003};
+	struct hio_lte_evq_item item;
+
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_REGISTERED, &cereg));
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_RAI, &rai));
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_SEND, NULL));
+
+	/* The payload is a copy; later changes do not leak into the queue */
+	cereg.cid = 0;
+
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_REGISTERED);
+	zassert_true(item.cereg.valid);
+	zassert_equal(item.cereg.cid, 0x000AE520);
+	zassert_equal(item.cereg.active_time, 60);
+
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_RAI);
+	zassert_true(item.rai.as_rai);
+	zassert_equal(item.rai.plmn, 23003);
+
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_SEND);
+
+	zassert_equal(hio_lte_evq_get(&item), -ENODATA);
+}
+
+ZTEST(evq, test_overflow)
+{
+	struct hio_lte_evq_stats stats;
+	struct hio_lte_evq_item item;
+
+	/* CONFIG_HIO_LTE_EVENT_QUEUE_SIZE is 4 in this test */
+	for (int i = 0; i < 4; i++) {
+		zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_TIMEOUT, NULL));
+	}
+
+	zassert_equal(hio_lte_evq_put(HIO_LTE_FSM_EVENT_ERROR, NULL), -ENOSPC);
+
+	hio_lte_evq_get_stats(&stats);
+	zassert_equal(stats.posted, 4);
+	zassert_equal(stats.dropped, 1);
+	zassert_equal(stats.max_depth, 4);
+
+	/* Wrap around the ring a few times */
+	for (int i = 0; i < 10; i++) {
+		zassert_ok(hio_lte_evq_get(&item));
+		zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_XTIME, NULL));
+	}
+
+	for (int i = 0; i < 4; i++) {
+		zassert_ok(hio_lte_evq_get(&item));
+		zassert_equal(item.event, HIO_LTE_FSM_EVENT_XTIME);
+	}
+
+	zassert_equal(hio_lte_evq_get(&item), -ENODATA);
+}
+
+ZTEST(evq, test_cscon_coalescing)
+{
+	struct hio_lte_evq_stats stats;
+	struct hio_lte_evq_item item;
+
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_1, NULL));
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_1, NULL));
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_0, NULL));
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_0, NULL));
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_1, NULL));
+
+	hio_lte_evq_get_stats(&stats);
+	zassert_equal(stats.coalesced, 2);
+
+	/* Toggles are kept, repeats are not */
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_CSCON_1);
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_CSCON_0);
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_CSCON_1);
+	zassert_equal(hio_lte_evq_get(&item), -ENODATA);
+
+	/* Once handled, the same value is a new event again */
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_1, NULL));
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_CSCON_1);
+}
+
+ZTEST(evq, test_ncellmeas_latest)
+{
+	static struct hio_lte_ncellmeas_param param;
+	struct hio_lte_evq_item item;
+
+	memset(&param, 0, sizeof(param));
+	param.valid = true;
+	param.num_cells = 1;
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_NCELLMEAS, &param));
+
+	param.num_cells = 2;
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_NCELLMEAS, &param));
+
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_NCELLMEAS);
+	zassert_equal(hio_lte_evq_get(&item), -ENODATA);
+
+	memset(&param, 0, sizeof(param));
+	zassert_ok(hio_lte_evq_get_ncellmeas(&param));
+	zassert_true(param.valid);
+	zassert_equal(param.num_cells, 2);
+}
+
+ZTEST(evq, test_flush)
+{
+	struct hio_lte_evq_item item;
+
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_1, NULL));
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_TIMEOUT, NULL));
+
+	hio_lte_evq_flush();
+
+	zassert_ok(hio_lte_evq_put(HIO_LTE_FSM_EVENT_CSCON_1, NULL));
+
+	zassert_ok(hio_lte_evq_get(&item));
+	zassert_equal(item.event, HIO_LTE_FSM_EVENT_CSCON_1);
+	zassert_equal(hio_lte_evq_get(&item), -ENODATA);
+}
+
+ZTEST_SUITE(evq, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,59 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_hint.h>
+
+#include <errno.h>
+
+static void before(void *fixture)
+{
+	zassert_ok(hio_lte_hint_init());
+}
+
+ZTEST(hint, test_update_and_reject)
+{
+	struct hio_lte_hint cell = {.plmn = 23003, .band = 20, .earfcn = 6447};
+	struct hio_lte_hint hint;
+
+	zassert_equal(hio_lte_hint_get(&hint), -ENOENT);
+
+	zassert_ok(hio_lte_hint_update(&cell));
+	zassert_ok(hio_lte_hint_get(&hint));
+	zassert_equal(hint.plmn, 23003);
+	zassert_equal(hint.band, 20);
+	zassert_equal(hint.earfcn, 6447);
+
+	hio_lte_hint_reject();
+	zassert_equal(hio_lte_hint_get(&hint), -ENOENT);
+
+	/* A successful attach on the same cell makes it usable again */
+	zassert_ok(hio_lte_hint_update(&cell));
+	zassert_ok(hio_lte_hint_get(&hint));
+}
+
+ZTEST(hint, test_invalid)
+{
+	struct hio_lte_hint cell = {.plmn = 0, .band = 20, .earfcn = 6447};
+
+	zassert_equal(hio_lte_hint_update(&cell), -EINVAL);
+
+	cell.plmn = 23003;
+	cell.band = 0;
+	zassert_equal(hio_lte_hint_update(&cell), -EINVAL);
+
+	zassert_equal(hio_lte_hint_update(NULL), -EINVAL);
+	zassert_equal(hio_lte_hint_get(NULL), -EINVAL);
+}
+
+ZTEST(hint, test_applied)
+{
+	zassert_false(hio_lte_hint_is_applied());
+
+	hio_lte_hint_set_applied(true);
+	zassert_true(hio_lte_hint_is_applied());
+
+	hio_lte_hint_set_applied(false);
+	zassert_false(hio_lte_hint_is_applied());
+}
+
+ZTEST_SUITE(hint, NULL, NULL, before, NULL, NULL);
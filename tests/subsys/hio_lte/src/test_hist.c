@@ -0,0 +1,67 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_hist.h>
+
+#include <stdint.h>
+#include <string.h>
+
+ZTEST(hist, test_buckets)
+{
+	struct hio_lte_hist hist;
+
+	memset(&hist, 0, sizeof(hist));
+
+	hio_lte_hist_add(&hist, 0);
+	hio_lte_hist_add(&hist, 99);
+	hio_lte_hist_add(&hist, 100);
+	hio_lte_hist_add(&hist, 119999);
+	hio_lte_hist_add(&hist, 120000);
+	hio_lte_hist_add(&hist, UINT32_MAX);
+
+	zassert_equal(hist.count, 6);
+	zassert_equal(hist.buckets[0], 2);
+	zassert_equal(hist.buckets[1], 1);
+	zassert_equal(hist.buckets[HIO_LTE_HIST_BUCKETS - 2], 1);
+	zassert_equal(hist.buckets[HIO_LTE_HIST_BUCKETS - 1], 2);
+	zassert_equal(hist.max_ms, UINT32_MAX);
+}
+
+ZTEST(hist, test_edges)
+{
+	zassert_equal(hio_lte_hist_edge_ms(0), 100);
+	zassert_equal(hio_lte_hist_edge_ms(HIO_LTE_HIST_BUCKETS - 2), 120000);
+	zassert_equal(hio_lte_hist_edge_ms(HIO_LTE_HIST_BUCKETS - 1), UINT32_MAX);
+	zassert_equal(hio_lte_hist_edge_ms(-1), UINT32_MAX);
+
+	for (int i = 1; i < HIO_LTE_HIST_BUCKETS; i++) {
+		zassert_true(hio_lte_hist_edge_ms(i) > hio_lte_hist_edge_ms(i - 1));
+	}
+}
+
+ZTEST(hist, test_percentile_tail)
+{
+	struct hio_lte_hist hist;
+
+	memset(&hist, 0, sizeof(hist));
+
+	zassert_equal(hio_lte_hist_percentile_ms(&hist, 50), 0);
+
+	/* 98 fast on-air waits, 2 slow ones: the average hides the tail */
+	for (int i = 0; i < 98; i++) {
+		hio_lte_hist_add(&hist, 150);
+	}
+
+	hio_lte_hist_add(&hist, 25000);
+	hio_lte_hist_add(&hist, 41000);
+
+	zassert_equal(hio_lte_hist_percentile_ms(&hist, 50), 200);
+	zassert_equal(hio_lte_hist_percentile_ms(&hist, 98), 200);
+	zassert_equal(hio_lte_hist_percentile_ms(&hist, 99), 30000);
+	/* The top bucket is capped at the longest value seen */
+	zassert_equal(hio_lte_hist_percentile_ms(&hist, 100), 41000);
+	zassert_equal(hio_lte_hist_percentile_ms(&hist, 250), 41000);
+	zassert_equal(hio_lte_hist_percentile_ms(NULL, 50), 0);
+}
+
+ZTEST_SUITE(hist, NULL, NULL, NULL, NULL, NULL);
@@ -143,6 +143,20 @@ ZTEST(parser, test_urc_cereg_2_empty)
 	zassert_equal(param.act, 0, "param.act not equal");
 }
 
+ZTEST(parser, test_urc_cereg_1_cause_type)
+{
+	struct hio_lte_cereg_param param;
+	int ret = hio_lte_parse_urc_cereg("1,\"AF66\",\"009DE067\",7,0", &param);
+
+	zassert_ok(ret, "hio_lte_parse_urc_cereg failed");
+	zassert_equal(param.valid, true, "param.valid not true");
+	zassert_equal(param.stat, 1, "param.stat not equal");
+	zassert_true(strcmp(param.tac, "AF66") == 0, "param.tac not equal");
+	zassert_equal(param.cid, 0x009DE067, "param.cid not equal");
+	zassert_equal(param.act, 7, "param.act not equal");
+	zassert_equal(param.cause_type, 0, "param.cause_type not equal");
+}
+
 ZTEST(parser, test_urc_cereg_4)
 {
 	struct hio_lte_cereg_param param;
@@ -523,4 +537,107 @@ ZTEST(parser, test_urc_ncellmeas_complex_b)
 	zassert_equal(param.cells[6].neighbor_count, 0, "cells[6].neighbor_count mismatch");
 }
 
+ZTEST(parser, test_urc_ncellmeas_ten_neighboring)
+{
+	/* Exactly HIO_LTE_NCELLMEAS_NCELL_MAX neighbors fill the table */
+	struct hio_lte_ncellmeas_param param;
+	int ret = hio_lte_parse_urc_ncellmeas(
+		"0,\"00011B07\",\"26295\",\"00B7\",10512,9034,2300,7,63,31,150344527,1,10,"
+		"2300,8,60,29,92,2300,9,59,28,100,2400,10,56,27,162,2400,11,55,26,184,"
+		"2400,12,54,25,-20,2400,13,53,24,-40,2400,14,52,23,0,2400,15,51,22,12,"
+		"2400,16,50,21,14,2400,17,49,20,16",
+		5, &param);
+
+	zassert_ok(ret, "hio_lte_parse_urc_ncellmeas failed");
+	zassert_equal(param.valid, true, "param.valid not true");
+	zassert_equal(param.num_cells, 1, "param.num_cells not equal");
+	zassert_equal(param.num_ncells, 10, "param.num_ncells not equal");
+	zassert_equal(param.cells[0].valid, true, "cells[0].valid not true");
+	zassert_equal(param.cells[0].neighbor_count, 10, "cells[0].neighbor_count not equal");
+	zassert_equal(param.cells[0].ncells, &param.ncells[0], "cells[0].ncells not equal pointer");
+	zassert_equal(param.ncells[4].time_diff, -20, "ncells[4].time_diff not equal");
+	zassert_equal(param.ncells[9].pci, 17, "ncells[9].pci not equal");
+}
+
+ZTEST(parser, test_urc_ncellmeas_neighboring_overflow)
+{
+	/* Neighbors past the table are left out, the cells stay */
+	struct hio_lte_ncellmeas_param param;
+	int ret = hio_lte_parse_urc_ncellmeas(
+		"0,\"00011B07\",\"26295\",\"00B7\",10512,9034,2300,7,63,31,150344527,1,8,"
+		"2300,8,60,29,92,2300,9,59,28,100,2400,10,56,27,162,2400,11,55,26,184,"
+		"2400,12,54,25,-20,2400,13,53,24,-40,2400,14,52,23,0,2400,15,51,22,12,"
+		"\"00011B08\",\"26295\",\"00B7\",65535,0,6300,20,40,20,150344600,0,3,"
+		"6300,21,39,19,1,6300,22,38,18,2,6300,23,37,17,3",
+		5, &param);
+
+	zassert_ok(ret, "hio_lte_parse_urc_ncellmeas failed");
+	zassert_equal(param.valid, true, "param.valid not true");
+	zassert_equal(param.num_cells, 2, "param.num_cells not equal");
+	zassert_equal(param.num_ncells, 10, "param.num_ncells not equal");
+	zassert_equal(param.cells[0].neighbor_count, 8, "cells[0].neighbor_count not equal");
+	zassert_equal(param.cells[1].valid, true, "cells[1].valid not true");
+	zassert_equal(param.cells[1].neighbor_count, 2, "cells[1].neighbor_count not equal");
+	zassert_equal(param.cells[1].ncells, &param.ncells[8], "cells[1].ncells not equal pointer");
+	zassert_equal(param.ncells[9].pci, 22, "ncells[9].pci not equal");
+}
+
+ZTEST(parser, test_urc_ncellmeas_cell_out_of_range)
+{
+	/* RSRP 300 spoils the second cell only; the bad neighbor is left out */
+	struct hio_lte_ncellmeas_param param;
+	int ret = hio_lte_parse_urc_ncellmeas(
+		"0,\"00011B07\",\"26295\",\"00B7\",10512,9034,2300,7,63,31,150344527,1,2,"
+		"2300,8,60,29,92,2300,9,999,28,100,"
+		"\"00011B08\",\"26295\",\"00B7\",65535,0,6300,20,300,20,150344600,0,0,"
+		"\"00011B09\",\"26295\",\"00B7\",65535,0,6300,24,41,21,150344600,0,0",
+		5, &param);
+
+	zassert_ok(ret, "hio_lte_parse_urc_ncellmeas failed");
+	zassert_equal(param.valid, true, "param.valid not true");
+	zassert_equal(param.num_cells, 3, "param.num_cells not equal");
+	zassert_equal(param.num_ncells, 1, "param.num_ncells not equal");
+	zassert_equal(param.cells[0].valid, true, "cells[0].valid not true");
+	zassert_equal(param.cells[0].neighbor_count, 1, "cells[0].neighbor_count not equal");
+	zassert_equal(param.cells[1].valid, false, "cells[1].valid not false");
+	zassert_equal(param.cells[2].valid, true, "cells[2].valid not true");
+	zassert_equal(param.cells[2].pci, 24, "cells[2].pci not equal");
+}
+
+ZTEST(parser, test_urc_ncellmeas_malformed)
+{
+	/* The second cell is cut short: the first one is kept, the line is not valid */
+	struct hio_lte_ncellmeas_param param;
+	int ret = hio_lte_parse_urc_ncellmeas(
+		"0,\"00011B07\",\"26295\",\"00B7\",10512,9034,2300,7,63,31,150344527,1,0,"
+		"\"00011B08\",\"26295\",\"00B7\",65535,0,6300",
+		5, &param);
+
+	zassert_not_equal(ret, 0, "hio_lte_parse_urc_ncellmeas did not fail");
+	zassert_equal(param.valid, false, "param.valid not false");
+	zassert_equal(param.num_cells, 1, "param.num_cells not equal");
+	zassert_equal(param.cells[0].valid, true, "cells[0].valid not true");
+	zassert_equal(param.cells[1].valid, false, "cells[1].valid not false");
+}
+
+ZTEST(parser, test_urc_ncellmeas_link)
+{
+	static struct hio_lte_ncellmeas_param param;
+	static struct hio_lte_ncellmeas_param copy;
+	int ret = hio_lte_parse_urc_ncellmeas(
+		"0,\"00011B07\",\"26295\",\"00B7\",10512,9034,2300,7,63,31,150344527,1,0,"
+		"\"00011B08\",\"26295\",\"00B7\",65535,0,6300,20,40,20,150344600,0,2,"
+		"6300,21,39,19,1,6300,22,38,18,2",
+		5, &param);
+
+	zassert_ok(ret, "hio_lte_parse_urc_ncellmeas failed");
+
+	memcpy(&copy, &param, sizeof(copy));
+	hio_lte_parse_ncellmeas_link(&copy);
+
+	zassert_is_null(copy.cells[0].ncells, "cells[0].ncells not null");
+	zassert_equal(copy.cells[1].ncells, &copy.ncells[0], "cells[1].ncells not in the copy");
+	zassert_equal(copy.cells[1].ncells[1].pci, 22, "cells[1].ncells[1].pci not equal");
+}
+
 ZTEST_SUITE(parser, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,230 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_cache.h>
+#include <hio_lte_plan.h>
+
+#include <errno.h>
+#include <string.h>
+
+/* Talk layer stub: records the commands and fails the first m_fail_count
+ * sends of m_fail_cmd */
+
+static char m_sent[16][64];
+static int m_sent_count;
+static const char *m_fail_cmd;
+static int m_fail_count;
+
+static int stub_send(const char *s)
+{
+	if (m_sent_count < ARRAY_SIZE(m_sent)) {
+		strncpy(m_sent[m_sent_count], s, sizeof(m_sent[0]) - 1);
+	}
+	m_sent_count++;
+
+	if (m_fail_cmd && !strcmp(s, m_fail_cmd) && m_fail_count > 0) {
+		m_fail_count--;
+		return -EILSEQ;
+	}
+
+	return 0;
+}
+
+int hio_lte_talk_at_cmd(const char *s)
+{
+	return stub_send(s);
+}
+
+int hio_lte_talk_at_cmd_with_resp_prefix(const char *s, char *buf, size_t size, const char *pfx)
+{
+	int ret = stub_send(s);
+	if (ret) {
+		return ret;
+	}
+
+	/* Echo the command back as the value */
+	strncpy(buf, s, size - 1);
+	buf[size - 1] = '\0';
+
+	return 0;
+}
+
+void hio_lte_talk_set_quiet(bool quiet)
+{
+}
+
+static char m_handled[64];
+
+static int handle(const char *value)
+{
+	strncpy(m_handled, value, sizeof(m_handled) - 1);
+
+	return 0;
+}
+
+static int handle_reject(const char *value)
+{
+	return -ENODEV;
+}
+
+static bool skip_always(void)
+{
+	return true;
+}
+
+static int build_apn(char *buf, size_t size)
+{
+	snprintf(buf, size, "AT+CGDCONT=0,\"IP\",\"%s\"", "hardwario");
+
+	return 0;
+}
+
+static void before(void *fixture)
+{
+	memset(m_sent, 0, sizeof(m_sent));
+	memset(m_handled, 0, sizeof(m_handled));
+	m_sent_count = 0;
+	m_fail_cmd = NULL;
+	m_fail_count = 0;
+
+	zassert_ok(hio_lte_cache_init());
+	hio_lte_cache_begin("mfw_test");
+}
+
+static const struct hio_lte_plan_trace_step *trace_step(struct hio_lte_plan_trace *trace,
+							 const char *plan, size_t i)
+{
+	for (int n = 0; !hio_lte_plan_get_trace(n, trace); n++) {
+		if (!strcmp(trace->plan, plan)) {
+			zassert_true(i < trace->count);
+			return &trace->steps[i];
+		}
+	}
+
+	zassert_unreachable("no trace for plan %s", plan);
+
+	return NULL;
+}
+
+ZTEST(plan, test_runs_in_order)
+{
+	static const struct hio_lte_plan_step steps[] = {
+		{.name = "a", .cmd = "AT+A=1"},
+		{.name = "b", .cmd = "AT+B?", .expect = "+B: ", .handle = handle},
+		{.name = "c", .build = build_apn},
+	};
+	static struct hio_lte_plan_trace trace;
+
+	zassert_ok(hio_lte_plan_run("order", steps, ARRAY_SIZE(steps)));
+
+	zassert_equal(m_sent_count, 3);
+	zassert_str_equal(m_sent[0], "AT+A=1");
+	zassert_str_equal(m_sent[1], "AT+B?");
+	zassert_str_equal(m_sent[2], "AT+CGDCONT=0,\"IP\",\"hardwario\"");
+	zassert_str_equal(m_handled, "AT+B?");
+
+	zassert_equal(trace_step(&trace, "order", 0)->result, HIO_LTE_PLAN_STEP_RESULT_OK);
+	zassert_equal(trace.count, 3);
+	zassert_equal(trace.err, 0);
+	zassert_equal(trace.steps[2].attempts, 1);
+}
+
+ZTEST(plan, test_required_failure_stops)
+{
+	static const struct hio_lte_plan_step steps[] = {
+		{.name = "a", .cmd = "AT+A?", .expect = "+A: ", .handle = handle_reject},
+		{.name = "b", .cmd = "AT+B=1"},
+	};
+	static struct hio_lte_plan_trace trace;
+
+	zassert_equal(hio_lte_plan_run("stop", steps, ARRAY_SIZE(steps)), -ENODEV);
+	zassert_equal(m_sent_count, 1);
+
+	zassert_equal(trace_step(&trace, "stop", 0)->result, HIO_LTE_PLAN_STEP_RESULT_FAILED);
+	zassert_equal(trace.steps[0].err, -ENODEV);
+	zassert_equal(trace.count, 1);
+	zassert_equal(trace.err, -ENODEV);
+}
+
+ZTEST(plan, test_optional_failure_continues)
+{
+	static const struct hio_lte_plan_step steps[] = {
+		{.name = "a", .cmd = "AT+A=1", .flags = HIO_LTE_PLAN_FLAG_OPTIONAL},
+		{.name = "b", .cmd = "AT+B=1"},
+	};
+
+	m_fail_cmd = "AT+A=1";
+	m_fail_count = 1;
+
+	zassert_ok(hio_lte_plan_run("optional", steps, ARRAY_SIZE(steps)));
+	zassert_equal(m_sent_count, 2);
+}
+
+ZTEST(plan, test_retries)
+{
+	static const struct hio_lte_plan_step steps[] = {
+		{.name = "a", .cmd = "AT+A=1", .retries = 2, .retry_delay_ms = 1},
+	};
+	static struct hio_lte_plan_trace trace;
+
+	m_fail_cmd = "AT+A=1";
+	m_fail_count = 2;
+
+	zassert_ok(hio_lte_plan_run("retry", steps, ARRAY_SIZE(steps)));
+	zassert_equal(m_sent_count, 3);
+	zassert_equal(trace_step(&trace, "retry", 0)->attempts, 3);
+
+	/* Out of retries */
+	m_sent_count = 0;
+	m_fail_count = 3;
+
+	zassert_equal(hio_lte_plan_run("retry", steps, ARRAY_SIZE(steps)), -EILSEQ);
+	zassert_equal(m_sent_count, 3);
+}
+
+ZTEST(plan, test_skip_and_cache)
+{
+	static const struct hio_lte_plan_step steps[] = {
+		{.name = "a", .cmd = "AT+A?", .skip = skip_always},
+		{.name = "b", .build = build_apn, .cache = HIO_LTE_CACHE_ITEM_CGDCONT},
+	};
+	static struct hio_lte_plan_trace trace;
+
+	zassert_ok(hio_lte_plan_run("cache", steps, ARRAY_SIZE(steps)));
+	zassert_equal(m_sent_count, 1);
+	zassert_equal(trace_step(&trace, "cache", 0)->result, HIO_LTE_PLAN_STEP_RESULT_SKIPPED);
+	zassert_equal(trace.steps[1].result, HIO_LTE_PLAN_STEP_RESULT_OK);
+
+	/* Second run after CFUN=0 finds the command applied */
+	zassert_ok(hio_lte_cache_save());
+	zassert_ok(hio_lte_plan_run("cache", steps, ARRAY_SIZE(steps)));
+	zassert_equal(m_sent_count, 1);
+	zassert_equal(trace_step(&trace, "cache", 1)->result, HIO_LTE_PLAN_STEP_RESULT_CACHED);
+}
+
+ZTEST(plan, test_trace_capacity)
+{
+	static struct hio_lte_plan_step steps[CONFIG_HIO_LTE_PLAN_TRACE_SIZE + 2];
+	static struct hio_lte_plan_trace trace;
+
+	for (size_t i = 0; i < ARRAY_SIZE(steps); i++) {
+		steps[i].name = "x";
+		steps[i].cmd = "AT";
+	}
+
+	zassert_ok(hio_lte_plan_run("capacity", steps, ARRAY_SIZE(steps)));
+	trace_step(&trace, "capacity", 0);
+	zassert_equal(trace.count, ARRAY_SIZE(steps));
+}
+
+ZTEST(plan, test_invalid_args)
+{
+	static struct hio_lte_plan_trace trace;
+
+	zassert_equal(hio_lte_plan_run(NULL, NULL, 0), -EINVAL);
+	zassert_equal(hio_lte_plan_run("x", NULL, 1), -EINVAL);
+	zassert_equal(hio_lte_plan_get_trace(-1, &trace), -EINVAL);
+	zassert_equal(hio_lte_plan_get_trace(0, NULL), -EINVAL);
+}
+
+ZTEST_SUITE(plan, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,141 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_parse.h>
+#include <hio_lte_psm.h>
+
+#include <string.h>
+
+/* CONFIG_HIO_LTE_PSM_MIN_SAMPLES is 4, CONFIG_HIO_LTE_PSM_MIN_TAU 600 and
+ * CONFIG_HIO_LTE_PSM_POLL_ACTIVE_TIME 6 */
+#define T0       1000
+#define INTERVAL (600 * 1000)
+
+static void before(void *fixture)
+{
+	hio_lte_psm_init();
+}
+
+static void record(int count, bool poll)
+{
+	static int64_t now = T0;
+
+	for (int i = 0; i < count; i++) {
+		hio_lte_psm_record(now, poll);
+		now += INTERVAL;
+	}
+}
+
+ZTEST(psm, test_encode_tau)
+{
+	char bits[9];
+
+	zassert_equal(hio_lte_psm_encode_tau(24 * 3600, bits), 24 * 3600);
+	zassert_str_equal(bits, "00111000");
+
+	zassert_equal(hio_lte_psm_encode_tau(3600, bits), 3600);
+	zassert_str_equal(bits, "00000110");
+
+	/* Rounded up to the next value of the finest unit that fits */
+	zassert_equal(hio_lte_psm_encode_tau(61, bits), 62);
+	zassert_str_equal(bits, "01111111");
+
+	zassert_equal(hio_lte_psm_encode_tau(INT32_MAX, bits), 31 * 1152000);
+	zassert_str_equal(bits, "11011111");
+}
+
+ZTEST(psm, test_encode_active)
+{
+	char bits[9];
+
+	zassert_equal(hio_lte_psm_encode_active(0, bits), 0);
+	zassert_str_equal(bits, "00000000");
+
+	zassert_equal(hio_lte_psm_encode_active(6, bits), 6);
+	zassert_str_equal(bits, "00000011");
+
+	zassert_equal(hio_lte_psm_encode_active(120, bits), 120);
+	zassert_str_equal(bits, "00100010");
+
+	zassert_equal(hio_lte_psm_encode_active(100000, bits), 31 * 360);
+	zassert_str_equal(bits, "01011111");
+}
+
+ZTEST(psm, test_learn_interval)
+{
+	struct hio_lte_psm_request req;
+
+	/* Defaults until enough transactions were seen */
+	record(4, false);
+	zassert_equal(hio_lte_psm_get_interval(), 600);
+	zassert_false(hio_lte_psm_is_update_pending());
+	hio_lte_psm_get_request(&req);
+	zassert_str_equal(req.tau, "00111000");
+
+	record(1, false);
+	zassert_true(hio_lte_psm_is_update_pending());
+	hio_lte_psm_get_request(&req);
+	zassert_equal(req.tau_s, 1200);
+	zassert_str_equal(req.tau, "10110100");
+	zassert_equal(req.active_s, 0);
+
+	hio_lte_psm_set_applied(&req);
+	zassert_false(hio_lte_psm_is_update_pending());
+
+	/* The same pattern does not ask again */
+	record(4, false);
+	zassert_false(hio_lte_psm_is_update_pending());
+}
+
+ZTEST(psm, test_min_tau)
+{
+	struct hio_lte_psm_request req;
+
+	/* Every 10 s would ask for a 20 s TAU */
+	for (int i = 0; i < 5; i++) {
+		hio_lte_psm_record(T0 + i * 10 * 1000, false);
+	}
+
+	hio_lte_psm_get_request(&req);
+	zassert_equal(req.tau_s, 600);
+	zassert_str_equal(req.tau, "10010100");
+}
+
+ZTEST(psm, test_poll_active_time)
+{
+	struct hio_lte_psm_request req;
+
+	record(8, true);
+	hio_lte_psm_get_request(&req);
+	zassert_equal(req.active_s, 6);
+	zassert_str_equal(req.active, "00000011");
+}
+
+ZTEST(psm, test_predict_sleep)
+{
+	zassert_equal(hio_lte_psm_predict_sleep(6000), -1);
+
+	record(2, false);
+
+	/* Awake 6 s of every 600 s */
+	hio_lte_psm_set_granted(0, 1200);
+	zassert_equal(hio_lte_psm_predict_sleep(6000), 990);
+
+	/* A short TAU adds ten wakeups in between */
+	hio_lte_psm_set_granted(0, 60);
+	zassert_equal(hio_lte_psm_predict_sleep(6000), 890);
+
+	/* Active time counts for every wakeup */
+	hio_lte_psm_set_granted(6, 1200);
+	zassert_equal(hio_lte_psm_predict_sleep(6000), 980);
+
+	int active, tau;
+	hio_lte_psm_get_granted(&active, &tau);
+	zassert_equal(active, 6);
+	zassert_equal(tau, 1200);
+
+	hio_lte_psm_set_granted(GRPS_TIMER_DEACTIVATED, GRPS_TIMER_DEACTIVATED);
+	zassert_equal(hio_lte_psm_predict_sleep(6000), 990);
+}
+
+ZTEST_SUITE(psm, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,128 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio/hio_lte.h>
+#include <hio_lte_parse.h>
+#include <hio_lte_resp.h>
+
+#include <errno.h>
+#include <string.h>
+
+static const char m_cgdcont[] = "+CGDCONT: 0,\"IP\",\"iot.1nce.net\",\"10.52.2.149\",0,0\r\n"
+				"+CGDCONT: 1,\"IPV6\",\"example.apn\",\"\",0,0\r\n"
+				"+CGDCONT: 2,\"IP\",\"third.apn\",\"10.0.0.2\",0,0\r\n"
+				"OK\r\n";
+
+ZTEST(resp, test_lines)
+{
+	struct hio_lte_resp resp;
+	const char *line;
+	size_t len;
+
+	hio_lte_resp_init(&resp, "\r\n%XICCID: 123\r\n\r\nOK\r\n");
+
+	line = hio_lte_resp_line(&resp, &len);
+	zassert_not_null(line);
+	zassert_equal(len, 12);
+	zassert_mem_equal(line, "%XICCID: 123", len);
+
+	line = hio_lte_resp_line(&resp, &len);
+	zassert_not_null(line);
+	zassert_equal(len, 2);
+	zassert_mem_equal(line, "OK", len);
+
+	zassert_is_null(hio_lte_resp_line(&resp, &len));
+	zassert_is_null(hio_lte_resp_line(&resp, &len));
+}
+
+ZTEST(resp, test_value_non_destructive)
+{
+	static char buf[sizeof(m_cgdcont)];
+	struct hio_lte_resp resp;
+	const char *value;
+	size_t len;
+
+	memcpy(buf, m_cgdcont, sizeof(buf));
+
+	hio_lte_resp_init(&resp, buf);
+
+	value = hio_lte_resp_value(&resp, "+CGDCONT: ", &len);
+	zassert_not_null(value);
+	zassert_equal(value, &buf[strlen("+CGDCONT: ")]);
+	zassert_equal(value[len], '\r');
+
+	zassert_is_null(hio_lte_resp_value(&resp, "%CONEVAL: ", &len));
+
+	/* The buffer is left as it was and can be walked again */
+	zassert_mem_equal(buf, m_cgdcont, sizeof(buf));
+}
+
+ZTEST(resp, test_cgcont_lines)
+{
+	struct hio_lte_resp resp;
+	struct cgdcont_param param;
+	const char *value;
+	size_t len;
+	char line[128];
+	int count = 0;
+
+	hio_lte_resp_init(&resp, m_cgdcont);
+
+	while ((value = hio_lte_resp_value(&resp, "+CGDCONT: ", &len))) {
+		zassert_ok(hio_lte_resp_copy(value, len, line, sizeof(line)));
+		zassert_ok(hio_lte_parse_cgcont(line, &param));
+		zassert_equal(param.cid, count);
+		count++;
+	}
+
+	zassert_equal(count, 3);
+	zassert_true(strcmp(param.apn, "third.apn") == 0);
+	zassert_true(strcmp(param.addr, "10.0.0.2") == 0);
+}
+
+ZTEST(resp, test_coneval_line)
+{
+	struct hio_lte_resp resp;
+	struct hio_lte_conn_param param;
+	const char *value;
+	size_t len;
+	char line[128];
+
+	hio_lte_resp_init(&resp, "%CONEVAL: 0,1,7,68,29,47,\"000AE520\",\"23003\",135,6447,20,0,1,"
+				 "14,2,1,99\r\nOK\r\n");
+
+	value = hio_lte_resp_value(&resp, "%CONEVAL: ", &len);
+	zassert_not_null(value);
+	zassert_ok(hio_lte_resp_copy(value, len, line, sizeof(line)));
+
+	zassert_ok(hio_lte_parse_coneval(line, &param));
+	zassert_true(param.valid);
+	zassert_equal(param.plmn, 23003);
+	zassert_equal(param.cid, 0x000AE520);
+	zassert_equal(param.earfcn, 6447);
+	zassert_equal(param.band, 20);
+	zassert_equal(param.ecl, 1);
+}
+
+ZTEST(resp, test_coneval_failed_result)
+{
+	struct hio_lte_conn_param param;
+
+	zassert_ok(hio_lte_parse_coneval("7", &param));
+	zassert_equal(param.result, 7);
+	zassert_false(param.valid);
+
+	/* A quoted field must be closed */
+	zassert_equal(hio_lte_parse_coneval("0,1,7,68,29,47,\"000AE520", &param), -EINVAL);
+}
+
+ZTEST(resp, test_copy)
+{
+	char buf[4];
+
+	zassert_ok(hio_lte_resp_copy("abc\r\n", 3, buf, sizeof(buf)));
+	zassert_true(strcmp(buf, "abc") == 0);
+	zassert_equal(hio_lte_resp_copy("abcd", 4, buf, sizeof(buf)), -ENOSPC);
+}
+
+ZTEST_SUITE(resp, NULL, NULL, NULL, NULL, NULL);
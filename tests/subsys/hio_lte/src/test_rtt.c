@@ -0,0 +1,173 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_rtt.h>
+
+#include <errno.h>
+#include <stdint.h>
+
+static struct hio_lte_cereg_param cereg(int act, int cid)
+{
+	return (struct hio_lte_cereg_param){
+		.valid = true,
+		.stat = HIO_LTE_CEREG_PARAM_STAT_REGISTERED_HOME,
+		.cid = cid,
+		.act = act,
+		.active_time = -1,
+	};
+}
+
+static void before(void *fixture)
+{
+	hio_lte_rtt_init();
+}
+
+ZTEST(rtt, test_nothing_learned)
+{
+	struct hio_lte_cereg_param c = cereg(HIO_LTE_CEREG_PARAM_ACT_LTE, 0x009DE067);
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(NULL), -ENODATA);
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), -ENODATA);
+
+	for (int i = 0; i < HIO_LTE_RTT_SAMPLES_MIN - 1; i++) {
+		hio_lte_rtt_add(&c, 300);
+	}
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), -ENODATA);
+
+	/* Without registration nothing is learned */
+	struct hio_lte_cereg_param invalid = {0};
+
+	hio_lte_rtt_add(&invalid, 300);
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), -ENODATA);
+}
+
+ZTEST(rtt, test_good_cell_floor)
+{
+	struct hio_lte_cereg_param c = cereg(HIO_LTE_CEREG_PARAM_ACT_LTE, 0x009DE067);
+
+	for (int i = 0; i < HIO_LTE_RTT_SAMPLES_MIN; i++) {
+		hio_lte_rtt_add(&c, 300);
+	}
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), HIO_LTE_RTT_TIMEOUT_MIN_MS);
+}
+
+ZTEST(rtt, test_percentile_ignores_outlier)
+{
+	struct hio_lte_cereg_param c = cereg(HIO_LTE_CEREG_PARAM_ACT_NBIOT, 0x0001A2B3);
+
+	for (int i = 0; i < HIO_LTE_RTT_SAMPLES - 1; i++) {
+		hio_lte_rtt_add(&c, 4000 + i * 100);
+	}
+
+	hio_lte_rtt_add(&c, 50000);
+
+	/* p90 of 16 is the 15th: 5400 ms */
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), 5400 * HIO_LTE_RTT_TIMEOUT_MULT);
+}
+
+ZTEST(rtt, test_capped)
+{
+	struct hio_lte_cereg_param c = cereg(HIO_LTE_CEREG_PARAM_ACT_NBIOT, 0x0001A2B3);
+
+	for (int i = 0; i < HIO_LTE_RTT_SAMPLES_MIN; i++) {
+		hio_lte_rtt_add(&c, 45000);
+	}
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), HIO_LTE_RTT_TIMEOUT_MAX_MS);
+}
+
+ZTEST(rtt, test_timeouts_back_off)
+{
+	struct hio_lte_cereg_param c = cereg(HIO_LTE_CEREG_PARAM_ACT_NBIOT, 0x0001A2B3);
+
+	for (int i = 0; i < HIO_LTE_RTT_SAMPLES; i++) {
+		hio_lte_rtt_add(&c, 2000);
+	}
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), 4000);
+
+	/* Every timeout in a row doubles it */
+	hio_lte_rtt_timeout(&c, 4000);
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), 8000);
+	hio_lte_rtt_timeout(&c, 8000);
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), 16000);
+
+	struct hio_lte_rtt_entry entry;
+
+	/* Censored: the percentile only knows the replies */
+	zassert_ok(hio_lte_rtt_get(1, &entry));
+	zassert_equal(entry.act, HIO_LTE_CEREG_PARAM_ACT_NBIOT);
+	zassert_equal(entry.timeouts, 2);
+	zassert_equal(entry.samples, HIO_LTE_RTT_SAMPLES);
+	zassert_equal(entry.percentile_ms, 2000);
+	zassert_equal(entry.backoff, 2);
+
+	/* Each reply takes one doubling back */
+	hio_lte_rtt_add(&c, 2000);
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), 8000);
+	hio_lte_rtt_add(&c, 2000);
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), 4000);
+
+	/* Limited */
+	for (int i = 0; i < HIO_LTE_RTT_BACKOFF_MAX + 2; i++) {
+		hio_lte_rtt_timeout(&c, 4000);
+	}
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&c), 4000 << HIO_LTE_RTT_BACKOFF_MAX);
+}
+
+ZTEST(rtt, test_new_cell_uses_technology)
+{
+	struct hio_lte_cereg_param a = cereg(HIO_LTE_CEREG_PARAM_ACT_NBIOT, 0x0001A2B3);
+	struct hio_lte_cereg_param b = cereg(HIO_LTE_CEREG_PARAM_ACT_NBIOT, 0x0001A2B4);
+	struct hio_lte_cereg_param m = cereg(HIO_LTE_CEREG_PARAM_ACT_LTE, 0x0001A2B4);
+
+	for (int i = 0; i < HIO_LTE_RTT_SAMPLES_MIN; i++) {
+		hio_lte_rtt_add(&a, 6000);
+	}
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&b), 12000);
+	/* Another technology learns on its own */
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&m), -ENODATA);
+
+	/* Once the cell has its replies, they take over */
+	for (int i = 0; i < HIO_LTE_RTT_SAMPLES_MIN; i++) {
+		hio_lte_rtt_add(&b, 3000);
+	}
+
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&b), 6000);
+	zassert_equal(hio_lte_rtt_get_timeout_ms(&a), 12000);
+}
+
+ZTEST(rtt, test_least_recent_cell_replaced)
+{
+	struct hio_lte_rtt_entry entry;
+	int n = 0;
+
+	for (int cid = 1; cid <= CONFIG_HIO_LTE_RTT_CELLS + 1; cid++) {
+		struct hio_lte_cereg_param c = cereg(HIO_LTE_CEREG_PARAM_ACT_LTE, cid);
+
+		hio_lte_rtt_add(&c, 500);
+	}
+
+	/* Two technologies and the most recent cells */
+	while (!hio_lte_rtt_get(n, &entry)) {
+		if (n >= 2) {
+			zassert_not_equal(entry.eci, 1);
+			zassert_equal(entry.samples, 1);
+		}
+
+		n++;
+	}
+
+	zassert_equal(n, 2 + CONFIG_HIO_LTE_RTT_CELLS);
+	zassert_ok(hio_lte_rtt_get(0, &entry));
+	zassert_equal(entry.eci, HIO_LTE_CELL_ECI_INVALID);
+	zassert_equal(entry.samples, CONFIG_HIO_LTE_RTT_CELLS + 1);
+	zassert_equal(entry.percentile_ms, 500);
+	zassert_equal(hio_lte_rtt_get(-1, &entry), -EINVAL);
+}
+
+ZTEST_SUITE(rtt, NULL, NULL, before, NULL, NULL);
@@ -24,3 +24,85 @@ ZTEST(state_ceer, test_ceer_null_arg)
 }
 
 ZTEST_SUITE(state_ceer, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(state_snapshot, test_text_previous_pointer_intact)
+{
+	char *first = NULL;
+	char *second = NULL;
+
+	hio_lte_state_set_modem_fw_version("mfw_nrf91x1_2.0.1");
+	zassert_ok(hio_lte_state_get_modem_fw_version(&first));
+
+	/* A reader still holding the old pointer is not overwritten */
+	hio_lte_state_set_modem_fw_version("mfw_nrf91x1_2.0.2");
+	zassert_ok(hio_lte_state_get_modem_fw_version(&second));
+
+	zassert_not_equal(first, second);
+	zassert_equal(strcmp(first, "mfw_nrf91x1_2.0.1"), 0, "unexpected version: %s", first);
+	zassert_equal(strcmp(second, "mfw_nrf91x1_2.0.2"), 0, "unexpected version: %s", second);
+}
+
+ZTEST(state_snapshot, test_imei_round_trip)
+{
+	uint64_t imei = 0;
+
+	hio_lte_state_set_imei(351234567890123ULL);
+
+	zassert_ok(hio_lte_state_get_imei(&imei));
+	zassert_equal(imei, 351234567890123ULL);
+	zassert_equal(hio_lte_state_get_imei(NULL), -EINVAL);
+}
+
+#define WRITES 500
+
+static K_THREAD_STACK_DEFINE(m_writer_stack, 1024);
+static struct k_thread m_writer_thread;
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	for (int i = 1; i <= WRITES; i++) {
+		struct hio_lte_conn_param param = {
+			.valid = true,
+			.result = i,
+			.eest = i,
+			.ecl = i,
+			.rsrp = i,
+			.rsrq = i,
+			.snr = i,
+			.plmn = i,
+			.cid = i,
+			.band = i,
+			.earfcn = i,
+		};
+
+		hio_lte_state_set_conn_param(&param);
+
+		k_sleep(K_USEC(100));
+	}
+}
+
+ZTEST(state_snapshot, test_conn_param_consistent)
+{
+	k_thread_create(&m_writer_thread, m_writer_stack, K_THREAD_STACK_SIZEOF(m_writer_stack),
+			writer, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	struct hio_lte_conn_param param;
+
+	/* Every snapshot comes from a single write */
+	do {
+		zassert_ok(hio_lte_state_get_conn_param(&param));
+
+		if (param.valid) {
+			zassert_equal(param.eest, param.result);
+			zassert_equal(param.rsrp, param.result);
+			zassert_equal(param.cid, param.result);
+			zassert_equal(param.earfcn, param.result);
+		}
+
+		k_sleep(K_USEC(50));
+	} while (param.result < WRITES);
+
+	zassert_ok(k_thread_join(&m_writer_thread, K_SECONDS(10)));
+}
+
+ZTEST_SUITE(state_snapshot, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,97 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_flow.h>
+#include <hio_lte_trace.h>
+
+#include <errno.h>
+#include <string.h>
+
+static const char *state_str(uint8_t state)
+{
+	static const char *const names[] = {"disabled", "attach", "ready"};
+
+	return state < ARRAY_SIZE(names) ? names[state] : NULL;
+}
+
+static void before(void *fixture)
+{
+	zassert_ok(hio_lte_trace_init(0, state_str));
+}
+
+ZTEST(trace, test_records)
+{
+	struct hio_lte_trace_entry entry;
+
+	hio_lte_trace_enter(0, 1);
+	hio_lte_trace_transition(0, 1, HIO_LTE_TRACE_EVENT_NONE, 0);
+	hio_lte_trace_event(1, 1, HIO_LTE_FSM_EVENT_TIMEOUT, -ETIMEDOUT);
+
+	zassert_ok(hio_lte_trace_get(0, &entry));
+	zassert_true(entry.flags & HIO_LTE_TRACE_FLAG_TRANSITION);
+	zassert_equal(entry.from, 0);
+	zassert_equal(entry.to, 1);
+	zassert_equal(entry.event, HIO_LTE_TRACE_EVENT_NONE);
+	zassert_true(strcmp(hio_lte_trace_event_str(entry.event), "-") == 0);
+
+	zassert_ok(hio_lte_trace_get(1, &entry));
+	zassert_false(entry.flags & HIO_LTE_TRACE_FLAG_TRANSITION);
+	zassert_equal(entry.event, HIO_LTE_FSM_EVENT_TIMEOUT);
+	zassert_equal(entry.result, -ETIMEDOUT);
+
+	zassert_equal(hio_lte_trace_get(2, &entry), -ENOENT);
+	zassert_equal(hio_lte_trace_get_total(), 2);
+
+	zassert_true(strcmp(hio_lte_trace_state_str(2), "ready") == 0);
+	zassert_true(strcmp(hio_lte_trace_state_str(7), "unknown") == 0);
+}
+
+ZTEST(trace, test_wrap_oldest_first)
+{
+	struct hio_lte_trace_entry entry;
+	int n = CONFIG_HIO_LTE_TRACE_SIZE + 3;
+
+	for (int i = 0; i < n; i++) {
+		hio_lte_trace_event(0, 0, HIO_LTE_FSM_EVENT_SEND, i);
+	}
+
+	zassert_equal(hio_lte_trace_get_total(), n);
+
+	for (int i = 0; i < CONFIG_HIO_LTE_TRACE_SIZE; i++) {
+		zassert_ok(hio_lte_trace_get(i, &entry));
+		zassert_equal(entry.result, 3 + i);
+	}
+
+	zassert_equal(hio_lte_trace_get(CONFIG_HIO_LTE_TRACE_SIZE, &entry), -ENOENT);
+}
+
+ZTEST(trace, test_dwell)
+{
+	struct hio_lte_trace_dwell dwell;
+
+	k_sleep(K_MSEC(20));
+	hio_lte_trace_enter(0, 2);
+	k_sleep(K_MSEC(10));
+
+	zassert_ok(hio_lte_trace_get_dwell(0, &dwell));
+	zassert_equal(dwell.entries, 1);
+	zassert_true(dwell.total_ms >= 20);
+
+	/* The current state includes the time spent so far */
+	zassert_ok(hio_lte_trace_get_dwell(2, &dwell));
+	zassert_equal(dwell.entries, 1);
+	zassert_true(dwell.total_ms >= 10);
+
+	hio_lte_trace_enter(2, 0);
+
+	zassert_ok(hio_lte_trace_get_dwell(0, &dwell));
+	zassert_equal(dwell.entries, 2);
+
+	zassert_ok(hio_lte_trace_get_dwell(1, &dwell));
+	zassert_equal(dwell.entries, 0);
+	zassert_equal(dwell.total_ms, 0);
+
+	zassert_equal(hio_lte_trace_get_dwell(HIO_LTE_TRACE_STATES_MAX, &dwell), -EINVAL);
+}
+
+ZTEST_SUITE(trace, NULL, NULL, before, NULL, NULL);
@@ -0,0 +1,132 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio_lte_txn.h>
+
+#include <errno.h>
+#include <stdint.h>
+
+static void before(void *fixture)
+{
+	hio_lte_txn_clear();
+}
+
+static void record(int32_t result, uint32_t on_air_ms)
+{
+	struct hio_lte_metrics_txn txn = {
+		.timestamp = k_uptime_get_32(),
+		.result = result,
+		.on_air_ms = on_air_ms,
+		.eci = 0x009DE067,
+		.datagrams = 1,
+		.attempts = 1,
+	};
+
+	hio_lte_txn_record(hio_lte_txn_begin(), &txn);
+}
+
+ZTEST(txn, test_record)
+{
+	struct hio_lte_metrics_txn txn;
+
+	zassert_equal(hio_lte_txn_get(0, &txn), -ENOENT);
+
+	record(0, 1200);
+
+	zassert_ok(hio_lte_txn_get(0, &txn));
+	zassert_equal(txn.on_air_ms, 1200);
+	zassert_equal(txn.eci, 0x009DE067);
+	zassert_equal(txn.connected_ms, 0);
+	zassert_equal(txn.rsrp, INT16_MIN);
+	zassert_equal(hio_lte_txn_get(1, &txn), -ENOENT);
+	zassert_equal(hio_lte_txn_get(-1, &txn), -EINVAL);
+	zassert_equal(hio_lte_txn_get_total(), 1);
+}
+
+ZTEST(txn, test_wrap_oldest_first)
+{
+	struct hio_lte_metrics_txn txn;
+	int n = CONFIG_HIO_LTE_METRICS_TXN_SIZE + 2;
+
+	for (int i = 0; i < n; i++) {
+		record(i, 0);
+	}
+
+	zassert_equal(hio_lte_txn_get_total(), n);
+
+	for (int i = 0; i < CONFIG_HIO_LTE_METRICS_TXN_SIZE; i++) {
+		zassert_ok(hio_lte_txn_get(i, &txn));
+		zassert_equal(txn.result, n - CONFIG_HIO_LTE_METRICS_TXN_SIZE + i);
+	}
+
+	zassert_equal(hio_lte_txn_get(CONFIG_HIO_LTE_METRICS_TXN_SIZE, &txn), -ENOENT);
+}
+
+ZTEST(txn, test_connected)
+{
+	struct hio_lte_metrics_txn txn;
+
+	/* Ended before the connection: stays open */
+	record(-ENOTCONN, 0);
+	k_sleep(K_MSEC(10));
+
+	uint32_t start = k_uptime_get_32();
+
+	/* Two transactions in one RRC connection */
+	record(0, 100);
+	record(0, 100);
+
+	hio_lte_txn_set_connected(start, 5000);
+
+	zassert_ok(hio_lte_txn_get(0, &txn));
+	zassert_equal(txn.connected_ms, 0);
+	zassert_ok(hio_lte_txn_get(1, &txn));
+	zassert_equal(txn.connected_ms, 5000);
+	zassert_ok(hio_lte_txn_get(2, &txn));
+	zassert_equal(txn.connected_ms, 5000);
+
+	/* A later connection does not overwrite them */
+	k_sleep(K_MSEC(10));
+	hio_lte_txn_set_connected(k_uptime_get_32(), 7000);
+
+	zassert_ok(hio_lte_txn_get(2, &txn));
+	zassert_equal(txn.connected_ms, 5000);
+}
+
+ZTEST(txn, test_rsrp_once)
+{
+	struct hio_lte_metrics_txn txn = {0};
+
+	/* Evaluation outside of a transaction */
+	hio_lte_txn_set_rsrp(HIO_LTE_TXN_ID_NONE, -90);
+
+	uint32_t id = hio_lte_txn_begin();
+	hio_lte_txn_record(id, &txn);
+	hio_lte_txn_set_rsrp(id, -101);
+	/* Only the first evaluation after the transaction counts */
+	hio_lte_txn_set_rsrp(id, -70);
+
+	zassert_ok(hio_lte_txn_get(0, &txn));
+	zassert_equal(txn.rsrp, -101);
+}
+
+ZTEST(txn, test_rsrp_before_record)
+{
+	struct hio_lte_metrics_txn txn = {0};
+
+	uint32_t first = hio_lte_txn_begin();
+
+	/* Evaluated before the caller recorded the transaction */
+	hio_lte_txn_set_rsrp(first, -95);
+	hio_lte_txn_record(first, &txn);
+
+	/* The next transaction does not take it */
+	hio_lte_txn_record(hio_lte_txn_begin(), &txn);
+
+	zassert_ok(hio_lte_txn_get(0, &txn));
+	zassert_equal(txn.rsrp, -95);
+	zassert_ok(hio_lte_txn_get(1, &txn));
+	zassert_equal(txn.rsrp, INT16_MIN);
+}
+
+ZTEST_SUITE(txn, NULL, NULL, before, NULL, NULL);
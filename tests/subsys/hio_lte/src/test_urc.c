@@ -0,0 +1,89 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio/hio_lte.h>
+#include <hio_lte_urc.h>
+
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+static char m_params[64];
+static int m_cereg_calls;
+static int m_ready_calls;
+static int m_xsim_calls;
+
+static void on_cereg(const char *params, void *user_data)
+{
+	strncpy(m_params, params, sizeof(m_params) - 1);
+	m_cereg_calls++;
+}
+
+static void on_ready(const char *params, void *user_data)
+{
+	strncpy(m_params, params, sizeof(m_params) - 1);
+	m_ready_calls++;
+}
+
+static void on_xsim(const char *params, void *user_data)
+{
+	m_xsim_calls += (int)(intptr_t)user_data;
+}
+
+HIO_LTE_URC_HANDLER_REGISTER(test_urc_cereg_a, "+CEREG", on_cereg, NULL);
+HIO_LTE_URC_HANDLER_REGISTER(test_urc_cereg_b, "+CEREG", on_cereg, NULL);
+HIO_LTE_URC_HANDLER_REGISTER(test_urc_ready, "Ready", on_ready, NULL);
+HIO_LTE_URC_HANDLER_REGISTER(test_urc_xsim, "%XSIM", on_xsim, (void *)2);
+
+static void *setup(void)
+{
+	zassert_ok(hio_lte_urc_init());
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	memset(m_params, 0, sizeof(m_params));
+	m_cereg_calls = 0;
+	m_ready_calls = 0;
+	m_xsim_calls = 0;
+}
+
+ZTEST(urc, test_params_after_colon)
+{
+	zassert_equal(hio_lte_urc_dispatch("+CEREG: 5,\"0B0C\",\"00123456\",7"), 2);
+	zassert_equal(m_cereg_calls, 2);
+	zassert_str_equal(m_params, "5,\"0B0C\",\"00123456\",7");
+}
+
+ZTEST(urc, test_line_without_params)
+{
+	zassert_equal(hio_lte_urc_dispatch("Ready"), 1);
+	zassert_equal(m_ready_calls, 1);
+	zassert_str_equal(m_params, "");
+}
+
+ZTEST(urc, test_user_data)
+{
+	zassert_equal(hio_lte_urc_dispatch("%XSIM: 1"), 1);
+	zassert_equal(m_xsim_calls, 2);
+}
+
+ZTEST(urc, test_exact_name_match)
+{
+	/* Neither a longer nor a shorter name may match */
+	zassert_equal(hio_lte_urc_dispatch("+CEREGX: 1"), 0);
+	zassert_equal(hio_lte_urc_dispatch("+CERE: 1"), 0);
+	zassert_equal(hio_lte_urc_dispatch("Ready2"), 0);
+	zassert_equal(hio_lte_urc_dispatch("%XSIMX: 1"), 0);
+	zassert_equal(hio_lte_urc_dispatch(""), 0);
+	zassert_equal(m_cereg_calls + m_ready_calls + m_xsim_calls, 0);
+}
+
+ZTEST(urc, test_null_line)
+{
+	zassert_equal(hio_lte_urc_dispatch(NULL), -EINVAL);
+}
+
+ZTEST_SUITE(urc, NULL, setup, before, NULL, NULL);
@@ -0,0 +1,499 @@
+#include "hio_lte_emu.h"
+
+/* NRF includes */
+#include <modem/at_monitor.h>
+#include <modem/nrf_modem_lib.h>
+#include <nrf_errno.h>
+#include <nrf_modem_at.h>
+
+/* Zephyr includes */
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_emu, CONFIG_HIO_LTE_LOG_LEVEL);
+
+#define PENDING_MAX    16
+#define RULES_MAX      32
+#define LOG_SIZE       128
+#define RRC_RELEASE_MS 50
+
+#define WORK_Q_STACK_SIZE 4096
+#define WORK_Q_PRIORITY   K_LOWEST_APPLICATION_THREAD_PRIO
+
+/* A healthy modem on a live network, used for whatever the scenario leaves out */
+static const struct hio_lte_emu_at m_modem[] = {
+	{.cmd = "AT%SHORTSWVER", .resp = "%SHORTSWVER: nrf9151_1.0.2"},
+	{.cmd = "AT%HWVERSION", .resp = "%HWVERSION: nRF9151 LACA A0A"},
+	{.cmd = "AT+CCLK?", .resp = "+CCLK: \"26/10/18,12:00:00+08\""},
+	{.cmd = "AT+CEER", .resp = "+CEER: \"No cause information available\""},
+	{.cmd = "AT+CGSN=1", .resp = "+CGSN: \"350457791234567\""},
+	{.cmd = "AT+CIMI", .resp = "901288003957734"},
+	{.cmd = "AT%XICCID", .resp = "%XICCID: 89882806660004909182"},
+	{.cmd = "AT+CRSM=176", .resp = "+CRSM: 144,0,\"FFFFFFFFFFFFFFFFFFFFFFFF\""},
+	{.cmd = "AT+COPS?", .resp = "+COPS: 0,2,\"23003\",7"},
+	{.cmd = "AT+CGATT?", .resp = "+CGATT: 1"},
+	{.cmd = "AT+CGACT?", .resp = "+CGACT: 0,1"},
+	{.cmd = "AT+CGDCONT?", .resp = "+CGDCONT: 0,\"IP\",\"iot.1nce.net\",\"10.52.2.149\",0,0"},
+	{.cmd = "AT%CONEVAL",
+	 .resp = "%CONEVAL: 0,1,7,68,29,47,\"000AE520\",\"23003\",135,6447,20,0,0,14,2,1,99"},
+	{.cmd = "AT+CFUN=1",
+	 HIO_LTE_EMU_URCS({100, "%XSIM: 1"}, {1500, "+CEREG: 2,\"AF66\",\"009DE067\",7"},
+			  {1600, "+CSCON: 1"},
+			  {3000, "+CEREG: 1,\"AF66\",\"009DE067\",7,,,\"00000000\",\"00111000\""},
+			  {4000, "+CSCON: 0"})},
+};
+
+struct pending {
+	struct k_work_delayable work;
+	bool used;
+	char line[HIO_LTE_EMU_LINE_MAX];
+};
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct k_work_q m_work_q;
+static K_THREAD_STACK_DEFINE(m_work_q_stack, WORK_Q_STACK_SIZE);
+
+static const struct hio_lte_emu_scenario *m_scenario;
+static uint16_t m_rule_used[RULES_MAX];
+
+static struct pending m_pending[PENDING_MAX];
+static struct k_work_delayable m_release_work;
+static struct k_work_delayable m_sleep_work;
+
+static bool m_initialized;
+static int m_cfun;
+static bool m_cscon;
+static char m_cereg[HIO_LTE_EMU_LINE_MAX];
+
+static struct hio_lte_emu_log_entry m_log[LOG_SIZE];
+static uint32_t m_log_total;
+
+static char m_resp[1024];
+
+void hio_lte_emu_log(char dir, const char *line)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	struct hio_lte_emu_log_entry *entry = &m_log[m_log_total % ARRAY_SIZE(m_log)];
+
+	entry->timestamp = k_uptime_get_32();
+	entry->dir = dir;
+	strncpy(entry->line, line, sizeof(entry->line) - 1);
+	entry->line[sizeof(entry->line) - 1] = '\0';
+	entry->line[strcspn(entry->line, "\r\n")] = '\0';
+
+	m_log_total++;
+
+	k_mutex_unlock(&m_lock);
+}
+
+/* Runs on the emulator work queue, like the AT monitor dispatch of the real
+ * library */
+static void dispatch(const char *line)
+{
+	char buf[HIO_LTE_EMU_LINE_MAX + 2];
+
+	if (!strncmp(line, "+CSCON: ", 8)) {
+		m_cscon = line[8] == '1';
+	} else if (!strncmp(line, "+CEREG: ", 8)) {
+		strncpy(m_cereg, line + 8, sizeof(m_cereg) - 1);
+	}
+
+	hio_lte_emu_log('<', line);
+
+	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
+		if (e->paused || (e->filter && strncmp(line, e->filter, strlen(e->filter)))) {
+			continue;
+		}
+
+		/* Handlers may modify the line */
+		snprintf(buf, sizeof(buf), "%s\r\n", line);
+		e->handler(buf);
+	}
+}
+
+static void pending_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct pending *p = CONTAINER_OF(dwork, struct pending, work);
+
+	dispatch(p->line);
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+	p->used = false;
+	k_mutex_unlock(&m_lock);
+}
+
+int hio_lte_emu_schedule(uint32_t delay_ms, const char *line)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_pending); i++) {
+		struct pending *p = &m_pending[i];
+
+		if (p->used) {
+			continue;
+		}
+
+		p->used = true;
+		strncpy(p->line, line, sizeof(p->line) - 1);
+		p->line[sizeof(p->line) - 1] = '\0';
+
+		k_work_schedule_for_queue(&m_work_q, &p->work, K_MSEC(delay_ms));
+
+		k_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	LOG_ERR("No room for URC: %s", line);
+
+	return -ENOSPC;
+}
+
+int hio_lte_emu_inject(uint32_t delay_ms, const char *line)
+{
+	return hio_lte_emu_schedule(delay_ms, line);
+}
+
+static void schedule_all(const struct hio_lte_emu_urc *urcs, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		hio_lte_emu_schedule(urcs[i].delay_ms, urcs[i].line);
+	}
+}
+
+/* Drop the notifications of the previous radio session */
+static void cancel_pending(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(m_pending); i++) {
+		k_work_cancel_delayable(&m_pending[i].work);
+
+		k_mutex_lock(&m_lock, K_FOREVER);
+		m_pending[i].used = false;
+		k_mutex_unlock(&m_lock);
+	}
+
+	k_work_cancel_delayable(&m_release_work);
+	k_work_cancel_delayable(&m_sleep_work);
+
+	m_cscon = false;
+}
+
+static void release_work_handler(struct k_work *work)
+{
+	if (!m_cscon) {
+		return;
+	}
+
+	dispatch("+CSCON: 0");
+
+	if (m_scenario && m_scenario->psm_enter_ms) {
+		k_work_schedule_for_queue(&m_work_q, &m_sleep_work,
+					  K_MSEC(m_scenario->psm_enter_ms));
+	}
+}
+
+static void sleep_work_handler(struct k_work *work)
+{
+	if (!m_cscon) {
+		dispatch("%XMODEMSLEEP: 1,86400000");
+	}
+}
+
+const struct hio_lte_emu_scenario *hio_lte_emu_get_scenario(void)
+{
+	return m_scenario;
+}
+
+bool hio_lte_emu_is_connected(void)
+{
+	return m_cscon;
+}
+
+void hio_lte_emu_activity(void)
+{
+	k_work_cancel_delayable(&m_sleep_work);
+	k_work_reschedule_for_queue(&m_work_q, &m_release_work,
+				    K_MSEC(m_scenario ? m_scenario->rrc_inactivity_ms : 0));
+}
+
+void hio_lte_emu_release(void)
+{
+	k_work_reschedule_for_queue(&m_work_q, &m_release_work, K_MSEC(RRC_RELEASE_MS));
+}
+
+static const struct hio_lte_emu_at *find_rule(const char *cmd)
+{
+	if (m_scenario) {
+		for (size_t i = 0; i < MIN(m_scenario->at_count, RULES_MAX); i++) {
+			const struct hio_lte_emu_at *rule = &m_scenario->at[i];
+
+			if (strncmp(cmd, rule->cmd, strlen(rule->cmd))) {
+				continue;
+			}
+
+			if (rule->count && m_rule_used[i] >= rule->count) {
+				continue;
+			}
+
+			m_rule_used[i]++;
+
+			return rule;
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_modem); i++) {
+		if (!strncmp(cmd, m_modem[i].cmd, strlen(m_modem[i].cmd))) {
+			return &m_modem[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Responses that follow the state of the modem */
+static bool state_resp(const char *cmd, char *resp, size_t size)
+{
+	if (!strcmp(cmd, "AT+CFUN?")) {
+		snprintf(resp, size, "+CFUN: %d", m_cfun);
+		return true;
+	}
+
+	if (!strcmp(cmd, "AT+CEREG?")) {
+		snprintf(resp, size, "+CEREG: 5,%s", m_cereg[0] ? m_cereg : "0");
+		return true;
+	}
+
+	return false;
+}
+
+static int execute(const char *cmd, char *buf, size_t len)
+{
+	char resp[HIO_LTE_EMU_LINE_MAX] = "";
+	int err = 0;
+	uint32_t delay_ms = m_scenario ? m_scenario->at_delay_ms : 0;
+
+	hio_lte_emu_log('>', cmd);
+
+	const struct hio_lte_emu_at *rule = find_rule(cmd);
+
+	if (rule) {
+		if (rule->resp) {
+			strncpy(resp, rule->resp, sizeof(resp) - 1);
+		}
+		err = rule->err;
+		delay_ms += rule->delay_ms;
+	} else {
+		state_resp(cmd, resp, sizeof(resp));
+	}
+
+	if (delay_ms) {
+		k_sleep(K_MSEC(delay_ms));
+	}
+
+	if (err < 0) {
+		return err;
+	}
+
+	int cfun = -1;
+	if (!err && sscanf(cmd, "AT+CFUN=%d", &cfun) == 1) {
+		if (cfun != 1) {
+			cancel_pending();
+			m_cereg[0] = '\0';
+		}
+		m_cfun = cfun;
+	}
+
+	if (rule) {
+		schedule_all(rule->urcs, rule->urc_count);
+	}
+
+	int ret;
+	if (err > 0) {
+		ret = snprintf(buf, len, "%s%s+CME ERROR: %d\r\n", resp, resp[0] ? "\r\n" : "",
+			       err);
+	} else {
+		ret = snprintf(buf, len, "%s%sOK\r\n", resp, resp[0] ? "\r\n" : "");
+	}
+
+	if (ret < 0 || (size_t)ret >= len) {
+		return -NRF_E2BIG;
+	}
+
+	return err > 0 ? (NRF_MODEM_AT_CME_ERROR << 16) | err : 0;
+}
+
+int nrf_modem_at_cmd(void *buf, size_t len, const char *fmt, ...)
+{
+	char cmd[HIO_LTE_EMU_LINE_MAX];
+	va_list args;
+
+	if (!m_initialized) {
+		return -EPERM;
+	}
+
+	va_start(args, fmt);
+	vsnprintf(cmd, sizeof(cmd), fmt, args);
+	va_end(args);
+
+	return execute(cmd, buf, len);
+}
+
+int nrf_modem_at_cmd_async(nrf_modem_at_resp_handler_t callback, const char *fmt, ...)
+{
+	char cmd[HIO_LTE_EMU_LINE_MAX];
+	va_list args;
+
+	if (!m_initialized) {
+		return -EPERM;
+	}
+
+	va_start(args, fmt);
+	vsnprintf(cmd, sizeof(cmd), fmt, args);
+	va_end(args);
+
+	int ret = execute(cmd, m_resp, sizeof(m_resp));
+
+	if (ret >= 0 && callback) {
+		callback(m_resp);
+	}
+
+	return ret < 0 ? ret : 0;
+}
+
+int nrf_modem_lib_init(void)
+{
+	m_initialized = true;
+	m_cfun = 0;
+
+	return 0;
+}
+
+int nrf_modem_lib_shutdown(void)
+{
+	cancel_pending();
+
+	m_initialized = false;
+	m_cfun = 0;
+	m_cereg[0] = '\0';
+
+	return 0;
+}
+
+bool nrf_modem_is_initialized(void)
+{
+	return m_initialized;
+}
+
+void hio_lte_emu_load(const struct hio_lte_emu_scenario *scenario)
+{
+	cancel_pending();
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	m_scenario = scenario;
+	memset(m_rule_used, 0, sizeof(m_rule_used));
+	m_cereg[0] = '\0';
+	m_log_total = 0;
+
+	k_mutex_unlock(&m_lock);
+
+	hio_lte_emu_socket_reset();
+	hio_lte_emu_gnss_reset();
+
+	if (scenario && scenario->at_count > RULES_MAX) {
+		LOG_WRN("Scenario `%s`: only %d rules used", scenario->name, RULES_MAX);
+	}
+
+	LOG_INF("Scenario: %s", scenario && scenario->name ? scenario->name : "default");
+}
+
+int hio_lte_emu_count(const char *prefix)
+{
+	int count = 0;
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	uint32_t n = MIN(m_log_total, ARRAY_SIZE(m_log));
+
+	for (uint32_t i = m_log_total - n; i < m_log_total; i++) {
+		const struct hio_lte_emu_log_entry *entry = &m_log[i % ARRAY_SIZE(m_log)];
+
+		if (entry->dir == '>' && !strncmp(entry->line, prefix, strlen(prefix))) {
+			count++;
+		}
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return count;
+}
+
+int hio_lte_emu_get_log(int index, struct hio_lte_emu_log_entry *entry)
+{
+	if (!entry || index < 0) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	uint32_t n = MIN(m_log_total, ARRAY_SIZE(m_log));
+
+	if ((uint32_t)index >= n) {
+		k_mutex_unlock(&m_lock);
+		return -ENOENT;
+	}
+
+	*entry = m_log[(m_log_total - n + index) % ARRAY_SIZE(m_log)];
+
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+void hio_lte_emu_dump(void)
+{
+	struct hio_lte_emu_log_entry entry;
+
+	for (int i = 0; !hio_lte_emu_get_log(i, &entry); i++) {
+		printk("%8u %c %s\n", entry.timestamp, entry.dir, entry.line);
+	}
+}
+
+/* Ahead of hio_lte, which talks to the modem from its own SYS_INIT */
+static int init(void)
+{
+	k_work_queue_init(&m_work_q);
+	k_work_queue_start(&m_work_q, m_work_q_stack, K_THREAD_STACK_SIZEOF(m_work_q_stack),
+			   WORK_Q_PRIORITY, NULL);
+	k_thread_name_set(&m_work_q.thread, "hio_lte_emu");
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_pending); i++) {
+		k_work_init_delayable(&m_pending[i].work, pending_work_handler);
+	}
+
+	k_work_init_delayable(&m_release_work, release_work_handler);
+	k_work_init_delayable(&m_sleep_work, sleep_work_handler);
+
+	hio_lte_emu_socket_reset();
+
+	return 0;
+}
+
+SYS_INIT(init, APPLICATION, 0);
@@ -0,0 +1,131 @@
+#ifndef HIO_LTE_EMU_H_
+#define HIO_LTE_EMU_H_
+
+/* Standard includes */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Scripted stand-in for the nRF91 modem on native_sim. It serves
+ * nrf_modem_at_cmd, the AT monitor and the nrf_socket calls of hio_lte, so the
+ * whole FSM runs on the host. Without CONFIG_NATIVE_SIM_SLOWDOWN_TO_REAL_TIME
+ * the simulated delays cost no wall time and the measured latencies are
+ * deterministic.
+ *
+ * A scenario overrides a healthy modem: it answers every command with OK,
+ * reports the SIM and registers ~3 s after AT+CFUN=1. The radio follows the
+ * traffic: an uplink while idle sets up RRC (+CSCON: 1), RAI or inactivity
+ * releases it (+CSCON: 0) and the modem reports sleep (%XMODEMSLEEP) after
+ * psm_enter_ms.
+ */
+
+/* Longest URC or AT command the emulator keeps */
+#define HIO_LTE_EMU_LINE_MAX 256
+
+struct hio_lte_emu_urc {
+	/* Delay after the trigger (command, uplink or injection) */
+	uint32_t delay_ms;
+	/* Notification without the line ending, e.g. "+CSCON: 1" */
+	const char *line;
+};
+
+/* Fills the urcs/urc_count pair of a rule or an uplink */
+#define HIO_LTE_EMU_URCS(...)                                                                      \
+	.urcs = (const struct hio_lte_emu_urc[]){__VA_ARGS__},                                     \
+	.urc_count = sizeof((const struct hio_lte_emu_urc[]){__VA_ARGS__}) /                        \
+		     sizeof(struct hio_lte_emu_urc)
+
+struct hio_lte_emu_at {
+	/* Prefix of the commands the rule answers */
+	const char *cmd;
+	/* Information response ("\r\n" between lines) before the result code */
+	const char *resp;
+	/* 0 for OK, > 0 for +CME ERROR with this code, < 0 returned as is */
+	int err;
+	/* Added to the scenario command latency */
+	uint32_t delay_ms;
+	/* Matches before the rule retires, 0 for no limit */
+	uint16_t count;
+	/* Notifications the command triggers */
+	const struct hio_lte_emu_urc *urcs;
+	size_t urc_count;
+};
+
+struct hio_lte_emu_uplink {
+	/* RRC is never granted; the send blocks until SNDTIMEO */
+	bool no_rrc;
+	/* The datagram is lost; no reply comes back */
+	bool lost;
+	/* Downlink sent back, NULL to echo the datagram */
+	const void *reply;
+	size_t reply_len;
+	/* Round trip from the end of the send */
+	uint32_t reply_delay_ms;
+	/* Notifications the uplink triggers, e.g. %RAI or a deregistration */
+	const struct hio_lte_emu_urc *urcs;
+	size_t urc_count;
+};
+
+struct hio_lte_emu_scenario {
+	const char *name;
+	/* Checked in order before the built-in modem */
+	const struct hio_lte_emu_at *at;
+	size_t at_count;
+	/* One per nrf_send of any socket in order, the last one repeats; none echoes */
+	const struct hio_lte_emu_uplink *uplinks;
+	size_t uplink_count;
+	/* Latency of every AT command */
+	uint32_t at_delay_ms;
+	/* Idle to +CSCON: 1 when an uplink is sent */
+	uint32_t rrc_setup_ms;
+	/* Last traffic to +CSCON: 0 when RAI does not release earlier */
+	uint32_t rrc_inactivity_ms;
+	/* +CSCON: 0 to %XMODEMSLEEP, 0 if the modem never reports sleep */
+	uint32_t psm_enter_ms;
+	/* Start of a GNSS search to its fix, 0 if the sky is never seen */
+	uint32_t gnss_fix_ms;
+};
+
+struct hio_lte_emu_log_entry {
+	/* Uptime in milliseconds */
+	uint32_t timestamp;
+	/* '>' command, '<' URC, 'u' uplink, 'd' downlink, 'g' GNSS, 's' socket */
+	char dir;
+	char line[64];
+};
+
+/* Reset the modem and the network to @p scenario; call with hio_lte disabled */
+void hio_lte_emu_load(const struct hio_lte_emu_scenario *scenario);
+
+/* Deliver @p line @p delay_ms from now, e.g. a sequence replayed from a field log */
+int hio_lte_emu_inject(uint32_t delay_ms, const char *line);
+
+/* Commands issued since the last load that start with @p prefix */
+int hio_lte_emu_count(const char *prefix);
+
+/* Records oldest first; -ENOENT past the last one */
+int hio_lte_emu_get_log(int index, struct hio_lte_emu_log_entry *entry);
+
+/* Print the log, for a failing scenario */
+void hio_lte_emu_dump(void);
+
+/* Internal: shared between the AT and the socket side of the emulator */
+void hio_lte_emu_log(char dir, const char *line);
+int hio_lte_emu_schedule(uint32_t delay_ms, const char *line);
+const struct hio_lte_emu_scenario *hio_lte_emu_get_scenario(void);
+bool hio_lte_emu_is_connected(void);
+void hio_lte_emu_activity(void);
+void hio_lte_emu_release(void);
+void hio_lte_emu_socket_reset(void);
+void hio_lte_emu_gnss_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HIO_LTE_EMU_H_ */
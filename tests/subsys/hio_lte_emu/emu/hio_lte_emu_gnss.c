@@ -0,0 +1,202 @@
+#include "hio_lte_emu.h"
+
+/* NRF includes */
+#include <nrf_modem_gnss.h>
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_emu_gnss, CONFIG_HIO_LTE_LOG_LEVEL);
+
+static K_MUTEX_DEFINE(m_lock);
+
+static nrf_modem_gnss_event_handler_type_t m_handler;
+static struct k_work_delayable m_work;
+static bool m_work_initialized;
+static bool m_running;
+/* Ephemerides of an earlier fix */
+static bool m_fix;
+/* The search in progress ends with a fix */
+static bool m_pending_fix;
+static uint16_t m_fix_retry;
+
+static void work_handler(struct k_work *work)
+{
+	nrf_modem_gnss_event_handler_type_t handler;
+	bool fix;
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (!m_running) {
+		k_mutex_unlock(&m_lock);
+		return;
+	}
+
+	/* Single fix: the receiver sleeps after the fix or the timeout */
+	m_running = false;
+	fix = m_pending_fix;
+	m_fix = m_fix || fix;
+	handler = m_handler;
+
+	k_mutex_unlock(&m_lock);
+
+	hio_lte_emu_log('g', fix ? "fix" : "timeout");
+
+	if (handler) {
+		handler(fix ? NRF_MODEM_GNSS_EVT_FIX : NRF_MODEM_GNSS_EVT_SLEEP_AFTER_TIMEOUT);
+	}
+}
+
+void hio_lte_emu_gnss_reset(void)
+{
+	if (!m_work_initialized) {
+		k_work_init_delayable(&m_work, work_handler);
+		m_work_initialized = true;
+	}
+
+	k_work_cancel_delayable(&m_work);
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+	m_running = false;
+	m_fix = false;
+	m_pending_fix = false;
+	m_fix_retry = 0;
+	k_mutex_unlock(&m_lock);
+}
+
+int nrf_modem_gnss_event_handler_set(nrf_modem_gnss_event_handler_type_t handler)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	m_handler = handler;
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+int nrf_modem_gnss_use_case_set(uint8_t use_case)
+{
+	return 0;
+}
+
+int nrf_modem_gnss_fix_interval_set(uint16_t fix_interval)
+{
+	/* Only single fixes are emulated */
+	return fix_interval ? -EINVAL : 0;
+}
+
+int nrf_modem_gnss_fix_retry_set(uint16_t fix_retry)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+	m_fix_retry = fix_retry;
+	k_mutex_unlock(&m_lock);
+
+	return 0;
+}
+
+int nrf_modem_gnss_start(void)
+{
+	const struct hio_lte_emu_scenario *scenario = hio_lte_emu_get_scenario();
+	uint32_t fix_ms = scenario ? scenario->gnss_fix_ms : 0;
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (m_running) {
+		k_mutex_unlock(&m_lock);
+		return -EINVAL;
+	}
+
+	/* The receiver shares the radio with LTE */
+	if (hio_lte_emu_is_connected()) {
+		nrf_modem_gnss_event_handler_type_t handler = m_handler;
+
+		k_mutex_unlock(&m_lock);
+
+		hio_lte_emu_log('g', "blocked");
+
+		if (handler) {
+			handler(NRF_MODEM_GNSS_EVT_BLOCKED);
+		}
+
+		return -EINVAL;
+	}
+
+	/* A search the last fix keeps hot takes a tenth of the cold start */
+	uint32_t timeout_ms = (m_fix_retry ? m_fix_retry : 60) * 1000;
+	uint32_t delay_ms = fix_ms ? (m_fix ? fix_ms / 10 : fix_ms) : timeout_ms;
+
+	if (fix_ms && delay_ms > timeout_ms) {
+		/* Gives up before the fix */
+		delay_ms = timeout_ms;
+		fix_ms = 0;
+	}
+
+	m_running = true;
+	m_pending_fix = fix_ms != 0;
+
+	k_mutex_unlock(&m_lock);
+
+	char line[32];
+	snprintf(line, sizeof(line), "start %u s", m_fix_retry);
+	hio_lte_emu_log('g', line);
+
+	k_work_schedule(&m_work, K_MSEC(delay_ms));
+
+	return 0;
+}
+
+int nrf_modem_gnss_stop(void)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	if (!m_running) {
+		k_mutex_unlock(&m_lock);
+		return -EPERM;
+	}
+
+	m_running = false;
+
+	k_mutex_unlock(&m_lock);
+
+	k_work_cancel_delayable(&m_work);
+
+	hio_lte_emu_log('g', "stop");
+
+	return 0;
+}
+
+int nrf_modem_gnss_read(void *buf, int32_t buf_len, int type)
+{
+	struct nrf_modem_gnss_pvt_data_frame pvt = {
+		.latitude = 49.2275,
+		.longitude = 16.5961,
+		.altitude = 240.0f,
+		.accuracy = 8.5f,
+		.datetime = {.year = 2026, .month = 1, .day = 1, .hour = 12},
+		.flags = NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID,
+		.sv = {
+			{.sv = 3, .flags = NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX},
+			{.sv = 7, .flags = NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX},
+			{.sv = 12, .flags = NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX},
+			{.sv = 21, .flags = NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX},
+			{.sv = 30},
+		},
+	};
+
+	if (type != NRF_MODEM_GNSS_DATA_PVT || buf_len < (int32_t)sizeof(pvt)) {
+		return -EINVAL;
+	}
+
+	memcpy(buf, &pvt, sizeof(pvt));
+
+	return 0;
+}
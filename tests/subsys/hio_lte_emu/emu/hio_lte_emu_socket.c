@@ -0,0 +1,417 @@
+#include "hio_lte_emu.h"
+
+/* NRF includes */
+#include <nrf_errno.h>
+#include <nrf_socket.h>
+
+/* Zephyr includes */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+/* Standard includes */
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(hio_lte_emu_socket, CONFIG_HIO_LTE_LOG_LEVEL);
+
+/* Descriptors are 1..SOCKETS_MAX */
+#define SOCKETS_MAX  4
+#define DATAGRAM_MAX 1024
+#define REPLIES_MAX  4
+
+struct datagram {
+	size_t len;
+	uint8_t data[DATAGRAM_MAX];
+};
+
+struct reply {
+	struct k_work_delayable work;
+	bool used;
+	bool release;
+	struct sock *sock;
+	struct datagram datagram;
+};
+
+struct sock {
+	bool open;
+	int32_t sndtimeo_ms;
+	int32_t rcvtimeo_ms;
+	int rai;
+	/* DTLS connection saved and not loaded back */
+	bool suspended;
+	struct k_msgq *rx_msgq;
+};
+
+K_MSGQ_DEFINE(m_rx_msgq_1, sizeof(struct datagram), REPLIES_MAX, 4);
+K_MSGQ_DEFINE(m_rx_msgq_2, sizeof(struct datagram), REPLIES_MAX, 4);
+K_MSGQ_DEFINE(m_rx_msgq_3, sizeof(struct datagram), REPLIES_MAX, 4);
+K_MSGQ_DEFINE(m_rx_msgq_4, sizeof(struct datagram), REPLIES_MAX, 4);
+
+static K_MUTEX_DEFINE(m_lock);
+
+static struct reply m_replies[REPLIES_MAX];
+static bool m_replies_initialized;
+
+static struct sock m_socks[SOCKETS_MAX] = {
+	{.rx_msgq = &m_rx_msgq_1},
+	{.rx_msgq = &m_rx_msgq_2},
+	{.rx_msgq = &m_rx_msgq_3},
+	{.rx_msgq = &m_rx_msgq_4},
+};
+
+/* Uplinks of all the sockets, in the order of the scenario */
+static size_t m_uplink_index;
+
+/* The modem keeps one saved DTLS connection, over a reattach too */
+static bool m_dtls_saved;
+
+static struct sock *get_sock(int fd)
+{
+	if (fd < 1 || fd > SOCKETS_MAX || !m_socks[fd - 1].open) {
+		return NULL;
+	}
+
+	return &m_socks[fd - 1];
+}
+
+static void sock_reset(struct sock *sock)
+{
+	sock->sndtimeo_ms = -1;
+	sock->rcvtimeo_ms = -1;
+	sock->rai = 0;
+	sock->suspended = false;
+}
+
+static int32_t timeval_to_ms(const void *value, nrf_socklen_t len)
+{
+	const struct nrf_timeval *tv = value;
+
+	if (len < sizeof(*tv)) {
+		return -1;
+	}
+
+	/* The modem treats a zero timeout as blocking */
+	if (!tv->tv_sec && !tv->tv_usec) {
+		return -1;
+	}
+
+	return tv->tv_sec * 1000 + tv->tv_usec / 1000;
+}
+
+static void log_datagram(char dir, const void *data, size_t len)
+{
+	char line[32];
+
+	snprintf(line, sizeof(line), "%zu bytes", len);
+	hio_lte_emu_log(dir, line);
+
+	LOG_HEXDUMP_DBG(data, len, dir == 'u' ? "Uplink" : "Downlink");
+}
+
+static void reply_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct reply *r = CONTAINER_OF(dwork, struct reply, work);
+
+	log_datagram('d', r->datagram.data, r->datagram.len);
+
+	if (k_msgq_put(r->sock->rx_msgq, &r->datagram, K_NO_WAIT)) {
+		LOG_WRN("Downlink dropped, receive queue full");
+	}
+
+	if (r->release) {
+		hio_lte_emu_release();
+	} else {
+		hio_lte_emu_activity();
+	}
+
+	k_mutex_lock(&m_lock, K_FOREVER);
+	r->used = false;
+	k_mutex_unlock(&m_lock);
+}
+
+static int schedule_reply(struct sock *sock, const void *data, size_t len, uint32_t delay_ms,
+			  bool release)
+{
+	k_mutex_lock(&m_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_replies); i++) {
+		struct reply *r = &m_replies[i];
+
+		if (r->used) {
+			continue;
+		}
+
+		r->used = true;
+		r->release = release;
+		r->sock = sock;
+		r->datagram.len = MIN(len, sizeof(r->datagram.data));
+		memcpy(r->datagram.data, data, r->datagram.len);
+
+		k_work_schedule(&r->work, K_MSEC(delay_ms));
+
+		k_mutex_unlock(&m_lock);
+		return 0;
+	}
+
+	k_mutex_unlock(&m_lock);
+
+	return -ENOSPC;
+}
+
+static const struct hio_lte_emu_uplink *next_uplink(void)
+{
+	const struct hio_lte_emu_scenario *scenario = hio_lte_emu_get_scenario();
+
+	if (!scenario || !scenario->uplink_count) {
+		return NULL;
+	}
+
+	size_t index = MIN(m_uplink_index, scenario->uplink_count - 1);
+	m_uplink_index++;
+
+	return &scenario->uplinks[index];
+}
+
+void hio_lte_emu_socket_reset(void)
+{
+	if (!m_replies_initialized) {
+		for (size_t i = 0; i < ARRAY_SIZE(m_replies); i++) {
+			k_work_init_delayable(&m_replies[i].work, reply_work_handler);
+		}
+
+		m_replies_initialized = true;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_replies); i++) {
+		k_work_cancel_delayable(&m_replies[i].work);
+		m_replies[i].used = false;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(m_socks); i++) {
+		k_msgq_purge(m_socks[i].rx_msgq);
+		m_socks[i].open = false;
+		sock_reset(&m_socks[i]);
+	}
+
+	m_uplink_index = 0;
+	m_dtls_saved = false;
+}
+
+int nrf_socket(int family, int type, int protocol)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(m_socks); i++) {
+		if (!m_socks[i].open) {
+			m_socks[i].open = true;
+			sock_reset(&m_socks[i]);
+
+			return i + 1;
+		}
+	}
+
+	errno = NRF_EAGAIN;
+	return -1;
+}
+
+int nrf_close(int fd)
+{
+	struct sock *sock = get_sock(fd);
+
+	if (!sock) {
+		return -1;
+	}
+
+	sock->open = false;
+	k_msgq_purge(sock->rx_msgq);
+
+	return 0;
+}
+
+int nrf_connect(int fd, const struct nrf_sockaddr *address, nrf_socklen_t address_len)
+{
+	return get_sock(fd) ? 0 : -1;
+}
+
+int nrf_setsockopt(int fd, int level, int option_name, const void *option_value,
+		   nrf_socklen_t option_len)
+{
+	struct sock *sock = get_sock(fd);
+
+	if (!sock) {
+		return -1;
+	}
+
+	if (level == NRF_SOL_SECURE) {
+		switch (option_name) {
+		case NRF_SO_SEC_DTLS_CONN_SAVE:
+			hio_lte_emu_log('s', "dtls save");
+			sock->suspended = true;
+			m_dtls_saved = true;
+			break;
+		case NRF_SO_SEC_DTLS_CONN_LOAD:
+			if (!m_dtls_saved) {
+				errno = NRF_EINVAL;
+				return -1;
+			}
+			hio_lte_emu_log('s', "dtls load");
+			sock->suspended = false;
+			m_dtls_saved = false;
+			break;
+		default:
+			break;
+		}
+
+		return 0;
+	}
+
+	if (level != NRF_SOL_SOCKET) {
+		return 0;
+	}
+
+	switch (option_name) {
+	case NRF_SO_SNDTIMEO:
+		sock->sndtimeo_ms = timeval_to_ms(option_value, option_len);
+		break;
+	case NRF_SO_RCVTIMEO:
+		sock->rcvtimeo_ms = timeval_to_ms(option_value, option_len);
+		break;
+	case NRF_SO_RAI:
+		sock->rai = *(const int *)option_value;
+		if (sock->rai == NRF_RAI_NO_DATA) {
+			hio_lte_emu_release();
+		}
+		break;
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+int nrf_getsockopt(int fd, int level, int option_name, void *option_value,
+		   nrf_socklen_t *option_len)
+{
+	if (!get_sock(fd) || !option_value || !option_len) {
+		return -1;
+	}
+
+	int value = 0;
+
+	if (level == NRF_SOL_SECURE && option_name == NRF_SO_SEC_CIPHERSUITE_USED) {
+		/* TLS_PSK_WITH_AES_128_CCM_8 */
+		value = 0xC0A8;
+	}
+
+	memcpy(option_value, &value, MIN(*option_len, sizeof(value)));
+
+	return 0;
+}
+
+ssize_t nrf_send(int fd, const void *buffer, size_t length, int flags)
+{
+	struct sock *sock = get_sock(fd);
+
+	if (!sock) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (sock->suspended) {
+		errno = NRF_ENOTCONN;
+		return -1;
+	}
+
+	const struct hio_lte_emu_scenario *scenario = hio_lte_emu_get_scenario();
+	const struct hio_lte_emu_uplink *uplink = next_uplink();
+
+	if (uplink && uplink->no_rrc) {
+		hio_lte_emu_log('u', "no RRC");
+		k_sleep(sock->sndtimeo_ms < 0 ? K_FOREVER : K_MSEC(sock->sndtimeo_ms));
+		errno = NRF_EAGAIN;
+		return -1;
+	}
+
+	/* The datagram waits for the connection; NRF_MSG_WAITACK blocks until on-air */
+	if (!hio_lte_emu_is_connected()) {
+		uint32_t setup_ms = scenario ? scenario->rrc_setup_ms : 0;
+
+		hio_lte_emu_schedule(setup_ms, "+CSCON: 1");
+		k_sleep(K_MSEC(setup_ms + 1));
+	}
+
+	log_datagram('u', buffer, length);
+
+	if (uplink) {
+		for (size_t i = 0; i < uplink->urc_count; i++) {
+			hio_lte_emu_schedule(uplink->urcs[i].delay_ms, uplink->urcs[i].line);
+		}
+	}
+
+	bool lost = uplink && uplink->lost;
+
+	if (!lost) {
+		const void *data = uplink && uplink->reply ? uplink->reply : buffer;
+		size_t len = uplink && uplink->reply ? uplink->reply_len : length;
+		uint32_t delay_ms = uplink ? uplink->reply_delay_ms : 0;
+
+		if (schedule_reply(sock, data, len, delay_ms, sock->rai == NRF_RAI_ONE_RESP)) {
+			LOG_WRN("Downlink dropped, no room to schedule");
+		}
+	}
+
+	if (sock->rai == NRF_RAI_LAST || (sock->rai == NRF_RAI_ONE_RESP && lost)) {
+		hio_lte_emu_release();
+	} else if (sock->rai != NRF_RAI_ONE_RESP) {
+		hio_lte_emu_activity();
+	}
+
+	return length;
+}
+
+ssize_t nrf_recv(int fd, void *buffer, size_t length, int flags)
+{
+	static struct datagram datagram;
+
+	struct sock *sock = get_sock(fd);
+
+	if (!sock) {
+		errno = EBADF;
+		return -1;
+	}
+
+	k_timeout_t timeout = sock->rcvtimeo_ms < 0 ? K_FOREVER : K_MSEC(sock->rcvtimeo_ms);
+
+	if (k_msgq_get(sock->rx_msgq, &datagram, timeout)) {
+		errno = NRF_EAGAIN;
+		return -1;
+	}
+
+	/* Datagram semantics: the rest of a longer datagram is discarded */
+	size_t len = MIN(length, datagram.len);
+	memcpy(buffer, datagram.data, len);
+
+	return len;
+}
+
+int nrf_inet_pton(int af, const char *src, void *dst)
+{
+	unsigned int a, b, c, d;
+
+	if (af != NRF_AF_INET || sscanf(src, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 ||
+	    b > 255 || c > 255 || d > 255) {
+		return 0;
+	}
+
+	uint8_t *addr = dst;
+	addr[0] = a;
+	addr[1] = b;
+	addr[2] = c;
+	addr[3] = d;
+
+	return 1;
+}
@@ -0,0 +1,40 @@
+#ifndef AT_MONITOR_H_
+#define AT_MONITOR_H_
+
+/* native_sim stand-in for the AT monitor library; the scripted modem hands
+ * every URC to the monitors registered with AT_MONITOR() */
+
+/* Zephyr includes */
+#include <zephyr/sys/iterable_sections.h>
+
+/* Standard includes */
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Monitor all notifications */
+#define ANY NULL
+
+typedef void (*at_monitor_handler_t)(const char *notif);
+
+struct at_monitor_entry {
+	/* Prefix of the notifications to receive, NULL for all */
+	const char *filter;
+	at_monitor_handler_t handler;
+	uint8_t paused;
+};
+
+#define AT_MONITOR(name, _filter, _handler, ...)                                                   \
+	static void _handler(const char *);                                                        \
+	static STRUCT_SECTION_ITERABLE(at_monitor_entry, name) = {                                 \
+		.filter = _filter,                                                                 \
+		.handler = _handler,                                                               \
+	}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AT_MONITOR_H_ */
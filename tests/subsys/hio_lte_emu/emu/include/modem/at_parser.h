@@ -0,0 +1,7 @@
+#ifndef AT_PARSER_H_
+#define AT_PARSER_H_
+
+/* native_sim stand-in; hio_lte includes the AT parser but parses responses
+ * itself (hio_lte_parse.c) */
+
+#endif /* AT_PARSER_H_ */
@@ -0,0 +1,6 @@
+#ifndef MODEM_INFO_H_
+#define MODEM_INFO_H_
+
+/* native_sim stand-in; nothing of the modem info library is used by hio_lte */
+
+#endif /* MODEM_INFO_H_ */
@@ -0,0 +1,21 @@
+#ifndef NRF_MODEM_LIB_H_
+#define NRF_MODEM_LIB_H_
+
+/* native_sim stand-in for the modem library */
+
+/* Standard includes */
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int nrf_modem_lib_init(void);
+int nrf_modem_lib_shutdown(void);
+bool nrf_modem_is_initialized(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_MODEM_LIB_H_ */
@@ -0,0 +1,13 @@
+#ifndef NRF_ERRNO_H__
+#define NRF_ERRNO_H__
+
+/* Subset of the nrf_modem errno values used by hio_lte (native_sim stand-in) */
+
+#define NRF_E2BIG        7
+#define NRF_EAGAIN       11
+#define NRF_EINVAL       22
+#define NRF_ENOTCONN     107
+#define NRF_ECONNREFUSED 111
+#define NRF_EINPROGRESS  115
+
+#endif /* NRF_ERRNO_H__ */
@@ -0,0 +1,33 @@
+#ifndef NRF_MODEM_AT_H__
+#define NRF_MODEM_AT_H__
+
+/* native_sim stand-in for the nrf_modem AT interface, served by the scripted
+ * modem of hio_lte_emu.c */
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_MODEM_AT_ERROR     1
+#define NRF_MODEM_AT_CME_ERROR 2
+#define NRF_MODEM_AT_CMS_ERROR 3
+
+#define nrf_modem_at_err_type(err) ((err) >> 16)
+#define nrf_modem_at_err(err)      ((err) & 0xFFFF)
+
+typedef void (*nrf_modem_at_resp_handler_t)(const char *resp);
+
+/* 0 on OK, a positive error type/code on ERROR, +CME ERROR or +CMS ERROR and
+ * a negative errno if the command could not be run */
+int nrf_modem_at_cmd(void *buf, size_t len, const char *fmt, ...);
+int nrf_modem_at_cmd_async(nrf_modem_at_resp_handler_t callback, const char *fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_MODEM_AT_H__ */
@@ -0,0 +1,74 @@
+#ifndef NRF_MODEM_GNSS_H__
+#define NRF_MODEM_GNSS_H__
+
+/* native_sim stand-in for the nrf_modem GNSS interface, served by
+ * hio_lte_emu_gnss.c; only the subset hio_lte uses */
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_MODEM_GNSS_MAX_SATELLITES 12
+
+#define NRF_MODEM_GNSS_EVT_PVT                 1
+#define NRF_MODEM_GNSS_EVT_FIX                 3
+#define NRF_MODEM_GNSS_EVT_BLOCKED             8
+#define NRF_MODEM_GNSS_EVT_SLEEP_AFTER_TIMEOUT 11
+
+#define NRF_MODEM_GNSS_DATA_PVT 1
+
+#define NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START 0x01
+
+#define NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID  0x01
+#define NRF_MODEM_GNSS_SV_FLAG_USED_IN_FIX 0x02
+
+struct nrf_modem_gnss_datetime {
+	uint16_t year;
+	uint8_t month;
+	uint8_t day;
+	uint8_t hour;
+	uint8_t minute;
+	uint8_t seconds;
+	uint16_t ms;
+};
+
+struct nrf_modem_gnss_sv {
+	uint16_t sv;
+	uint8_t signal;
+	uint16_t cn0;
+	int16_t elevation;
+	int16_t azimuth;
+	uint8_t flags;
+};
+
+struct nrf_modem_gnss_pvt_data_frame {
+	double latitude;
+	double longitude;
+	float altitude;
+	float accuracy;
+	float speed;
+	float heading;
+	struct nrf_modem_gnss_datetime datetime;
+	uint8_t flags;
+	struct nrf_modem_gnss_sv sv[NRF_MODEM_GNSS_MAX_SATELLITES];
+};
+
+typedef void (*nrf_modem_gnss_event_handler_type_t)(int event);
+
+int nrf_modem_gnss_event_handler_set(nrf_modem_gnss_event_handler_type_t handler);
+int nrf_modem_gnss_use_case_set(uint8_t use_case);
+int nrf_modem_gnss_fix_interval_set(uint16_t fix_interval);
+int nrf_modem_gnss_fix_retry_set(uint16_t fix_retry);
+int nrf_modem_gnss_start(void);
+int nrf_modem_gnss_stop(void);
+int nrf_modem_gnss_read(void *buf, int32_t buf_len, int type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_MODEM_GNSS_H__ */
@@ -0,0 +1,104 @@
+#ifndef NRF_SOCKET_H__
+#define NRF_SOCKET_H__
+
+/* native_sim stand-in for the nrf_modem socket API, served by the scripted
+ * network of hio_lte_emu_socket.c. Only what hio_lte uses is declared; the
+ * option values only need to be distinct. */
+
+/* Standard includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NRF_AF_INET 1
+
+#define NRF_SOCK_DGRAM 2
+
+#define NRF_IPPROTO_UDP    17
+#define NRF_SPROTO_DTLS1v2 273
+
+#define NRF_SOL_SOCKET 1
+#define NRF_SOL_SECURE 282
+
+#define NRF_SO_ERROR      4
+#define NRF_SO_RCVTIMEO   20
+#define NRF_SO_SNDTIMEO   21
+#define NRF_SO_BINDTOPDN  40
+#define NRF_SO_RAI        61
+
+#define NRF_SO_SEC_TAG_LIST             1
+#define NRF_SO_SEC_PEER_VERIFY          5
+#define NRF_SO_SEC_SESSION_CACHE        12
+#define NRF_SO_SEC_SESSION_CACHE_PURGE  13
+#define NRF_SO_SEC_DTLS_HANDSHAKE_TIMEO 14
+#define NRF_SO_SEC_CIPHERSUITE_USED     15
+#define NRF_SO_SEC_DTLS_CID             16
+#define NRF_SO_SEC_DTLS_CID_STATUS      17
+#define NRF_SO_SEC_DTLS_CONN_SAVE       18
+#define NRF_SO_SEC_DTLS_CONN_LOAD       19
+#define NRF_SO_SEC_HANDSHAKE_STATUS     21
+
+#define NRF_SO_SEC_PEER_VERIFY_REQUIRED  2
+#define NRF_SO_SEC_SESSION_CACHE_ENABLED 1
+#define NRF_SO_SEC_DTLS_CID_SUPPORTED    1
+
+#define NRF_SO_SEC_HANDSHAKE_STATUS_FULL   0
+#define NRF_SO_SEC_HANDSHAKE_STATUS_CACHED 1
+
+#define NRF_RAI_NO_DATA  1
+#define NRF_RAI_LAST     2
+#define NRF_RAI_ONE_RESP 3
+#define NRF_RAI_ONGOING  4
+
+#define NRF_MSG_WAITACK 0x200
+
+typedef uint32_t nrf_socklen_t;
+typedef uint32_t nrf_sec_tag_t;
+typedef unsigned short nrf_sa_family_t;
+typedef uint16_t nrf_in_port_t;
+
+struct nrf_timeval {
+	long tv_sec;
+	long tv_usec;
+};
+
+struct nrf_in_addr {
+	uint32_t s_addr;
+};
+
+struct nrf_sockaddr {
+	nrf_sa_family_t sa_family;
+	char sa_data[14];
+};
+
+struct nrf_sockaddr_in {
+	nrf_sa_family_t sin_family;
+	nrf_in_port_t sin_port;
+	struct nrf_in_addr sin_addr;
+};
+
+static inline uint16_t nrf_htons(uint16_t x)
+{
+	return (uint16_t)((x << 8) | (x >> 8));
+}
+
+int nrf_socket(int family, int type, int protocol);
+int nrf_close(int fd);
+int nrf_connect(int fd, const struct nrf_sockaddr *address, nrf_socklen_t address_len);
+ssize_t nrf_send(int fd, const void *buffer, size_t length, int flags);
+ssize_t nrf_recv(int fd, void *buffer, size_t length, int flags);
+int nrf_setsockopt(int fd, int level, int option_name, const void *option_value,
+		   nrf_socklen_t option_len);
+int nrf_getsockopt(int fd, int level, int option_name, void *option_value,
+		   nrf_socklen_t *option_len);
+int nrf_inet_pton(int af, const char *src, void *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NRF_SOCKET_H__ */
@@ -0,0 +1,115 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio/hio_lte.h>
+#include <hio_lte_emu.h>
+
+#include <errno.h>
+#include <string.h>
+
+/* Ceiling for enable to connected against the default modem */
+#ifndef HIO_LTE_EMU_MAX_MS_CONNECT
+#define HIO_LTE_EMU_MAX_MS_CONNECT 10000
+#endif
+
+static const struct hio_lte_socket_config m_socket_config = {
+	.port = 5002,
+	.addr = "192.0.2.1",
+};
+
+static void before(void *fixture)
+{
+	zassert_ok(hio_lte_disable());
+	zassert_ok(hio_lte_wait_for_disable(K_MINUTES(5)));
+}
+
+static void after(void *fixture)
+{
+	if (ztest_test_failed()) {
+		hio_lte_emu_dump();
+	}
+}
+
+ZTEST(emu_attach, test_connect_latency)
+{
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "connect",
+		.at_delay_ms = 5,
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	hio_lte_emu_load(&scenario);
+
+	int64_t start = k_uptime_get();
+
+	zassert_ok(hio_lte_enable(&m_socket_config));
+	zassert_ok(hio_lte_wait_for_connected(K_MINUTES(5)));
+
+	int64_t elapsed = k_uptime_get() - start;
+
+	TC_PRINT("connect: %lld ms\n", elapsed);
+	zassert_true(elapsed <= HIO_LTE_EMU_MAX_MS_CONNECT, "connect took %lld ms", elapsed);
+
+	zassert_equal(hio_lte_emu_count("AT+CFUN=1"), 1);
+
+	bool attached;
+	zassert_ok(hio_lte_is_attached(&attached));
+	zassert_true(attached);
+}
+
+ZTEST(emu_attach, test_reset_loop)
+{
+	/* The first power-up runs into the modem reset loop protection; the
+	 * FSM backs off with CFUN=4 and attaches on the next prepare */
+	static const struct hio_lte_emu_at at[] = {
+		{.cmd = "AT+CFUN=1",
+		 .count = 1,
+		 HIO_LTE_EMU_URCS({100, "%XSIM: 1"}, {500, "%MDMEV: RESET LOOP"})},
+	};
+
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "reset_loop",
+		.at = at,
+		.at_count = ARRAY_SIZE(at),
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	hio_lte_emu_load(&scenario);
+
+	zassert_ok(hio_lte_enable(&m_socket_config));
+	zassert_ok(hio_lte_wait_for_connected(K_MINUTES(40)));
+
+	zassert_equal(hio_lte_emu_count("AT+CFUN=1"), 2);
+	zassert_true(hio_lte_emu_count("AT+CFUN=4") >= 1);
+}
+
+ZTEST(emu_attach, test_attach_denied)
+{
+	/* No registration at all: the FSM gives up on the attempt and comes
+	 * back for another one, instead of waiting forever */
+	static const struct hio_lte_emu_at at[] = {
+		{.cmd = "AT+CFUN=1",
+		 .count = 1,
+		 HIO_LTE_EMU_URCS({100, "%XSIM: 1"}, {1500, "+CEREG: 2,\"AF66\",\"009DE067\",7"},
+				  {4000, "+CEREG: 3,\"AF66\",\"009DE067\",7,,,\"00000000\",\"00111000\""})},
+	};
+
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "attach_denied",
+		.at = at,
+		.at_count = ARRAY_SIZE(at),
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	hio_lte_emu_load(&scenario);
+
+	zassert_ok(hio_lte_enable(&m_socket_config));
+	zassert_ok(hio_lte_wait_for_connected(K_HOURS(3)));
+
+	zassert_true(hio_lte_emu_count("AT+CFUN=1") >= 2);
+}
+
+ZTEST_SUITE(emu_attach, NULL, NULL, before, after, NULL);
@@ -0,0 +1,500 @@
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <hio/hio_lte.h>
+#include <hio_lte_emu.h>
+
+#include <errno.h>
+#include <string.h>
+
+/* Ceiling for one exchange from an idle radio, RRC setup included */
+#ifndef HIO_LTE_EMU_MAX_MS_SEND
+#define HIO_LTE_EMU_MAX_MS_SEND 3000
+#endif
+
+static const struct hio_lte_socket_config m_socket_config = {
+	.port = 5002,
+	.addr = "192.0.2.1",
+};
+
+static void start(const struct hio_lte_emu_scenario *scenario)
+{
+	zassert_ok(hio_lte_disable());
+	zassert_ok(hio_lte_wait_for_disable(K_MINUTES(5)));
+
+	hio_lte_emu_load(scenario);
+
+	zassert_ok(hio_lte_enable(&m_socket_config));
+	zassert_ok(hio_lte_wait_for_connected(K_MINUTES(5)));
+
+	/* Let the attach RRC connection go */
+	k_sleep(K_SECONDS(30));
+}
+
+static void after(void *fixture)
+{
+	if (ztest_test_failed()) {
+		hio_lte_emu_dump();
+	}
+}
+
+ZTEST(emu_send, test_send_latency)
+{
+	static const uint8_t reply[] = {0xa0, 0x01, 0x02};
+
+	static const struct hio_lte_emu_uplink uplinks[] = {
+		{.reply = reply, .reply_len = sizeof(reply), .reply_delay_ms = 400},
+	};
+
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "send",
+		.uplinks = uplinks,
+		.uplink_count = ARRAY_SIZE(uplinks),
+		.at_delay_ms = 5,
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	start(&scenario);
+
+	static const uint8_t data[] = {0x10, 0x20, 0x30, 0x40};
+	uint8_t buf[16];
+	size_t len = 0;
+
+	struct hio_lte_send_recv_param param = {
+		.rai = true,
+		.send_buf = data,
+		.send_len = sizeof(data),
+		.recv_buf = buf,
+		.recv_size = sizeof(buf),
+		.recv_len = &len,
+		.timeout = K_SECONDS(60),
+	};
+
+	int64_t start = k_uptime_get();
+
+	zassert_ok(hio_lte_send_recv(&param));
+
+	int64_t elapsed = k_uptime_get() - start;
+
+	TC_PRINT("send: %lld ms\n", elapsed);
+	zassert_true(elapsed <= HIO_LTE_EMU_MAX_MS_SEND, "send took %lld ms", elapsed);
+
+	zassert_equal(len, sizeof(reply));
+	zassert_mem_equal(buf, reply, sizeof(reply));
+}
+
+ZTEST(emu_send, test_packet_loss)
+{
+	static const struct hio_lte_emu_uplink uplinks[] = {
+		{.lost = true},
+		{.reply_delay_ms = 400},
+	};
+
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "packet_loss",
+		.uplinks = uplinks,
+		.uplink_count = ARRAY_SIZE(uplinks),
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	start(&scenario);
+
+	static const uint8_t data[] = {0x10, 0x20, 0x30, 0x40};
+	uint8_t buf[16];
+	size_t len = 0;
+
+	struct hio_lte_send_recv_param param = {
+		.rai = true,
+		.send_buf = data,
+		.send_len = sizeof(data),
+		.recv_buf = buf,
+		.recv_size = sizeof(buf),
+		.recv_len = &len,
+		.timeout = K_SECONDS(60),
+	};
+
+	zassert_equal(hio_lte_send_recv(&param), -ETIMEDOUT);
+
+	/* The next exchange goes through; the echo comes back */
+	len = 0;
+	zassert_ok(hio_lte_send_recv(&param));
+	zassert_equal(len, sizeof(data));
+	zassert_mem_equal(buf, data, sizeof(data));
+}
+
+ZTEST(emu_send, test_learned_recv_timeout)
+{
+	/* Fill the response time table of the cell (16 replies), then lose one */
+	static const struct hio_lte_emu_uplink uplinks[] = {
+		{.reply_delay_ms = 400}, {.reply_delay_ms = 400}, {.reply_delay_ms = 400},
+		{.reply_delay_ms = 400}, {.reply_delay_ms = 400}, {.reply_delay_ms = 400},
+		{.reply_delay_ms = 400}, {.reply_delay_ms = 400}, {.reply_delay_ms = 400},
+		{.reply_delay_ms = 400}, {.reply_delay_ms = 400}, {.reply_delay_ms = 400},
+		{.reply_delay_ms = 400}, {.reply_delay_ms = 400}, {.reply_delay_ms = 400},
+		{.reply_delay_ms = 400}, {.lost = true},
+	};
+
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "learned_recv_timeout",
+		.uplinks = uplinks,
+		.uplink_count = ARRAY_SIZE(uplinks),
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	start(&scenario);
+
+	static const uint8_t data[] = {0x10, 0x20, 0x30, 0x40};
+	uint8_t buf[16];
+	size_t len;
+
+	struct hio_lte_send_recv_param param = {
+		.send_buf = data,
+		.send_len = sizeof(data),
+		.recv_buf = buf,
+		.recv_size = sizeof(buf),
+		.recv_len = &len,
+		.timeout = K_SECONDS(60),
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(uplinks) - 1; i++) {
+		len = 0;
+		zassert_ok(hio_lte_send_recv(&param));
+	}
+
+	struct hio_lte_metrics metrics;
+
+	zassert_ok(hio_lte_get_metrics(&metrics));
+	/* Twice the 400 ms replies, raised to the floor */
+	zassert_equal(metrics.recv_timeout_ltem_ms, 2000);
+
+	/* The lost reply costs the learned 2 s instead of the static 5 s */
+	int64_t start = k_uptime_get();
+
+	len = 0;
+	zassert_equal(hio_lte_send_recv(&param), -ETIMEDOUT);
+
+	int64_t elapsed = k_uptime_get() - start;
+
+	TC_PRINT("lost reply: %lld ms\n", elapsed);
+	zassert_true(elapsed < 5000, "lost reply took %lld ms", elapsed);
+}
+
+static int count_rrc_setups(uint32_t since)
+{
+	struct hio_lte_emu_log_entry entry;
+	int count = 0;
+
+	for (int i = 0; !hio_lte_emu_get_log(i, &entry); i++) {
+		if (entry.dir == '<' && (int32_t)(entry.timestamp - since) >= 0 &&
+		    !strcmp(entry.line, "+CSCON: 1")) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+ZTEST(emu_send, test_sockets_share_connection)
+{
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "sockets",
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	static const struct hio_lte_socket_config collector_config = {
+		.port = 5683,
+		.addr = "192.0.2.2",
+	};
+
+	start(&scenario);
+
+	int socket;
+
+	zassert_ok(hio_lte_add_socket(&collector_config, &socket));
+	zassert_not_equal(socket, HIO_LTE_SOCKET_DEFAULT);
+	/* CONFIG_HIO_LTE_SOCKETS_MAX=2 */
+	zassert_equal(hio_lte_add_socket(&collector_config, &socket), -ENOSPC);
+
+	static const uint8_t telemetry[] = {0x10, 0x20, 0x30, 0x40};
+	static const uint8_t query[] = {0x50, 0x60};
+	uint8_t buf[16];
+	size_t len = 0;
+
+	/* The cloud uplink and the collector query in one connection */
+	struct hio_lte_send_recv_param params[] = {
+		{
+			.send_buf = telemetry,
+			.send_len = sizeof(telemetry),
+		},
+		{
+			.rai = true,
+			.send_buf = query,
+			.send_len = sizeof(query),
+			.recv_buf = buf,
+			.recv_size = sizeof(buf),
+			.recv_len = &len,
+			.socket = socket,
+		},
+	};
+
+	uint32_t start_ms = k_uptime_get_32();
+	size_t done;
+
+	zassert_ok(hio_lte_send_recv_batch(params, ARRAY_SIZE(params), &done, K_SECONDS(60)));
+	zassert_equal(done, ARRAY_SIZE(params));
+	zassert_equal(count_rrc_setups(start_ms), 1);
+
+	/* The echo came back on the collector socket */
+	zassert_equal(len, sizeof(query));
+	zassert_mem_equal(buf, query, sizeof(query));
+
+	params[1].socket = CONFIG_HIO_LTE_SOCKETS_MAX;
+	zassert_equal(hio_lte_send_recv(&params[1]), -EINVAL);
+
+	zassert_ok(hio_lte_remove_socket(socket));
+	zassert_equal(hio_lte_remove_socket(HIO_LTE_SOCKET_DEFAULT), -EINVAL);
+
+	params[1].socket = socket;
+	zassert_equal(hio_lte_send_recv(&params[1]), -EINVAL);
+}
+
+ZTEST(emu_send, test_no_rrc)
+{
+	static const struct hio_lte_emu_uplink uplinks[] = {
+		{.no_rrc = true},
+	};
+
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "no_rrc",
+		.uplinks = uplinks,
+		.uplink_count = ARRAY_SIZE(uplinks),
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	start(&scenario);
+
+	static const uint8_t data[] = {0x10, 0x20, 0x30, 0x40};
+
+	struct hio_lte_send_recv_param param = {
+		.send_buf = data,
+		.send_len = sizeof(data),
+		.timeout = K_SECONDS(30),
+	};
+
+	zassert_equal(hio_lte_send_recv(&param), -ETIMEDOUT);
+}
+
+ZTEST(emu_send, test_gnss_fix)
+{
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "gnss_fix",
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+		.gnss_fix_ms = 30000,
+	};
+
+	start(&scenario);
+
+	struct hio_lte_metrics before;
+	zassert_ok(hio_lte_get_metrics(&before));
+
+	struct hio_lte_gnss_fix fix;
+
+	zassert_ok(hio_lte_gnss_get_fix(&fix, K_MINUTES(3)));
+	zassert_false(fix.hot);
+	zassert_equal(fix.satellites, 4);
+	zassert_true(fix.ttff_ms >= 30000, "ttff %u ms", fix.ttff_ms);
+
+	/* The ephemerides of the first fix are kept */
+	zassert_ok(hio_lte_gnss_get_fix(&fix, K_MINUTES(3)));
+	zassert_true(fix.hot);
+	zassert_true(fix.ttff_ms < 30000, "ttff %u ms", fix.ttff_ms);
+
+	struct hio_lte_metrics after;
+	zassert_ok(hio_lte_get_metrics(&after));
+	zassert_equal(after.gnss_fixes - before.gnss_fixes, 2);
+	zassert_equal(after.gnss_ttff_cold_hist.count - before.gnss_ttff_cold_hist.count, 1);
+	zassert_equal(after.gnss_ttff_hot_hist.count - before.gnss_ttff_hot_hist.count, 1);
+
+	/* Even a hot start takes longer than the deadline */
+	zassert_equal(hio_lte_gnss_get_fix(&fix, K_SECONDS(1)), -ETIMEDOUT);
+	zassert_equal(hio_lte_gnss_get_fix(NULL, K_SECONDS(1)), -EINVAL);
+}
+
+ZTEST(emu_send, test_dtls_session_saved)
+{
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "dtls_session_saved",
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+		.psm_enter_ms = 2000,
+	};
+
+	static const struct hio_lte_socket_config dtls_config = {
+		.dtls_enabled = true,
+		.port = 5684,
+		.addr = "192.0.2.1",
+	};
+
+	zassert_ok(hio_lte_disable());
+	zassert_ok(hio_lte_wait_for_disable(K_MINUTES(5)));
+
+	hio_lte_emu_load(&scenario);
+
+	struct hio_lte_metrics before;
+	zassert_ok(hio_lte_get_metrics(&before));
+
+	zassert_ok(hio_lte_enable(&dtls_config));
+	zassert_ok(hio_lte_wait_for_connected(K_MINUTES(5)));
+
+	/* RRC release and PSM entry save the session */
+	k_sleep(K_SECONDS(30));
+
+	static const uint8_t data[] = {0x10, 0x20, 0x30, 0x40};
+	uint8_t buf[16];
+	size_t len = 0;
+
+	struct hio_lte_send_recv_param param = {
+		.rai = true,
+		.send_buf = data,
+		.send_len = sizeof(data),
+		.recv_buf = buf,
+		.recv_size = sizeof(buf),
+		.recv_len = &len,
+		.timeout = K_SECONDS(30),
+	};
+
+	/* The emulated socket refuses to send until the session is loaded */
+	zassert_ok(hio_lte_send_recv(&param));
+	zassert_equal(len, sizeof(data));
+
+	/* Same server: the session moves to the new socket */
+	zassert_ok(hio_lte_update_socket_config(&dtls_config));
+	k_sleep(K_SECONDS(5));
+
+	zassert_ok(hio_lte_send_recv(&param));
+
+	struct hio_lte_metrics after;
+	zassert_ok(hio_lte_get_metrics(&after));
+	zassert_equal(after.dtls_full_handshakes - before.dtls_full_handshakes, 1);
+	zassert_true(after.dtls_restored - before.dtls_restored >= 2);
+	zassert_true(after.dtls_saves - before.dtls_saves >= 2);
+	zassert_equal(after.dtls_save_failures, before.dtls_save_failures);
+	zassert_equal(after.dtls_load_failures, before.dtls_load_failures);
+	zassert_equal(after.dtls_handshake_bytes - before.dtls_handshake_bytes,
+		      CONFIG_HIO_LTE_DTLS_FULL_HANDSHAKE_BYTES);
+}
+
+static K_THREAD_STACK_DEFINE(m_uplink_stack, 2048);
+static struct k_thread m_uplink_thread;
+static int m_uplink_result;
+
+static void uplink_thread(void *p1, void *p2, void *p3)
+{
+	static const uint8_t data[] = {0x10, 0x20, 0x30, 0x40};
+	uint8_t buf[16];
+	size_t len = 0;
+
+	struct hio_lte_send_recv_param param = {
+		.rai = true,
+		.send_buf = data,
+		.send_len = sizeof(data),
+		.recv_buf = buf,
+		.recv_size = sizeof(buf),
+		.recv_len = &len,
+		.timeout = K_SECONDS(30),
+	};
+
+	k_sleep(K_SECONDS(10));
+
+	m_uplink_result = hio_lte_send_recv(&param);
+}
+
+ZTEST(emu_send, test_gnss_preempted)
+{
+	static const struct hio_lte_emu_uplink uplinks[] = {
+		{.reply_delay_ms = 500},
+	};
+
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "gnss_preempted",
+		.uplinks = uplinks,
+		.uplink_count = ARRAY_SIZE(uplinks),
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+		.gnss_fix_ms = 30000,
+	};
+
+	start(&scenario);
+
+	struct hio_lte_metrics before;
+	zassert_ok(hio_lte_get_metrics(&before));
+
+	/* The uplink comes in the middle of the search */
+	m_uplink_result = -EINPROGRESS;
+	k_thread_create(&m_uplink_thread, m_uplink_stack, K_THREAD_STACK_SIZEOF(m_uplink_stack),
+			uplink_thread, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	uint32_t start_ms = k_uptime_get_32();
+	struct hio_lte_gnss_fix fix;
+
+	zassert_ok(hio_lte_gnss_get_fix(&fix, K_MINUTES(3)));
+	zassert_ok(k_thread_join(&m_uplink_thread, K_SECONDS(60)));
+
+	/* The uplink went first, the search resumed after its release */
+	zassert_ok(m_uplink_result);
+	zassert_true(k_uptime_get_32() - start_ms < HIO_LTE_EMU_MAX_MS_SEND + 40000 + 30000);
+
+	struct hio_lte_metrics after;
+	zassert_ok(hio_lte_get_metrics(&after));
+	zassert_equal(after.gnss_preempted - before.gnss_preempted, 1);
+	zassert_equal(after.gnss_blocked, before.gnss_blocked);
+}
+
+static int count_gnss_starts(void)
+{
+	struct hio_lte_emu_log_entry entry;
+	int count = 0;
+
+	for (int i = 0; !hio_lte_emu_get_log(i, &entry); i++) {
+		if (entry.dir == 'g' && !strncmp(entry.line, "start", 5)) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+ZTEST(emu_send, test_gnss_search_restarted)
+{
+	static const struct hio_lte_emu_scenario scenario = {
+		.name = "gnss_search_restarted",
+		.rrc_setup_ms = 300,
+		.rrc_inactivity_ms = 10000,
+	};
+
+	start(&scenario);
+
+	struct hio_lte_metrics before;
+	zassert_ok(hio_lte_get_metrics(&before));
+
+	/* The sky is never seen: the search gives up after the Kconfig limit
+	 * and starts again for the rest of the deadline */
+	struct hio_lte_gnss_fix fix;
+
+	zassert_equal(hio_lte_gnss_get_fix(&fix, K_SECONDS(CONFIG_HIO_LTE_GNSS_FIX_TIMEOUT + 30)),
+		      -ETIMEDOUT);
+	zassert_true(count_gnss_starts() >= 2, "%d starts", count_gnss_starts());
+
+	struct hio_lte_metrics after;
+	zassert_ok(hio_lte_get_metrics(&after));
+	zassert_equal(after.gnss_timeouts - before.gnss_timeouts, 1);
+	zassert_equal(after.gnss_errors, before.gnss_errors);
+}
+
+ZTEST_SUITE(emu_send, NULL, NULL, NULL, after, NULL);
@@ -0,0 +1,174 @@
+/* libFuzzer targets for the hio_lte_parse parsers of untrusted modem text.
+ *
+ * One parser per build, selected with HIO_LTE_FUZZ_TARGET (see testcase.yaml).
+ * Needs the LLVM toolchain on native_sim/native/64:
+ *
+ *   west build -b native_sim/native/64 tests/subsys/hio_lte_fuzz \
+ *       -- -DHIO_LTE_FUZZ_TARGET=ncellmeas -DZEPHYR_TOOLCHAIN_VARIANT=llvm
+ *   mkdir -p corpus && split -l 1 tests/subsys/hio_lte/corpus/urc.txt corpus/urc-
+ *   ./build/zephyr/zephyr.exe corpus
+ *
+ * An input may carry the URC prefix ("%NCELLMEAS: "), so the captured lines
+ * of the benchmark corpus seed every target; the prefix is stripped as the
+ * flow does before it calls the parser. Besides the memory errors caught by
+ * ASAN/UBSAN, each target asserts what the callers rely on: counts within
+ * the arrays, neighbor pointers inside the neighbor table and terminated
+ * strings. */
+
+#include <hio/hio_lte.h>
+#include <hio_lte_parse.h>
+
+#include <zephyr/irq.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Longer than any line the modem sends (AT monitor buffer) */
+#define INPUT_MAX 4096
+
+extern const uint8_t *posix_fuzz_buf;
+extern size_t posix_fuzz_sz;
+
+static K_SEM_DEFINE(m_fuzz_sem, 0, K_SEM_MAX_LIMIT);
+
+/* The input is copied to the end, so a read past its terminator leaves the
+ * object and trips ASAN */
+static char m_input[INPUT_MAX + 1];
+
+static bool is_terminated(const char *str, size_t size)
+{
+	return memchr(str, '\0', size) != NULL;
+}
+
+static const char *skip_prefix(const char *line, const char *prefix)
+{
+	size_t len = strlen(prefix);
+
+	return strncmp(line, prefix, len) ? line : line + len;
+}
+
+static __maybe_unused void fuzz_cereg(const char *line)
+{
+	struct hio_lte_cereg_param param;
+
+	if (hio_lte_parse_urc_cereg(skip_prefix(line, "+CEREG: "), &param)) {
+		return;
+	}
+
+	__ASSERT(param.valid, "cereg: not valid");
+	__ASSERT(is_terminated(param.tac, sizeof(param.tac)), "cereg: tac");
+}
+
+static __maybe_unused void fuzz_ncellmeas(const char *line)
+{
+	struct hio_lte_ncellmeas_param param;
+
+	int ret = hio_lte_parse_urc_ncellmeas(skip_prefix(line, "%NCELLMEAS: "), 5, &param);
+
+	/* The counts bound every later loop over the tables, even on error */
+	__ASSERT(param.num_cells <= HIO_LTE_NCELLMEAS_CELL_MAX, "ncellmeas: %u cells",
+		 param.num_cells);
+	__ASSERT(param.num_ncells <= HIO_LTE_NCELLMEAS_NCELL_MAX, "ncellmeas: %u ncells",
+		 param.num_ncells);
+
+	if (ret) {
+		return;
+	}
+
+	__ASSERT(param.valid, "ncellmeas: not valid");
+
+	size_t ncells = 0;
+
+	for (int i = 0; i < param.num_cells; i++) {
+		const struct hio_lte_ncellmeas_cell_param *cell = &param.cells[i];
+
+		if (!cell->neighbor_count) {
+			continue;
+		}
+
+		ptrdiff_t first = cell->ncells ? cell->ncells - param.ncells : -1;
+
+		__ASSERT(first >= 0 && first + cell->neighbor_count <= param.num_ncells,
+			 "ncellmeas: cell %d neighbors %td+%u of %u", i, first,
+			 cell->neighbor_count, param.num_ncells);
+
+		ncells += cell->neighbor_count;
+	}
+
+	__ASSERT(ncells == param.num_ncells, "ncellmeas: %zu of %u ncells linked", ncells,
+		 param.num_ncells);
+}
+
+static __maybe_unused void fuzz_coneval(const char *line)
+{
+	struct hio_lte_conn_param param;
+
+	hio_lte_parse_coneval(skip_prefix(line, "%CONEVAL: "), &param);
+}
+
+static __maybe_unused void fuzz_cgdcont(const char *line)
+{
+	struct cgdcont_param param;
+
+	if (hio_lte_parse_cgcont(skip_prefix(line, "+CGDCONT: "), &param)) {
+		return;
+	}
+
+	__ASSERT(is_terminated(param.pdn_type, sizeof(param.pdn_type)), "cgdcont: pdn_type");
+	__ASSERT(is_terminated(param.apn, sizeof(param.apn)), "cgdcont: apn");
+	__ASSERT(is_terminated(param.addr, sizeof(param.addr)), "cgdcont: addr");
+}
+
+static __maybe_unused void fuzz_xmodemsleep(const char *line)
+{
+	int p1, p2;
+
+	hio_lte_parse_urc_xmodemsleep(skip_prefix(line, "%XMODEMSLEEP: "), &p1, &p2);
+}
+
+static __maybe_unused void fuzz_rai(const char *line)
+{
+	struct hio_lte_rai_param param;
+
+	if (hio_lte_parse_urc_rai(skip_prefix(line, "%RAI: "), &param)) {
+		return;
+	}
+
+	__ASSERT(param.valid, "rai: not valid");
+}
+
+static void fuzz_isr(const void *arg)
+{
+	/* Run the input in a thread, as the AT monitor hands URCs to the flow */
+	k_sem_give(&m_fuzz_sem);
+}
+
+int main(void)
+{
+	IRQ_CONNECT(CONFIG_ARCH_POSIX_FUZZ_IRQ, 0, fuzz_isr, NULL, 0);
+	irq_enable(CONFIG_ARCH_POSIX_FUZZ_IRQ);
+
+	for (;;) {
+		k_sem_take(&m_fuzz_sem, K_FOREVER);
+
+		/* Lines are text: the modem never hands over an embedded NUL */
+		size_t len = MIN(posix_fuzz_sz, INPUT_MAX);
+		const uint8_t *nul = memchr(posix_fuzz_buf, '\0', len);
+
+		if (nul) {
+			len = nul - posix_fuzz_buf;
+		}
+
+		char *line = &m_input[sizeof(m_input) - len - 1];
+
+		memcpy(line, posix_fuzz_buf, len);
+		line[len] = '\0';
+
+		HIO_LTE_FUZZ_TARGET(line);
+	}
+
+	return 0;
+}